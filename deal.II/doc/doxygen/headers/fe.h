@@ -192,6 +192,10 @@
  * it accepts a vector that describes a displacement field for each position
  * of the domain. This is used in Eulerian computations without the need to
  * actually move vertices after each time step.
+ *
+ * The MappingQ1Cached class computes the same mapping as MappingQ1, but
+ * stores the geometric data of each cell so that visiting the same cells
+ * again, for example when assembling several operators, is cheaper.
  * 
  * In addition, the MappingC1 class provides for a boundary of the
  * computational domain that is not only curved, but also has a continuous
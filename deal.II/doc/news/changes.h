@@ -40,6 +40,18 @@ inconvenience this causes.
 </p>
 
 <ol>
+  <li> Changed: The gradients and second derivatives of shape functions
+  are now stored in FEValuesData as Table objects rather than as vectors
+  of vectors, i.e., the data of all shape functions at all quadrature
+  points is stored in one contiguous block of memory, like the values of
+  the shape functions already were. Consequently, the types
+  FEValuesData::GradientVector and FEValuesData::HessianVector have
+  changed. This only affects code that accesses these arrays directly,
+  such as implementations of finite element classes.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
   <li> Removed: Class PointerMatrixBase (and, consequently, the various
   classes derived from it) had comparison operators that were intended to
   work generically for any kind of derived class. However, the implementation
@@ -90,6 +102,24 @@ inconvenience this causes.
 
 
 <ol>
+  <li> New: The class DataOutBackgroundWriter takes over the patches of a
+  DataOut object without copying them and writes them to a file on a
+  separate thread while the program continues with its computations. The
+  amount of memory occupied by files waiting to be written can be bounded.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: GridOut::write_binary() and GridIn::read_binary() store and
+  re-create a complete triangulation, including its refinement hierarchy,
+  material ids, boundary indicators and vertex locations, in a native binary
+  format. Since the coarse mesh is written in the form the Triangulation
+  class uses internally, reading it back does not require the GridReordering
+  class, which makes this by far the fastest way to load large meshes.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
   <li> Changed: The functionparser library bundled with deal.II got replaced
   by the muparser library.
   <br>
@@ -148,6 +178,217 @@ inconvenience this causes.
 <h3>Specific improvements</h3>
 
 <ol>
+  <li> Improved: The internal data objects of FE_Poly, and therefore of
+  FE_Q, FE_DGQ, FE_DGP and related elements, now share their tables of
+  shape function values and gradients on the unit cell with all other
+  such objects created for the same quadrature formula. FEValues objects
+  for the same element and quadrature, for example the ones each thread
+  keeps in the scratch data of a WorkStream loop, no longer compute and
+  store these tables separately. std_cxx1x now also provides weak_ptr.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: Polynomials::Polynomial::value() can now be called with a
+  buffer provided by the caller instead of a std::vector, and with a
+  VectorizedArray argument to evaluate a polynomial at several points at
+  once. TensorProductPolynomials has a new function compute() that
+  evaluates all polynomials at a whole set of points, which FE_Poly now
+  uses to set up the shape function values and gradients for a quadrature
+  formula. FE_PolyTensor applies the inverse node matrix to all quadrature
+  points at once.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: The class FEValuesTensorProduct evaluates finite element
+  functions and integrates against shape functions and their gradients
+  with an interface similar to FEValues, but uses sum factorization with
+  the one-dimensional shape data of the matrix-free framework instead of
+  tables of all shape functions at all quadrature points. It can be used
+  for FE_Q and FE_DGQ type elements on affine cells and is considerably
+  faster than FEValues for higher polynomial degrees.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: FETools::set_matrix_cache_directory() allows to store the
+  matrices computed by FETools::compute_embedding_matrices() and
+  FETools::compute_projection_matrices() on disk and read them back the
+  next time they are needed for the same element. In addition,
+  FETools::compute_projection_matrices() now computes the matrices of the
+  different refinement cases in parallel.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: hp::FEValues, hp::FEFaceValues and hp::FESubfaceValues have a
+  function precalculate_fe_values() that creates the ::FEValues objects for
+  all elements of the collection up front and in parallel. The new function
+  DoFTools::get_active_cells_by_fe_index() groups the active cells by their
+  active_fe_index.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: The class CellDoFIndexTable stores the global indices of the
+  degrees of freedom of all active cells of a DoFHandler or hp::DoFHandler
+  contiguously, and collects or distributes the values of a whole range of
+  cells with a single call.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: FEValuesBase::get_function_values_from_local_dof_values() and
+  FEValuesBase::get_function_gradients_from_local_dof_values() evaluate a
+  finite element function from the values of its degrees of freedom on the
+  current cell, so that these only need to be collected once per cell.
+  The evaluation of vector-valued functions for primitive elements skips
+  the lookup of nonzero components and is now faster.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: The namespace LocalIntegrators::Dense provides functions that
+  compute cell matrices as products <i>G<sup>T</sup>WG</i> of dense
+  matrices of shape function values or derivatives, using BLAS
+  <tt>gemm</tt> if available. LocalIntegrators::Laplace::cell_matrix(),
+  LocalIntegrators::L2::mass_matrix() and
+  LocalIntegrators::Elasticity::cell_matrix() now use them.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: The flags DataOutBase::VtkFlags::data_tolerances and
+  DataOutBase::DataOutFilterFlags::data_tolerances allow to specify an
+  absolute error tolerance for each data set written to VTU or HDF5
+  files. The data is then rounded within this tolerance such that it
+  compresses much better.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: DataOutBase::write_deal_II_intermediate() can now write the
+  patches in binary, by setting the new flag
+  DataOutBase::Deal_II_IntermediateFlags::binary. DataOutReader::read()
+  recognizes such files automatically. The new function
+  DataOutReader::read() for a list of file names reads the intermediate
+  files written by several processes in parallel and merges them in one
+  pass.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: The class PointValueHistoryStream records the values of a
+  finite element field at a set of points in every time step. It locates
+  the points only once, works with parallel::distributed::Triangulation,
+  and streams the values in fixed-size chunks to a compact binary file
+  while the computation runs.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: The classes DataOutSlice and DataOutCoarse write reduced
+  output that is much cheaper to generate and store than that of DataOut:
+  DataOutSlice generates output on the intersection of the mesh with a
+  plane, and DataOutCoarse on a coarser level of the mesh hierarchy. The
+  new function VectorTools::point_values() evaluates a finite element
+  function at many points at once, for example along lines or at a set
+  of probes. DataOut now also works with first_cell() and next_cell()
+  functions that return cells with children, as documented.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: The class DataOutTimeSeries writes the output of time
+  dependent simulations to HDF5 files described by an XDMF file. The mesh
+  is written only in the first time step and after the triangulation has
+  changed; all other time steps only contain the data values.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: DataOutInterface::write_vtu_aggregated() writes the output of
+  all processes of a communicator into one .vtu file per node, or into a
+  given number of files, along with a .pvtu record that lists them. Every
+  process still generates and compresses its own piece, but only one
+  process per group writes to the file system.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> Improved: DataOutBase::DataOutFilter now finds duplicate vertices
+  using a hash table instead of a std::multimap, and stores the mapping of
+  points and cells to the filtered nodes in vectors instead of std::maps.
+  Filtering the output of large meshes is therefore considerably faster
+  and uses less memory.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> Improved: DataOut::build_patches() now builds each patch in place
+  rather than in a temporary object that was then copied, which avoids
+  allocating and copying the data of every patch a second time.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: DataOutBase::write_vtu() now splits data arrays into blocks
+  that are compressed independently and in parallel. The zlib compression
+  level can be selected through DataOutBase::VtkFlags::compression_level,
+  and DataOutBase::VtkFlags::write_appended_raw_data allows writing the
+  data as raw binary data in an appended section rather than base64
+  encoded inline.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: The class MappingQ1Cached is a d-linear mapping that stores the
+  quadrature points, Jacobians, JxW values and other geometric data it
+  computes on each cell for a given quadrature formula, and returns them from
+  storage whenever an FEValues object visits the same cell again. The stored
+  data is shared between all FEValues objects that use the same quadrature
+  formula and update flags, and is discarded when the triangulation changes.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: Mapping::transform_points_real_to_unit_cell() transforms many
+  points on the same cell to the reference cell at once. MappingQ1, MappingQ
+  and MappingCartesian compute the support points of the mapping and the
+  initial guess for the Newton iteration only once per cell, skip the
+  iteration altogether for parallelograms and parallelepipeds, and run the
+  Newton iterations for several points simultaneously using VectorizedArray.
+  Points for which the transformation fails are marked by an infinite first
+  coordinate rather than by an exception.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> New: The class CellLocator finds the active cell around a given point
+  like GridTools::find_active_cell_around_point(), but builds a hierarchy of
+  bounding boxes around the cells of a mesh once so that each subsequent
+  search only takes logarithmic time in the number of cells. It can also
+  locate many points at once in parallel. The index is automatically
+  discarded and re-built when the triangulation changes.
+  <br>
+  Fixed: GridTools::find_active_cell_around_point() ran into an endless loop
+  for points outside the domain of a refined mesh, rather than throwing an
+  exception.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
+  <li> Improved: GridIn::read_msh() and GridIn::read_ucd() now read the
+  file into memory and parse the vertices and cells in chunks on several
+  threads, using a number parser that does not go through the locale
+  machinery of the C++ stream library. This makes reading large meshes
+  substantially faster. GridIn::read_msh() can now also read binary files
+  in Gmsh format 2.
+  <br>
+  (agent, 2026/10/18)
+  </li>
+
   <li> Fixed: GridTools::laplace_transform had previously announced in
   the documentation that one can also set the location of interior points,
   but this was not in fact what was implemented. This has now been fixed:
@@ -0,0 +1,257 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef __deal2__data_out_background_writer_h
+#define __deal2__data_out_background_writer_h
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/std_cxx1x/shared_ptr.h>
+
+#include <list>
+#include <string>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A class that writes graphical output in the background, while the
+ * program continues with its computations. Writing output for large
+ * meshes, and in particular compressing it for formats such as VTU,
+ * can take a considerable fraction of the run time of time dependent
+ * simulations that produce output frequently. This class allows to
+ * overlap this work with the computations of the next time steps.
+ *
+ * The class is used as follows:
+ * @code
+ *   DataOutBackgroundWriter<dim> background_writer;
+ *
+ *   for (timestep=0; ...)
+ *     {
+ *       ... // solve
+ *
+ *       DataOut<dim> data_out;
+ *       data_out.attach_dof_handler (dof_handler);
+ *       data_out.add_data_vector (solution, "solution");
+ *       data_out.build_patches ();
+ *
+ *       background_writer.write (data_out,
+ *                                "solution-" + Utilities::int_to_string (timestep, 4) + ".vtu",
+ *                                DataOutBase::vtu);
+ *     }
+ *
+ *   background_writer.wait ();
+ * @endcode
+ *
+ * The write() function takes over the patches of the DataOut object as
+ * well as the names of the data sets and the output flags set in it, and
+ * queues them for output. For DataOut and the other classes derived from
+ * DataOut_DoFData, the patches are taken over without copying them; the
+ * DataOut object does not have any patches afterwards and can be
+ * destroyed or reused right away. The data is then written to the given
+ * file on a separate thread, one file after the other in the order in
+ * which write() was called.
+ *
+ * <h3>Memory consumption</h3>
+ *
+ * Since the patches of all files that are not yet completely written
+ * are kept in memory, producing output faster than it can be written
+ * would lead to unbounded memory consumption. The constructor of this
+ * class therefore takes the maximal amount of memory that the patches
+ * of queued files may occupy. If taking over the patches passed to
+ * write() would exceed this limit, write() waits until enough of the
+ * previously queued files have been written. A set of patches is always
+ * accepted if there are no other files waiting to be written, even if it
+ * is larger than the limit. In particular, the default limit of zero
+ * means that each call to write() waits until the previous file has been
+ * written, but does not wait for its own file.
+ *
+ * <h3>Errors</h3>
+ *
+ * Errors that occur while writing a file, for example because the file
+ * can not be opened, are recorded and reported by the next call to
+ * wait() by throwing an exception. The destructor of this class waits
+ * for all files to be written, but does not report errors.
+ *
+ * If deal.II is configured without multithreading, write() writes the
+ * file right away.
+ *
+ * @note Output formats whose functions need to communicate with other
+ * processors, such as DataOutInterface::write_vtu_in_parallel() and
+ * DataOutInterface::write_hdf5_parallel(), can not be written in the
+ * background since the communication would happen at unpredictable
+ * times. Only the formats supported by DataOutInterface::write() are
+ * available.
+ *
+ * @ingroup output
+ */
+template <int dim, int spacedim=dim>
+class DataOutBackgroundWriter : public Subscriptor
+{
+public:
+  /**
+   * Constructor. The argument denotes the maximal amount of memory, in
+   * bytes, that the patches of files waiting to be written may occupy;
+   * see the general documentation of this class.
+   */
+  DataOutBackgroundWriter (const std::size_t max_queued_memory = 0);
+
+  /**
+   * Destructor. Wait for all queued files to be written.
+   */
+  ~DataOutBackgroundWriter ();
+
+  /**
+   * Take over the patches of the given object, along with the names of
+   * the data sets and the flags for the output formats, and queue them
+   * for being written to the given file in the given format. If
+   * <tt>output_format</tt> is DataOutBase::default_format, the default
+   * format set in <tt>data_out</tt> is used.
+   *
+   * If the patches of <tt>data_out</tt> are handed over without copying
+   * them, which is the case for DataOut and the other classes derived
+   * from DataOut_DoFData, then <tt>data_out</tt> does not have any
+   * patches any more after this call.
+   */
+  void write (DataOutInterface<dim,spacedim> &data_out,
+              const std::string              &filename,
+              const DataOutBase::OutputFormat output_format = DataOutBase::default_format);
+
+  /**
+   * Wait until all queued files have been written. If an error occurred
+   * while writing any of them since the last call to this function,
+   * throw an exception describing it.
+   */
+  void wait ();
+
+  /**
+   * Return the number of files that have been queued but are not yet
+   * completely written.
+   */
+  unsigned int n_queued_files () const;
+
+  /**
+   * Exception
+   */
+  DeclException2 (ExcWriteFailed,
+                  std::string, std::string,
+                  << "Writing the file <" << arg1 << "> in the background "
+                  << "failed with the following error:\n" << arg2);
+
+private:
+  /**
+   * A class holding the patches, names of data sets and output flags
+   * of one file to be written, along with the name of the file.
+   */
+  class QueuedFile : public DataOutInterface<dim,spacedim>
+  {
+  public:
+    /**
+     * Constructor. Copy the output flags and the default format of the
+     * given object.
+     */
+    QueuedFile (const DataOutInterface<dim,spacedim> &data_out,
+                const std::string                    &filename,
+                const DataOutBase::OutputFormat       output_format);
+
+    /**
+     * The name of the file and the format to write.
+     */
+    const std::string               filename;
+    const DataOutBase::OutputFormat output_format;
+
+    /**
+     * The data taken over from the object passed to write().
+     */
+    std::vector<DataOutBase::Patch<dim,spacedim> > patches;
+    std::vector<std::string> dataset_names;
+    std::vector<std_cxx1x::tuple<unsigned int, unsigned int, std::string> > vector_data_ranges;
+
+    /**
+     * An estimate of the memory used by the patches, in bytes.
+     */
+    std::size_t memory;
+
+  private:
+    /**
+     * Implementation of the functions of the base class.
+     */
+    virtual
+    const std::vector<DataOutBase::Patch<dim,spacedim> > &
+    get_patches () const;
+
+    virtual
+    std::vector<std::string>
+    get_dataset_names () const;
+
+    virtual
+    std::vector<std_cxx1x::tuple<unsigned int, unsigned int, std::string> >
+    get_vector_data_ranges () const;
+  };
+
+  /**
+   * The function run on the writer thread. Write the queued files one
+   * after the other until the queue is empty.
+   */
+  void write_queued_files ();
+
+  /**
+   * The maximal amount of memory the queued patches may occupy.
+   */
+  const std::size_t max_queued_memory;
+
+  /**
+   * The files to be written. The first element is the one currently
+   * being written, if any.
+   */
+  std::list<std_cxx1x::shared_ptr<QueuedFile> > queue;
+
+  /**
+   * The memory occupied by the patches of all queued files.
+   */
+  std::size_t queued_memory;
+
+  /**
+   * Whether the writer thread is currently running.
+   */
+  bool writer_is_running;
+
+  /**
+   * The thread that writes the queued files.
+   */
+  Threads::Thread<void> writer_thread;
+
+  /**
+   * Descriptions of errors that occurred while writing files, along
+   * with the names of the files.
+   */
+  std::vector<std::pair<std::string,std::string> > errors;
+
+  /**
+   * A mutex that guards all of the member variables above, and a
+   * condition variable that is signalled whenever a file has been
+   * written.
+   */
+  mutable Threads::Mutex     mutex;
+  Threads::ConditionVariable file_written;
+};
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
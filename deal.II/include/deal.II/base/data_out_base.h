@@ -44,6 +44,7 @@ DEAL_II_NAMESPACE_OPEN
 
 class ParameterHandler;
 class XDMFEntry;
+template <int dim, int spacedim> class DataOutBackgroundWriter;
 
 /**
  * This is a base class for output of data on meshes of very general
@@ -980,12 +981,91 @@ namespace DataOutBase
       */
     bool print_date_and_time;
 
+    /**
+     * A data type providing the different possible zlib compression
+     * levels. These map directly to constants defined by zlib.
+     */
+    enum ZlibCompressionLevel
+    {
+      /**
+       * Do not use any compression.
+       */
+      no_compression,
+      /**
+       * Use the fastest available compression algorithm.
+       */
+      best_speed,
+      /**
+       * Use the algorithm which results in the smallest compressed
+       * files.
+       */
+      best_compression,
+      /**
+       * Use the default compression algorithm. This is a compromise
+       * between speed and file size.
+       */
+      default_compression
+    };
+
+    /**
+     * Flag determining the compression level at which zlib, if
+     * available, is run when writing VTU files. Compressing with
+     * #best_compression, the default, yields the smallest files but
+     * may take considerably longer than #best_speed for large outputs.
+     *
+     * This flag has no effect if deal.II was configured without zlib,
+     * since then VTU files are written in ASCII format.
+     */
+    ZlibCompressionLevel compression_level;
+
+    /**
+     * Flag determining whether write_vtu() writes the data arrays as
+     * raw binary data into an appended section at the end of the file,
+     * rather than as base64 encoded data inline in the XML elements.
+     * This avoids the overhead of base64 encoding, both in time and in
+     * the size of the file, which is otherwise about a third larger. On
+     * the other hand, the resulting files are no longer plain text and
+     * can not be processed by text-based XML tools.
+     *
+     * This flag is ignored by write_vtu_main(), which writes only a
+     * part of a file and can not know where the appended section will
+     * be placed; data is then written inline. Like #compression_level,
+     * this flag also has no effect if deal.II was configured without
+     * zlib.
+     *
+     * Default is <tt>false</tt>.
+     */
+    bool write_appended_raw_data;
+
+    /**
+     * Absolute error tolerances for lossy compression of the data
+     * written to VTU files, one for each data set (i.e., for each
+     * component of the output in the order of the data set names). If
+     * this vector is not empty, the values of data set <tt>i</tt> are
+     * rounded to the nearest multiple of the largest power of two not
+     * exceeding <tt>2*data_tolerances[i]</tt>, and so differ from the
+     * exact values by at most <tt>data_tolerances[i]</tt>. The rounded
+     * numbers have only few significant bits and are compressed much
+     * better by zlib than the unmodified data, in which the last bits
+     * are essentially random. A tolerance of zero writes the data set
+     * without loss, as do an empty vector, the default, and formats
+     * other than VTU.
+     *
+     * This is intended for the archival of large amounts of transient
+     * data, for which errors well below the discretization error are
+     * acceptable. As the files remain ordinary VTU files, no special
+     * reader is necessary.
+     */
+    std::vector<double> data_tolerances;
+
     /**
      * Default constructor.
      */
     VtkFlags (const double       time   = std::numeric_limits<double>::min(),
               const unsigned int cycle  = std::numeric_limits<unsigned int>::min(),
-              const bool print_date_and_time = true);
+              const bool print_date_and_time = true,
+              const ZlibCompressionLevel compression_level = best_compression,
+              const bool write_appended_raw_data = false);
 
     /**
      * Declare the flags with name and type as offered by this class,
@@ -1090,7 +1170,7 @@ namespace DataOutBase
 
   /**
    * Flags controlling the details of output in deal.II intermediate
-   * format. At present no flags are implemented.
+   * format.
    *
    * @ingroup output
    */
@@ -1105,19 +1185,23 @@ namespace DataOutBase
      */
     static const unsigned int format_version = 3;
 
-  private:
     /**
-     * Dummy entry to suppress compiler warnings when copying an empty
-     * structure. Remove this member when adding the first flag to
-     * this structure (and remove the <tt>private</tt> as well).
+     * Write the patches in binary rather than as text. The header of
+     * the file is the same in both cases, so that
+     * determine_intermediate_format_dimensions() and DataOutReader
+     * work with either. Binary files store all numbers exactly rather
+     * than rounded to a few digits, are usually smaller for real data,
+     * and are faster to write and to read. They use the byte order of
+     * the machine they were written on.
+     *
+     * Default: <code>false</code>.
      */
-    int dummy;
+    bool binary;
 
-  public:
     /**
      * Constructor.
      */
-    Deal_II_IntermediateFlags ();
+    Deal_II_IntermediateFlags (const bool binary = false);
 
     /**
      * Declare all flags with name and type as offered by this class,
@@ -1132,7 +1216,7 @@ namespace DataOutBase
      * The flags thus obtained overwrite
      * all previous contents of this object.
      */
-    void parse_parameters (const ParameterHandler &prm) const;
+    void parse_parameters (const ParameterHandler &prm);
 
     /**
      * Determine an estimate for the memory consumption (in bytes) of
@@ -1166,6 +1250,17 @@ namespace DataOutBase
      */
     bool xdmf_hdf5_output;
 
+    /**
+     * Absolute error tolerances for lossy compression of the data, one
+     * for each data set. The data is rounded as described for
+     * VtkFlags::data_tolerances before it is stored in the filter. The
+     * HDF5 files written from the filter are not compressed themselves,
+     * but compress well afterwards, e.g., with the deflate filter of
+     * <tt>h5repack</tt>. An empty vector, the default, leaves the data
+     * unchanged.
+     */
+    std::vector<double> data_tolerances;
+
     /**
      * Constructor.
      */
@@ -1223,19 +1318,6 @@ namespace DataOutBase
   class DataOutFilter
   {
   private:
-    /**
-     * Empty class to provide comparison function for Map3DPoint.
-     */
-    struct Point3Comp
-    {
-      bool operator() (const Point<3> &lhs, const Point<3> &rhs) const
-      {
-        return (lhs(0) < rhs(0) || (!(rhs(0) < lhs(0)) && (lhs(1) < rhs(1) || (!(rhs(1) < lhs(1)) && lhs(2) < rhs(2)))));
-      }
-    };
-
-    typedef std::multimap<Point<3>, unsigned int, Point3Comp> Map3DPoint;
-
     /// Flags used to specify filtering behavior
     DataOutBase::DataOutFilterFlags   flags;
 
@@ -1245,14 +1327,24 @@ namespace DataOutBase
     /// Number of vertices per cell
     int         n_cell_verts;
 
-    /// Map of points to an internal index
-    Map3DPoint        existing_points;
+    /// The recorded points, in the order of their internal index
+    std::vector<Point<3> >  existing_points;
+
+    /**
+     * Hash table used to find duplicate points. Each entry is either
+     * numbers::invalid_unsigned_int or the internal index of a point in
+     * existing_points. Collisions are resolved by linear probing, and the
+     * size of the table is a power of two that is kept at least twice the
+     * number of points, so that finding a point takes constant time on
+     * average.
+     */
+    std::vector<unsigned int>  point_hash_table;
 
     /// Map of actual point index to internal point index
-    std::map<unsigned int, unsigned int>  filtered_points;
+    std::vector<unsigned int>  filtered_points;
 
     /// Map of cells to the filtered points
-    std::map<unsigned int, unsigned int>  filtered_cells;
+    std::vector<unsigned int>  filtered_cells;
 
     /// Data set names
     std::vector<std::string>    data_set_names;
@@ -1268,6 +1360,13 @@ namespace DataOutBase
      */
     void internal_add_cell(const unsigned int &cell_index, const unsigned int &pt_index);
 
+    /**
+     * Return the internal index of the given point. If the point has not
+     * been recorded yet, or if we are not filtering redundant values,
+     * record it under a new internal index.
+     */
+    unsigned int internal_add_point(const Point<3> &p);
+
   public:
     DataOutFilter() : flags(false, true) {};
     DataOutFilter(const DataOutBase::DataOutFilterFlags &flags) : flags(flags) {};
@@ -1767,6 +1866,13 @@ namespace DataOutBase
    * Finally, for time dependent problems, you may also want to look
    * at DataOutInterface::write_pvd_record()
    *
+   * If deal.II was configured with zlib, the data arrays are split into
+   * blocks of a fixed size that are compressed independently of each
+   * other, and in parallel if multiple threads are available. The
+   * compression level can be chosen through VtkFlags::compression_level,
+   * and VtkFlags::write_appended_raw_data selects whether the compressed
+   * data is written as base64 encoded text or as raw binary data.
+   *
    * The use of this function is explained in step-40.
    */
   template <int dim, int spacedim>
@@ -1873,6 +1979,12 @@ namespace DataOutBase
    *
    * Intermediate format deal.II data is usually stored in files with
    * the ending <tt>.d2</tt>.
+   *
+   * If Deal_II_IntermediateFlags::binary is set, the patches are
+   * written in binary rather than as text. This is the preferred
+   * choice if the data is only stored to be converted later: numbers
+   * are stored without loss of precision, and neither writing nor
+   * reading them involves the conversion to and from text.
    */
   template <int dim, int spacedim>
   void write_deal_II_intermediate (
@@ -2264,6 +2376,44 @@ public:
    */
   void write_vtu_in_parallel (const char *filename, MPI_Comm comm) const;
 
+  /**
+   * Collective MPI call to write the solution from all processes in the
+   * given communicator to a small number of .vtu files, along with a
+   * .pvtu record that describes them. This is a compromise between
+   * write_vtu_in_parallel(), where all processes write to a single file,
+   * and each process writing its own file with write_vtu(), which leads
+   * to thousands of files per time step on large machines.
+   *
+   * The processes are split into groups. In each group, every process
+   * converts (and, if deal.II was configured with zlib, compresses) its
+   * own patches into a <code>Piece</code> of a VTU file and sends it to
+   * the first process of the group, the aggregator, which writes the
+   * pieces of all processes of its group one after the other into a file
+   * <tt>filename_without_extension.N.vtu</tt>. The files are numbered
+   * consecutively in the order of the ranks of their aggregators.
+   * The first process of the communicator then writes the record
+   * <tt>filename_without_extension.pvtu</tt> that lists all of these
+   * files, and which can be opened by ParaView or VisIt.
+   *
+   * If <tt>n_aggregators</tt> is zero, all processes that share the
+   * memory of one node form a group, i.e., one file is written per node.
+   * Otherwise, the processes are split into <tt>n_aggregators</tt> groups
+   * of consecutive ranks. For example, to write a single file through
+   * only one process, set <tt>n_aggregators</tt> to one.
+   *
+   * The aggregators only hold the data of one process at a time in
+   * memory. The directory part of <tt>filename_without_extension</tt> is
+   * not included in the names of the files listed in the .pvtu record,
+   * i.e., the files are referenced relative to the record.
+   *
+   * If deal.II was configured without MPI, this function writes the
+   * single file <tt>filename_without_extension.0.vtu</tt> and the .pvtu
+   * record for it.
+   */
+  void write_vtu_aggregated (const std::string &filename_without_extension,
+                             const unsigned int n_aggregators,
+                             MPI_Comm           comm) const;
+
   /**
    * Some visualization programs, such as
    * ParaView, can read several separate
@@ -2695,6 +2845,21 @@ protected:
   std::vector<std_cxx1x::tuple<unsigned int, unsigned int, std::string> >
   get_vector_data_ranges () const;
 
+  /**
+   * Hand the patches of this object over to the caller by storing them
+   * in the given vector, whose previous content is lost. This is used by
+   * DataOutBackgroundWriter to take over the patches for output in the
+   * background.
+   *
+   * The default implementation copies the patches returned by
+   * get_patches(). Derived classes that store the patches themselves
+   * overload this function to hand them over without copying, in which
+   * case this object does not have any patches any more afterwards.
+   */
+  virtual
+  void
+  release_patches (std::vector<DataOutBase::Patch<dim,spacedim> > &patches);
+
   /**
    * The default number of subdivisions for patches. This is filled by
    * parse_parameters() and should be obeyed by build_patches() in
@@ -2775,6 +2940,12 @@ private:
    * function.
    */
   DataOutBase::Deal_II_IntermediateFlags     deal_II_intermediate_flags;
+
+  /**
+   * Make the class that writes output in the background a friend, since
+   * it needs to get at the patches and data set names.
+   */
+  template <int, int> friend class DataOutBackgroundWriter;
 };
 
 
@@ -2867,6 +3038,23 @@ public:
    */
   void merge (const DataOutReader<dim,spacedim> &other);
 
+  /**
+   * Read the files with the given names, each of which contains
+   * patches as written by <tt>DataOutBase::write_deal_II_intermediate</tt>,
+   * and store the union of their patches in the present object. This
+   * overwrites any previous content.
+   *
+   * This is the typical way to put together the output of a parallel
+   * program in which every process has written the patches of its own
+   * cells to a separate file. The files are read in parallel if
+   * multithreading is enabled, and the patches are then merged in one
+   * pass, rather than by calling merge() once for every file. As for
+   * merge(), all files need to describe the same data sets and use the
+   * same number of subdivisions per patch. Files without any patches
+   * are allowed.
+   */
+  void read (const std::vector<std::string> &filenames);
+
   /**
    * Exception
    */
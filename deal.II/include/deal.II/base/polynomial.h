@@ -104,6 +104,29 @@ namespace Polynomials
     void value (const number         x,
                 std::vector<number> &values) const;
 
+    /**
+     * Compute the value and the first <tt>n_derivatives</tt> derivatives of
+     * the polynomial at point <tt>x</tt> and store them in
+     * <tt>values[0]</tt> to <tt>values[n_derivatives]</tt>. This is the
+     * same as the previous function, but writes into a buffer provided by
+     * the caller, so no memory is allocated.
+     *
+     * The type of <tt>x</tt> may be <tt>number</tt> or any other type that
+     * supports the arithmetic operations with scalars of type
+     * <tt>number</tt>, in particular VectorizedArray<number>. In the latter
+     * case, the polynomial is evaluated at
+     * VectorizedArray<number>::n_array_elements points at once with
+     * vectorized instructions, which is useful if a polynomial is to be
+     * evaluated at many points, for instance at all quadrature points.
+     *
+     * This function uses the Horner scheme for numerical stability of the
+     * evaluation and gives exactly the same results as the previous one.
+     */
+    template <typename Number2>
+    void value (const Number2      &x,
+                const unsigned int  n_derivatives,
+                Number2            *values) const;
+
     /**
      * Degree of the polynomial. This is the degree reflected by the number of
      * coefficients provided by the constructor. Leading non-zero coefficients
@@ -719,6 +742,72 @@ namespace Polynomials
 
 
 
+  template <typename number>
+  template <typename Number2>
+  inline
+  void
+  Polynomial<number>::value (const Number2      &x,
+                             const unsigned int  n_derivatives,
+                             Number2            *values) const
+  {
+    if (in_lagrange_product_form == true)
+      {
+        // to compute the value and all derivatives of a polynomial of the
+        // form (x-x_1)*(x-x_2)*...*(x-x_n), expand the derivatives like
+        // automatic differentiation does, starting from the highest
+        // derivative since it uses the old value of the next lower one
+        const unsigned int n_supp = lagrange_support_points.size();
+        values[0] = 1.;
+        for (unsigned int k=1; k<=n_derivatives; ++k)
+          values[k] = 0.;
+        for (unsigned int i=0; i<n_supp; ++i)
+          {
+            const Number2 v = x-lagrange_support_points[i];
+            for (unsigned int k=n_derivatives; k>0; --k)
+              values[k] = values[k] * v + values[k-1];
+            values[0] = values[0] * v;
+          }
+
+        // multiply by the weight in the Lagrange denominator and by k! to
+        // transform p^(k)(x)/k! into the actual derivative
+        number k_faculty = 1;
+        for (unsigned int k=0; k<=n_derivatives; ++k)
+          {
+            values[k] = values[k] * (k_faculty * lagrange_weight);
+            k_faculty *= static_cast<number>(k+1);
+          }
+      }
+    else
+      {
+        Assert (coefficients.size() > 0, ExcEmptyObject());
+
+        // Horner scheme for the value and the derivatives at the same
+        // time: after processing coefficient k, values[j] holds the jth
+        // coefficient of the expansion around x of the polynomial formed
+        // by the coefficients k,...,m-1. derivatives of order m and higher
+        // stay zero
+        const unsigned int m = coefficients.size();
+        values[0] = coefficients[m-1];
+        for (unsigned int j=1; j<=n_derivatives; ++j)
+          values[j] = 0.;
+        for (int k=m-2; k>=0; --k)
+          {
+            for (unsigned int j=n_derivatives; j>0; --j)
+              values[j] = values[j] * x + values[j-1];
+            values[0] = values[0] * x + coefficients[k];
+          }
+
+        number j_faculty = 1;
+        for (unsigned int j=1; j<=n_derivatives; ++j)
+          {
+            j_faculty *= static_cast<number>(j);
+            values[j] = values[j] * j_faculty;
+          }
+      }
+  }
+
+
+
   template <typename number>
   template <class Archive>
   inline
@@ -435,6 +435,49 @@ private:
 
 
 
+/**
+ * A registry of Gauss and Gauss-Lobatto quadrature formulas.
+ *
+ * The points and weights of the one-dimensional QGauss and QGaussLobatto
+ * formulas are computed only once per program run for each number of
+ * points, but every object of these classes still forms and stores the
+ * tensor product in higher dimensions. Code that needs the same formula
+ * over and over again, for instance when it creates the formula inside a
+ * loop over cells, can instead ask this class for it. The formula is
+ * created the first time it is requested, and all later requests return a
+ * reference to the same object, which lives until the end of the program.
+ *
+ * All functions of this class may be called from several threads at the
+ * same time.
+ *
+ * @code
+ *   for (cell=...)
+ *     {
+ *       const Quadrature<dim> &quadrature
+ *         = QuadratureRegistry<dim>::gauss (cell->get_fe().degree+1);
+ *       ...
+ *     }
+ * @endcode
+ */
+template <int dim>
+class QuadratureRegistry
+{
+public:
+  /**
+   * Return the Gauss formula with <tt>n</tt> points in each space
+   * direction, i.e., an object equal to <tt>QGauss<dim>(n)</tt>.
+   */
+  static const Quadrature<dim> &gauss (const unsigned int n);
+
+  /**
+   * Return the Gauss-Lobatto formula with <tt>n</tt> points in each space
+   * direction, i.e., an object equal to <tt>QGaussLobatto<dim>(n)</tt>.
+   */
+  static const Quadrature<dim> &gauss_lobatto (const unsigned int n);
+};
+
+
+
 /*@}*/
 
 /* -------------- declaration of explicit specializations ------------- */
@@ -27,6 +27,7 @@ DEAL_II_NAMESPACE_OPEN
 namespace std_cxx1x
 {
   using std::shared_ptr;
+  using std::weak_ptr;
   using std::enable_shared_from_this;
 }
 DEAL_II_NAMESPACE_CLOSE
@@ -34,11 +35,13 @@ DEAL_II_NAMESPACE_CLOSE
 #else
 
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
 DEAL_II_NAMESPACE_OPEN
 namespace std_cxx1x
 {
   using boost::shared_ptr;
+  using boost::weak_ptr;
   using boost::enable_shared_from_this;
 }
 DEAL_II_NAMESPACE_CLOSE
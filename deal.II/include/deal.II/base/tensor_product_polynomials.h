@@ -23,6 +23,7 @@
 #include <deal.II/base/tensor.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/polynomial.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/utilities.h>
 
 #include <vector>
@@ -120,6 +121,26 @@ public:
                 std::vector<Tensor<1,dim> > &grads,
                 std::vector<Tensor<2,dim> > &grad_grads) const;
 
+  /**
+   * Computes the values and the first derivatives of all tensor product
+   * polynomials at all the given points. On return, <tt>values(i,q)</tt>
+   * and <tt>grads(i,q)</tt> contain the value and the gradient of
+   * polynomial <tt>i</tt> at <tt>unit_points[q]</tt>.
+   *
+   * The tables must either be empty or of size n() times
+   * <tt>unit_points.size()</tt>. In the first case, the function will not
+   * compute these values.
+   *
+   * This function gives the same results as calling the previous one for
+   * each point, but is considerably faster if there are many points, for
+   * instance all quadrature points of a cell: the one-dimensional
+   * polynomials are evaluated at several points at once using
+   * VectorizedArray, and no memory is allocated per point.
+   */
+  void compute (const std::vector<Point<dim> > &unit_points,
+                Table<2,double>                &values,
+                Table<2,Tensor<1,dim> >        &grads) const;
+
   /**
    * Computes the value of the <tt>i</tt>th tensor product polynomial at
    * <tt>unit_point</tt>. Here <tt>i</tt> is given in tensor product
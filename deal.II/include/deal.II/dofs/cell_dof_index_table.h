@@ -0,0 +1,302 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef __deal2__cell_dof_index_table_h
+#define __deal2__cell_dof_index_table_h
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/types.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A table of the global indices of the degrees of freedom of all active
+ * cells of a DoFHandler or hp::DoFHandler, stored in one contiguous array
+ * in the order in which the active cells are traversed by the iterators
+ * of the DoFHandler, i.e. in compressed row format with one row per cell.
+ *
+ * DoFCellAccessor::get_dof_indices() and related functions already read the
+ * indices of a cell from a cache, but this cache is split by levels and
+ * contains entries for cells that are not active, and each call accesses
+ * only one cell. This class is useful if the degrees of freedom of a whole
+ * range of cells are needed at once: get_dof_values() collects the values
+ * of a global vector for all cells in a range with one call to
+ * <tt>extract_subvector_to()</tt> into a contiguous buffer, and
+ * distribute_local_to_global() adds a buffer of the same layout back into a
+ * global vector. This lets codes process cells in batches, for instance the
+ * evaluation of residuals in Newton iterations, where the values of the
+ * old solution on a batch of cells can be collected once and then reused by
+ * several evaluations.
+ *
+ * Cells are identified by their number in the sequence of active cells,
+ * starting at zero for <tt>dof_handler.begin_active()</tt>. The number of
+ * a cell iterator can be obtained from cell_number(). Artificial cells of a
+ * parallel::distributed::Triangulation are numbered as well, but have no
+ * degrees of freedom in the table.
+ *
+ * The table is a snapshot: it needs to be rebuilt by calling reinit() after
+ * each call to DoFHandler::distribute_dofs() or after renumbering the
+ * degrees of freedom.
+ *
+ * @ingroup dofs
+ */
+template <class DH>
+class CellDoFIndexTable : public Subscriptor
+{
+public:
+  /**
+   * Declare a typedef for the iterators of the active cells of the
+   * DoFHandler.
+   */
+  typedef typename DH::active_cell_iterator active_cell_iterator;
+
+  /**
+   * Default constructor. Call reinit() before using the object.
+   */
+  CellDoFIndexTable ();
+
+  /**
+   * Constructor. Build the table for the given DoFHandler.
+   */
+  CellDoFIndexTable (const DH &dof_handler);
+
+  /**
+   * Build the table for the given DoFHandler, on which
+   * <tt>distribute_dofs()</tt> must have been called.
+   */
+  void reinit (const DH &dof_handler);
+
+  /**
+   * Release all memory and the DoFHandler.
+   */
+  void clear ();
+
+  /**
+   * Return the number of active cells in the table.
+   */
+  unsigned int n_cells () const;
+
+  /**
+   * Return the number of the given active cell.
+   */
+  unsigned int cell_number (const active_cell_iterator &cell) const;
+
+  /**
+   * Return the position of the first degree of freedom of a cell in the
+   * table. The degrees of freedom of cell <tt>c</tt> are at positions
+   * <tt>cell_start(c)</tt> to <tt>cell_start(c+1)-1</tt>, and
+   * <tt>cell_start(n_cells())</tt> is the total size of the table. In a
+   * buffer filled by get_dof_values() for the cells starting at
+   * <tt>begin_cell</tt>, the values of cell <tt>c</tt> start at
+   * <tt>cell_start(c)-cell_start(begin_cell)</tt>.
+   */
+  std::size_t cell_start (const unsigned int cell) const;
+
+  /**
+   * Return the number of degrees of freedom of a cell.
+   */
+  unsigned int n_dofs_per_cell (const unsigned int cell) const;
+
+  /**
+   * Return a pointer to the global indices of the degrees of freedom of a
+   * cell. The next n_dofs_per_cell() entries belong to this cell.
+   */
+  const types::global_dof_index *dof_indices (const unsigned int cell) const;
+
+  /**
+   * Copy the global indices of the degrees of freedom of a cell into the
+   * given vector, which must have the correct size.
+   */
+  void get_dof_indices (const unsigned int                    cell,
+                        std::vector<types::global_dof_index> &indices) const;
+
+  /**
+   * Collect the values of <tt>values</tt> at the degrees of freedom of the
+   * cells <tt>begin_cell</tt> to <tt>end_cell-1</tt> into
+   * <tt>local_values</tt>, which is resized to the number of these degrees
+   * of freedom. Values of degrees of freedom shared by several cells appear
+   * once for each of the cells.
+   *
+   * The type of <tt>values</tt> may be any vector class of the library
+   * that provides <tt>extract_subvector_to()</tt>.
+   */
+  template <class InputVector, typename number>
+  void get_dof_values (const InputVector   &values,
+                       const unsigned int   begin_cell,
+                       const unsigned int   end_cell,
+                       std::vector<number> &local_values) const;
+
+  /**
+   * The opposite of get_dof_values(): add the entries of
+   * <tt>local_values</tt>, which has the layout described there, to the
+   * global vector <tt>global_destination</tt>. Constraints are not taken
+   * into account.
+   */
+  template <typename number, class OutputVector>
+  void distribute_local_to_global (const std::vector<number> &local_values,
+                                   const unsigned int         begin_cell,
+                                   const unsigned int         end_cell,
+                                   OutputVector              &global_destination) const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t memory_consumption () const;
+
+  /**
+   * Exception
+   */
+  DeclException0 (ExcTableOutdated);
+
+private:
+  /**
+   * The DoFHandler the table was built for.
+   */
+  SmartPointer<const DH,CellDoFIndexTable<DH> > dof_handler;
+
+  /**
+   * The number of degrees of freedom of the DoFHandler at the time the
+   * table was built. Used to detect tables that were not rebuilt after a
+   * new call to distribute_dofs().
+   */
+  types::global_dof_index n_dofs;
+
+  /**
+   * The start of the degrees of freedom of each cell in dof_index_table,
+   * with one additional entry at the end.
+   */
+  std::vector<std::size_t> row_starts;
+
+  /**
+   * The global indices of the degrees of freedom of all cells.
+   */
+  std::vector<types::global_dof_index> dof_index_table;
+
+  /**
+   * The number of each active cell, indexed by the level and index of the
+   * cell.
+   */
+  std::vector<std::vector<unsigned int> > cell_numbers;
+};
+
+
+/* ------------------------- inline functions ------------------------- */
+
+#ifndef DOXYGEN
+
+template <class DH>
+inline
+unsigned int
+CellDoFIndexTable<DH>::n_cells () const
+{
+  return (row_starts.size() > 0 ? row_starts.size()-1 : 0);
+}
+
+
+
+template <class DH>
+inline
+std::size_t
+CellDoFIndexTable<DH>::cell_start (const unsigned int cell) const
+{
+  AssertIndexRange (cell, row_starts.size());
+  return row_starts[cell];
+}
+
+
+
+template <class DH>
+inline
+unsigned int
+CellDoFIndexTable<DH>::n_dofs_per_cell (const unsigned int cell) const
+{
+  AssertIndexRange (cell, n_cells());
+  return row_starts[cell+1] - row_starts[cell];
+}
+
+
+
+template <class DH>
+inline
+const types::global_dof_index *
+CellDoFIndexTable<DH>::dof_indices (const unsigned int cell) const
+{
+  AssertIndexRange (cell, n_cells());
+  Assert (dof_handler->n_dofs() == n_dofs, ExcTableOutdated());
+  return dof_index_table.empty() ? 0 : &dof_index_table[row_starts[cell]];
+}
+
+
+
+template <class DH>
+template <class InputVector, typename number>
+inline
+void
+CellDoFIndexTable<DH>::get_dof_values (const InputVector   &values,
+                                       const unsigned int   begin_cell,
+                                       const unsigned int   end_cell,
+                                       std::vector<number> &local_values) const
+{
+  Assert (begin_cell <= end_cell, ExcIndexRange (begin_cell, 0, end_cell+1));
+  AssertIndexRange (end_cell, n_cells()+1);
+  Assert (dof_handler->n_dofs() == n_dofs, ExcTableOutdated());
+  AssertDimension (values.size(), n_dofs);
+
+  const std::size_t begin = row_starts[begin_cell],
+                    end   = row_starts[end_cell];
+  local_values.resize (end-begin);
+  if (end > begin)
+    values.extract_subvector_to (dof_index_table.begin() + begin,
+                                 dof_index_table.begin() + end,
+                                 local_values.begin());
+}
+
+
+
+template <class DH>
+template <typename number, class OutputVector>
+inline
+void
+CellDoFIndexTable<DH>::distribute_local_to_global (const std::vector<number> &local_values,
+                                                   const unsigned int         begin_cell,
+                                                   const unsigned int         end_cell,
+                                                   OutputVector              &global_destination) const
+{
+  Assert (begin_cell <= end_cell, ExcIndexRange (begin_cell, 0, end_cell+1));
+  AssertIndexRange (end_cell, n_cells()+1);
+  Assert (dof_handler->n_dofs() == n_dofs, ExcTableOutdated());
+  AssertDimension (global_destination.size(), n_dofs);
+
+  const std::size_t begin = row_starts[begin_cell],
+                    end   = row_starts[end_cell];
+  AssertDimension (local_values.size(), end-begin);
+  if (end > begin)
+    global_destination.add (end-begin, &dof_index_table[begin],
+                            &local_values[0]);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
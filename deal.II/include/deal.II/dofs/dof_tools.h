@@ -1694,6 +1694,25 @@ namespace DoFTools
   get_active_fe_indices (const DH                  &dof_handler,
                          std::vector<unsigned int> &active_fe_indices);
 
+  /**
+   * Sort the active cells of a DoFHandler or hp::DoFHandler by their
+   * active finite element index. Element <tt>i</tt> of the returned vector
+   * contains the iterators to all active cells that are not artificial and
+   * whose active_fe_index() is <tt>i</tt>, in the order in which they are
+   * traversed by the active cell iterators.
+   *
+   * Assembly loops for hp computations can use this to work on all cells
+   * with the same finite element in a row. The hp::FEValues object then
+   * uses the same ::FEValues object for all cells of such a group, and the
+   * local matrices and vectors have the same size for all of them.
+   *
+   * For non-hp DoFHandler objects, the returned vector has only one
+   * element.
+   */
+  template <class DH>
+  std::vector<std::vector<typename DH::active_cell_iterator> >
+  get_active_cells_by_fe_index (const DH &dof_handler);
+
   /**
    * Count how many degrees of freedom out of the total number belong
    * to each component. If the number of components the finite element
@@ -18,8 +18,13 @@
 #define __deal2__fe_poly_h
 
 
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/std_cxx1x/shared_ptr.h>
 #include <deal.II/fe/fe.h>
 
+#include <vector>
+
 DEAL_II_NAMESPACE_OPEN
 
 /*!@addtogroup febase */
@@ -247,6 +252,55 @@ protected:
   virtual UpdateFlags update_each (const UpdateFlags flags) const;
 
 
+  /**
+   * The values and gradients of the shape functions at the points of a
+   * quadrature formula on the unit cell.
+   *
+   * These tables do not depend on the cell and are not changed after they
+   * have been computed. All InternalData objects created for the same
+   * quadrature formula therefore share one object of this type, for
+   * example the ones of the FEValues objects that the threads of a
+   * WorkStream loop keep in their scratch data. For high order elements,
+   * this saves a large amount of memory and the time to compute the tables
+   * when such an object is copied.
+   */
+  struct ShapeTables
+  {
+    /**
+     * The quadrature formula for which the tables were computed.
+     */
+    Quadrature<dim> quadrature;
+
+    /**
+     * Whether the values and the gradients have been computed.
+     */
+    bool has_values;
+    bool has_gradients;
+
+    /**
+     * The values of the shape functions, one row per shape function with
+     * one entry per quadrature point. Empty if <tt>has_values</tt> is false.
+     */
+    std::vector<std::vector<double> > shape_values;
+
+    /**
+     * The gradients of the shape functions on the unit cell, in the same
+     * layout. Empty if <tt>has_gradients</tt> is false.
+     */
+    std::vector<std::vector<Tensor<1,dim> > > shape_gradients;
+  };
+
+  /**
+   * Return tables with (at least) the values and gradients of the shape
+   * functions requested by <tt>flags</tt> at the points of the given
+   * quadrature formula. If there are still InternalData objects using
+   * suitable tables, these are returned, otherwise new tables are computed.
+   * This function can be called from several threads at the same time.
+   */
+  std_cxx1x::shared_ptr<const ShapeTables>
+  get_shape_tables (const UpdateFlags      flags,
+                    const Quadrature<dim> &quadrature) const;
+
   /**
    * Fields of cell-independent data.
    *
@@ -256,6 +310,18 @@ protected:
   class InternalData : public FiniteElement<dim,spacedim>::InternalDataBase
   {
   public:
+    /**
+     * Constructor. Store the tables of shape function values and gradients,
+     * which may be shared with other objects of this type.
+     */
+    InternalData (const std_cxx1x::shared_ptr<const ShapeTables> &tables);
+
+    /**
+     * The tables of values and gradients of the shape functions on the unit
+     * cell. The following two references point into this object.
+     */
+    const std_cxx1x::shared_ptr<const ShapeTables> shape_tables;
+
     /**
      * Array with shape function values in quadrature points. There is one row
      * for each shape function, containing values for each quadrature point.
@@ -265,7 +331,7 @@ protected:
      * under transformation to the real cell, we only need to copy them over
      * when visiting a concrete cell.
      */
-    std::vector<std::vector<double> > shape_values;
+    const std::vector<std::vector<double> > &shape_values;
 
     /**
      * Array with shape function gradients in quadrature points. There is one
@@ -276,13 +342,34 @@ protected:
      * then only have to apply the transformation (which is a matrix-vector
      * multiplication) when visiting an actual cell.
      */
-    std::vector<std::vector<Tensor<1,dim> > > shape_gradients;
+    const std::vector<std::vector<Tensor<1,dim> > > &shape_gradients;
+
+    /**
+     * Scratch array into which the gradients of one shape function are
+     * transformed to the real cell before they are copied into the
+     * FEValues object.
+     */
+    std::vector<Tensor<1,spacedim> > transformed_shape_gradients;
   };
 
   /**
    * The polynomial space. Its type is given by the template parameter POLY.
    */
   POLY poly_space;
+
+private:
+  /**
+   * The tables of shape function values and gradients handed out by
+   * get_shape_tables(). Only weak references are stored, so that the tables
+   * are deleted as soon as the last InternalData object using them is
+   * destroyed.
+   */
+  mutable std::vector<std_cxx1x::weak_ptr<const ShapeTables> > shape_tables_cache;
+
+  /**
+   * A mutex guarding access to shape_tables_cache.
+   */
+  mutable Threads::Mutex shape_tables_mutex;
 };
 
 /*@}*/
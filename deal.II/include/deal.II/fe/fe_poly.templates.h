@@ -24,6 +24,52 @@
 
 DEAL_II_NAMESPACE_OPEN
 
+
+namespace internal
+{
+  // compute the values and gradients of all polynomials of a polynomial
+  // space at all the given points. the tables are either empty or of
+  // size n_pols times points.size(). this is the general version, which
+  // evaluates the polynomials one point at a time
+  template <class POLY, int dim>
+  void
+  compute_shape_functions (const POLY                      &poly_space,
+                           const unsigned int               n_pols,
+                           const std::vector<Point<dim> >  &points,
+                           dealii::Table<2,double>         &values,
+                           dealii::Table<2,Tensor<1,dim> > &grads)
+  {
+    std::vector<double> point_values (values.n_elements() > 0 ? n_pols : 0);
+    std::vector<Tensor<1,dim> > point_grads (grads.n_elements() > 0 ? n_pols : 0);
+    std::vector<Tensor<2,dim> > point_grad_grads;
+    for (unsigned int q=0; q<points.size(); ++q)
+      {
+        poly_space.compute (points[q], point_values, point_grads,
+                            point_grad_grads);
+        for (unsigned int k=0; k<point_values.size(); ++k)
+          values(k,q) = point_values[k];
+        for (unsigned int k=0; k<point_grads.size(); ++k)
+          grads(k,q) = point_grads[k];
+      }
+  }
+
+
+
+  // tensor product polynomials can evaluate all points at once
+  template <int dim, typename POLY1>
+  void
+  compute_shape_functions (const TensorProductPolynomials<dim,POLY1> &poly_space,
+                           const unsigned int,
+                           const std::vector<Point<dim> >  &points,
+                           dealii::Table<2,double>         &values,
+                           dealii::Table<2,Tensor<1,dim> > &grads)
+  {
+    poly_space.compute (points, values, grads);
+  }
+}
+
+
+
 template <class POLY, int dim, int spacedim>
 FE_Poly<POLY,dim,spacedim>::FE_Poly (const POLY &poly_space,
                                      const FiniteElementData<dim> &fe_data,
@@ -160,49 +206,127 @@ FE_Poly<POLY,dim,spacedim>::update_each (const UpdateFlags flags) const
 // Data field initialization
 //---------------------------------------------------------------------------
 
+template <class POLY, int dim, int spacedim>
+FE_Poly<POLY,dim,spacedim>::InternalData::
+InternalData (const std_cxx1x::shared_ptr<const ShapeTables> &tables)
+  :
+  shape_tables (tables),
+  shape_values (tables->shape_values),
+  shape_gradients (tables->shape_gradients)
+{}
+
+
+
+template <class POLY, int dim, int spacedim>
+std_cxx1x::shared_ptr<const typename FE_Poly<POLY,dim,spacedim>::ShapeTables>
+FE_Poly<POLY,dim,spacedim>::get_shape_tables (const UpdateFlags      flags,
+                                              const Quadrature<dim> &quadrature) const
+{
+  const bool need_values    = (flags & update_values),
+             need_gradients = (flags & update_gradients);
+
+  // the lock is held also while computing new tables, so that several
+  // threads asking for the same tables at the same time only compute them
+  // once
+  Threads::Mutex::ScopedLock lock (shape_tables_mutex);
+
+  // look for tables that are still in use and contain everything we
+  // need. drop the entries of tables that have been deleted in the
+  // meantime
+  std_cxx1x::shared_ptr<const ShapeTables> tables;
+  for (unsigned int i=0; i<shape_tables_cache.size(); )
+    {
+      std_cxx1x::shared_ptr<const ShapeTables> cached = shape_tables_cache[i].lock();
+      if (!cached)
+        {
+          shape_tables_cache.erase (shape_tables_cache.begin()+i);
+          continue;
+        }
+      if (!tables
+          &&
+          (cached->has_values || !need_values)
+          &&
+          (cached->has_gradients || !need_gradients)
+          &&
+          (cached->quadrature == quadrature))
+        tables = cached;
+      ++i;
+    }
+  if (tables)
+    return tables;
+
+  ShapeTables *new_tables = new ShapeTables;
+  new_tables->quadrature = quadrature;
+  new_tables->has_values = need_values;
+  new_tables->has_gradients = need_gradients;
+
+  const unsigned int n_q_points = quadrature.size();
+  if (need_values || need_gradients)
+    {
+      // some scratch arrays. initialize them only if really necessary,
+      // otherwise don't allocate memory
+      Table<2,double> values (need_values ? this->dofs_per_cell : 0,
+                              n_q_points);
+      Table<2,Tensor<1,dim> > grads (need_gradients ? this->dofs_per_cell : 0,
+                                     n_q_points);
+      internal::compute_shape_functions (poly_space, this->dofs_per_cell,
+                                         quadrature.get_points(),
+                                         values, grads);
+
+      if (need_values)
+        {
+          new_tables->shape_values.resize (this->dofs_per_cell,
+                                           std::vector<double> (n_q_points));
+          for (unsigned int k=0; k<this->dofs_per_cell; ++k)
+            for (unsigned int i=0; i<n_q_points; ++i)
+              new_tables->shape_values[k][i] = values(k,i);
+        }
+
+      if (need_gradients)
+        {
+          new_tables->shape_gradients.resize (this->dofs_per_cell,
+                                              std::vector<Tensor<1,dim> > (n_q_points));
+          for (unsigned int k=0; k<this->dofs_per_cell; ++k)
+            for (unsigned int i=0; i<n_q_points; ++i)
+              new_tables->shape_gradients[k][i] = grads(k,i);
+        }
+    }
+
+  tables.reset (new_tables);
+  shape_tables_cache.push_back (tables);
+  return tables;
+}
+
+
+
 template <class POLY, int dim, int spacedim>
 typename Mapping<dim,spacedim>::InternalDataBase *
 FE_Poly<POLY,dim,spacedim>::get_data (const UpdateFlags      update_flags,
                                       const Mapping<dim,spacedim>    &mapping,
                                       const Quadrature<dim> &quadrature) const
 {
-  // generate a new data object and
-  // initialize some fields
-  InternalData *data = new InternalData;
-
   // check what needs to be
   // initialized only once and what
   // on every cell/face/subface we
   // visit
+  const UpdateFlags flags = update_once(update_flags) | update_each(update_flags);
+
+  // generate a new data object. the
+  // values and the gradients on the
+  // unit cell are the same for every
+  // cell/face/subface we visit, and
+  // are shared with all other data
+  // objects for the same quadrature
+  // formula. note that the shape
+  // gradients are only those on the
+  // unit cell, and need to be
+  // transformed when visiting an
+  // actual cell
+  InternalData *data = new InternalData (get_shape_tables (flags, quadrature));
   data->update_once = update_once(update_flags);
   data->update_each = update_each(update_flags);
   data->update_flags = data->update_once | data->update_each;
 
-  const UpdateFlags flags(data->update_flags);
-  const unsigned int n_q_points = quadrature.size();
-
-  // some scratch arrays
-  std::vector<double> values(0);
-  std::vector<Tensor<1,dim> > grads(0);
-  std::vector<Tensor<2,dim> > grad_grads(0);
-
-  // initialize fields only if really
-  // necessary. otherwise, don't
-  // allocate memory
-  if (flags & update_values)
-    {
-      values.resize (this->dofs_per_cell);
-      data->shape_values.resize (this->dofs_per_cell,
-                                 std::vector<double> (n_q_points));
-    }
-
-  if (flags & update_gradients)
-    {
-      grads.resize (this->dofs_per_cell);
-      data->shape_gradients.resize (this->dofs_per_cell,
-                                    std::vector<Tensor<1,dim> > (n_q_points));
-    }
-
   // if second derivatives through
   // finite differencing is required,
   // then initialize some objects for
@@ -210,27 +334,6 @@ FE_Poly<POLY,dim,spacedim>::get_data (const UpdateFlags      update_flags,
   if (flags & update_hessians)
     data->initialize_2nd (this, mapping, quadrature);
 
-  // next already fill those fields
-  // of which we have information by
-  // now. note that the shape
-  // gradients are only those on the
-  // unit cell, and need to be
-  // transformed when visiting an
-  // actual cell
-  if (flags & (update_values | update_gradients))
-    for (unsigned int i=0; i<n_q_points; ++i)
-      {
-        poly_space.compute(quadrature.point(i),
-                           values, grads, grad_grads);
-
-        if (flags & update_values)
-          for (unsigned int k=0; k<this->dofs_per_cell; ++k)
-            data->shape_values[k][i] = values[k];
-
-        if (flags & update_gradients)
-          for (unsigned int k=0; k<this->dofs_per_cell; ++k)
-            data->shape_gradients[k][i] = grads[k];
-      }
   return data;
 }
 
@@ -269,8 +372,17 @@ FE_Poly<POLY,dim,spacedim>::fill_fe_values
           data.shape_values(k,i) = fe_data.shape_values[k][i];
 
       if (flags & update_gradients && cell_similarity != CellSimilarity::translation)
-        mapping.transform(fe_data.shape_gradients[k], data.shape_gradients[k],
-                          mapping_data, mapping_covariant);
+        {
+          // transform into a scratch array first, since the mapping can not
+          // write into a row of the table in which FEValues stores the
+          // gradients of all shape functions contiguously
+          fe_data.transformed_shape_gradients.resize (quadrature.size());
+          mapping.transform(fe_data.shape_gradients[k], fe_data.transformed_shape_gradients,
+                            mapping_data, mapping_covariant);
+          std::copy (fe_data.transformed_shape_gradients.begin(),
+                     fe_data.transformed_shape_gradients.end(),
+                     data.shape_gradients[k].begin());
+        }
     }
 
   if (flags & update_hessians && cell_similarity != CellSimilarity::translation)
@@ -318,9 +430,14 @@ fill_fe_face_values (const Mapping<dim,spacedim>                   &mapping,
           data.shape_values(k,i) = fe_data.shape_values[k][i+offset];
 
       if (flags & update_gradients)
-        mapping.transform(make_slice(fe_data.shape_gradients[k], offset, quadrature.size()),
-                          data.shape_gradients[k],
-                          mapping_data, mapping_covariant);
+        {
+          fe_data.transformed_shape_gradients.resize (quadrature.size());
+          mapping.transform(make_slice(fe_data.shape_gradients[k], offset, quadrature.size()), fe_data.transformed_shape_gradients,
+                            mapping_data, mapping_covariant);
+          std::copy (fe_data.transformed_shape_gradients.begin(),
+                     fe_data.transformed_shape_gradients.end(),
+                     data.shape_gradients[k].begin());
+        }
     }
 
   if (flags & update_hessians)
@@ -434,9 +551,14 @@ FE_Poly<POLY,dim,spacedim>::fill_fe_subface_values (const Mapping<dim,spacedim>
           data.shape_values(k,i) = fe_data.shape_values[k][i+offset];
 
       if (flags & update_gradients)
-        mapping.transform(make_slice(fe_data.shape_gradients[k], offset, quadrature.size()),
-                          data.shape_gradients[k],
-                          mapping_data, mapping_covariant);
+        {
+          fe_data.transformed_shape_gradients.resize (quadrature.size());
+          mapping.transform(make_slice(fe_data.shape_gradients[k], offset, quadrature.size()), fe_data.transformed_shape_gradients,
+                            mapping_data, mapping_covariant);
+          std::copy (fe_data.transformed_shape_gradients.begin(),
+                     fe_data.transformed_shape_gradients.end(),
+                     data.shape_gradients[k].begin());
+        }
     }
 
   if (flags & update_hessians)
@@ -363,6 +363,29 @@ namespace FETools
     std::vector<std::vector<FullMatrix<number> > > &matrices,
     const bool isotropic_only = false);
 
+  /**
+   * Set the directory in which compute_embedding_matrices() and
+   * compute_projection_matrices() store the matrices they compute, and from
+   * which they read them back instead of computing them again. Computing
+   * these matrices requires the solution of a least squares or mass matrix
+   * problem for every shape function on every child cell, which for elements
+   * of higher degree and in 3d dominates the time spent in the constructor
+   * of elements such as FE_RaviartThomas or FE_Nedelec, or when first using
+   * the transfer matrices of FE_DGQ. Programs that are run many times with
+   * the same elements can therefore save a considerable amount of time.
+   *
+   * Files are named after FiniteElement::get_name() and additionally store
+   * the values of the shape functions at one point, so that a file is not
+   * used for a different element that happens to have the same name. Files
+   * are written under a temporary name and then renamed, so that several
+   * threads or processes may safely use the same directory. Failure to read
+   * or write a file is silently ignored and the matrices are then simply
+   * computed. The directory must exist.
+   *
+   * Passing an empty string, which is the default, disables the cache.
+   */
+  void set_matrix_cache_directory (const std::string &directory);
+
   /**
    * Projects scalar data defined in quadrature points to a finite element
    * space on a single cell.
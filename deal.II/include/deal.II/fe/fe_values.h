@@ -1155,14 +1155,18 @@ public:
 
   /**
    * Storage type for gradients. The layout of data is the same as for the
-   * #ShapeVector data type.
+   * #ShapeVector data type. In particular, the gradients of all shape
+   * functions at all quadrature points are stored in one contiguous block of
+   * memory, with the quadrature points running fastest, so that loops over
+   * the quadrature points of one shape function access consecutive memory
+   * locations.
    */
-  typedef std::vector<std::vector<Tensor<1,spacedim> > > GradientVector;
+  typedef Table<2,Tensor<1,spacedim> > GradientVector;
 
   /**
    * Likewise for second order derivatives.
    */
-  typedef std::vector<std::vector<Tensor<2,spacedim> > > HessianVector;
+  typedef Table<2,Tensor<2,spacedim> > HessianVector;
 
   /**
    * Store the values of the shape functions at the quadrature points. See the
@@ -1456,6 +1460,11 @@ public:
    *
    * @param point_no Number of the quadrature point at which function is to be
    * evaluated
+   *
+   * The values of one shape function at all quadrature points are stored
+   * contiguously in memory, i.e., <tt>&shape_value(i,0)+q</tt> equals
+   * <tt>&shape_value(i,q)</tt>. Inner loops over quadrature points can
+   * therefore take the address of the first value and increment it.
    */
   const double &shape_value (const unsigned int function_no,
                              const unsigned int point_no) const;
@@ -1497,8 +1506,9 @@ public:
    * type ExcShapeFunctionNotPrimitive. In that case, use the
    * shape_grad_component() function.
    *
-   * The same holds for the arguments of this function as for the
-   * shape_value() function.
+   * The same holds for the arguments of this function, and for the layout of
+   * the gradients of one shape function in memory, as for the shape_value()
+   * function.
    */
   const Tensor<1,spacedim> &
   shape_grad (const unsigned int function_no,
@@ -1537,7 +1547,8 @@ public:
    * ExcShapeFunctionNotPrimitive. In that case, use the
    * shape_grad_grad_component() function.
    *
-   * The same holds for the arguments of this function as for the
+   * The same holds for the arguments of this function, and for the layout of
+   * the second derivatives of one shape function in memory, as for the
    * shape_value() function.
    */
   const Tensor<2,spacedim> &
@@ -1715,6 +1726,39 @@ public:
                             VectorSlice<std::vector<std::vector<double> > > values,
                             const bool quadrature_points_fastest) const;
 
+  /**
+   * Compute the values of a finite element function at the quadrature points
+   * from the values of its degrees of freedom on the current cell, as
+   * returned for instance by DoFCellAccessor::get_dof_values() or
+   * DoFCellAccessor::get_interpolated_dof_values().
+   *
+   * The other get_function_values() functions first collect these values
+   * from the global vector and then do the same. If the values of a
+   * function are needed several times on the same cell, for instance
+   * because both its values and its gradients are needed, or on several
+   * FEValues or FEFaceValues objects for the same cell, the values of the
+   * degrees of freedom can thus be collected only once and then passed to
+   * this function and to get_function_gradients_from_local_dof_values().
+   *
+   * This function may only be used if the finite element in use is a scalar
+   * one. The size of <tt>local_dof_values</tt> must equal the number of
+   * degrees of freedom per cell, and <tt>values</tt> must have the size of
+   * the quadrature formula.
+   */
+  template <typename number>
+  void get_function_values_from_local_dof_values (const Vector<double> &local_dof_values,
+                                                  std::vector<number>  &values) const;
+
+  /**
+   * This function does the same as the previous one, but applied to
+   * multi-component (vector-valued) elements. The layout of
+   * <tt>values</tt> is the same as for the corresponding
+   * get_function_values() function.
+   */
+  template <typename number>
+  void get_function_values_from_local_dof_values (const Vector<double>         &local_dof_values,
+                                                  std::vector<Vector<number> > &values) const;
+
   //@}
   /// @name Access to derivatives of global finite element fields
   //@{
@@ -1792,6 +1836,22 @@ public:
                                VectorSlice<std::vector<std::vector<Tensor<1,spacedim> > > > gradients,
                                bool quadrature_points_fastest = false) const;
 
+  /**
+   * Compute the gradients of a scalar finite element function from the
+   * values of its degrees of freedom on the current cell. See
+   * get_function_values_from_local_dof_values() for more information.
+   */
+  void get_function_gradients_from_local_dof_values (const Vector<double>             &local_dof_values,
+                                                     std::vector<Tensor<1,spacedim> > &gradients) const;
+
+  /**
+   * Compute the gradients of a vector-valued finite element function from
+   * the values of its degrees of freedom on the current cell. See
+   * get_function_values_from_local_dof_values() for more information.
+   */
+  void get_function_gradients_from_local_dof_values (const Vector<double>                           &local_dof_values,
+                                                     std::vector<std::vector<Tensor<1,spacedim> > > &gradients) const;
+
   /**
    * @deprecated Use get_function_gradients() instead.
    */
@@ -3712,10 +3772,10 @@ FEValuesBase<dim,spacedim>::shape_grad (const unsigned int i,
           ExcAccessToUninitializedField("update_gradients"));
   Assert (fe->is_primitive (i),
           ExcShapeFunctionNotPrimitive(i));
-  Assert (i<this->shape_gradients.size(),
-          ExcIndexRange (i, 0, this->shape_gradients.size()));
-  Assert (j<this->shape_gradients[0].size(),
-          ExcIndexRange (j, 0, this->shape_gradients[0].size()));
+  Assert (i<this->shape_gradients.n_rows(),
+          ExcIndexRange (i, 0, this->shape_gradients.n_rows()));
+  Assert (j<this->shape_gradients.n_cols(),
+          ExcIndexRange (j, 0, this->shape_gradients.n_cols()));
 
   // if the entire FE is primitive,
   // then we can take a short-cut:
@@ -3781,10 +3841,10 @@ FEValuesBase<dim,spacedim>::shape_hessian (const unsigned int i,
           ExcAccessToUninitializedField("update_hessians"));
   Assert (fe->is_primitive (i),
           ExcShapeFunctionNotPrimitive(i));
-  Assert (i<this->shape_hessians.size(),
-          ExcIndexRange (i, 0, this->shape_hessians.size()));
-  Assert (j<this->shape_hessians[0].size(),
-          ExcIndexRange (j, 0, this->shape_hessians[0].size()));
+  Assert (i<this->shape_hessians.n_rows(),
+          ExcIndexRange (i, 0, this->shape_hessians.n_rows()));
+  Assert (j<this->shape_hessians.n_cols(),
+          ExcIndexRange (j, 0, this->shape_hessians.n_cols()));
 
   // if the entire FE is primitive,
   // then we can take a short-cut:
@@ -0,0 +1,430 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef __deal2__fe_values_tensor_product_h
+#define __deal2__fe_values_tensor_product_h
+
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/types.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/fe/fe.h>
+#include <deal.II/matrix_free/shape_info.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A class that evaluates finite element functions and integrates against
+ * the shape functions on a cell in the same way as FEValues, but using sum
+ * factorization instead of tables of the values and gradients of all shape
+ * functions at all quadrature points.
+ *
+ * FEValues computes and stores the values and gradients of all shape
+ * functions at all quadrature points. For an element of degree <i>p</i> in
+ * <i>d</i> space dimensions and a quadrature formula with <i>p+1</i> points
+ * per direction, these tables have <i>(p+1)<sup>2d</sup></i> entries, and
+ * evaluating a finite element function or a right hand side vector with
+ * them costs the same number of operations per cell. For elements that are
+ * tensor products of one-dimensional polynomials and quadrature formulas
+ * that are tensor products of a one-dimensional formula, the same results
+ * can be computed by successive one-dimensional operations along the
+ * coordinate directions at a cost of <i>O(d (p+1)<sup>d+1</sup>)</i> per
+ * cell, using only the values and derivatives of the one-dimensional shape
+ * functions at the one-dimensional quadrature points. This is the technique
+ * used by FEEvaluation for matrix-free operator evaluation; this class uses
+ * the same one-dimensional data (internal::MatrixFreeFunctions::ShapeInfo),
+ * but with an interface close to the one of FEValues, so that existing
+ * assembly loops can be switched over one at a time:
+ * @code
+ *   FEValuesTensorProduct<dim> fe_values (fe, QGauss<1>(fe.degree+1));
+ *   std::vector<double>         values (fe_values.n_quadrature_points);
+ *   std::vector<Tensor<1,dim> > gradients (fe_values.n_quadrature_points);
+ *   Vector<double>              cell_residual (fe.dofs_per_cell);
+ *
+ *   for (cell=dof_handler.begin_active(); cell!=dof_handler.end(); ++cell)
+ *     {
+ *       fe_values.reinit (cell);
+ *       fe_values.get_function_values (solution, values);
+ *       fe_values.get_function_gradients (solution, gradients);
+ *       for (unsigned int q=0; q<fe_values.n_quadrature_points; ++q)
+ *         {
+ *           values[q] = f(values[q]);
+ *           gradients[q] *= g(values[q]);
+ *         }
+ *       cell_residual = 0;
+ *       fe_values.integrate (values, gradients, cell_residual);
+ *       cell->distribute_local_to_global (cell_residual, residual);
+ *     }
+ * @endcode
+ *
+ * The values of individual shape functions, and therefore cell matrices,
+ * are not available from this class; for these, FEValues has to be used.
+ *
+ * The class supports scalar elements whose shape functions are tensor
+ * products of one-dimensional polynomials, i.e., FE_Q, FE_DGQ,
+ * FE_DGQArbitraryNodes and FE_Q_Hierarchical. The cells must be affine
+ * images of the reference cell, i.e., parallelograms or parallelepipeds
+ * (which includes the rectangular cells for which MappingCartesian would be
+ * used), for which the Jacobian of the mapping is constant on each cell.
+ * The geometry of the cell is computed from its vertices, so the results
+ * are the same as the ones of FEValues with MappingQ1 or MappingCartesian.
+ * The quadrature points are enumerated as in the
+ * <tt>Quadrature<dim>(quadrature_1d)</tt> tensor product formula, i.e., in
+ * the same order as in QGauss<dim> if a QGauss<1> formula is given.
+ *
+ * @ingroup feaccess
+ */
+template <int dim>
+class FEValuesTensorProduct : public Subscriptor
+{
+public:
+  /**
+   * Number of shape functions per cell.
+   */
+  const unsigned int dofs_per_cell;
+
+  /**
+   * Number of quadrature points of the tensor product quadrature formula.
+   */
+  const unsigned int n_quadrature_points;
+
+  /**
+   * Constructor. Set up the one-dimensional data for the given finite
+   * element and the tensor product of the given one-dimensional quadrature
+   * formula.
+   */
+  FEValuesTensorProduct (const FiniteElement<dim> &fe,
+                         const Quadrature<1>      &quadrature_1d);
+
+  /**
+   * Reinitialize the geometric data for the given cell. Functions that
+   * need the values of a finite element function on the cell can not be
+   * used after this function, only those that take the values of the
+   * degrees of freedom as arguments.
+   */
+  void reinit (const typename Triangulation<dim>::cell_iterator &cell);
+
+  /**
+   * Reinitialize the geometric data for the given cell and store the
+   * indices of its degrees of freedom. The finite element of the
+   * DoFHandler must be the one given to the constructor.
+   */
+  template <class DH, bool level_dof_access>
+  void reinit (const TriaIterator<DoFCellAccessor<DH,level_dof_access> > &cell);
+
+  /**
+   * Return the values of the finite element function characterized by
+   * <tt>fe_function</tt> at the quadrature points of the cell last
+   * passed to reinit(). The size of <tt>values</tt> must equal
+   * n_quadrature_points.
+   */
+  template <class InputVector>
+  void get_function_values (const InputVector   &fe_function,
+                            std::vector<double> &values) const;
+
+  /**
+   * Return the gradients of the finite element function characterized by
+   * <tt>fe_function</tt> at the quadrature points, in the same way as the
+   * previous function.
+   */
+  template <class InputVector>
+  void get_function_gradients (const InputVector           &fe_function,
+                               std::vector<Tensor<1,dim> > &gradients) const;
+
+  /**
+   * Compute the values of a finite element function at the quadrature
+   * points from the values of its degrees of freedom on the current cell,
+   * as returned for instance by DoFCellAccessor::get_dof_values(). This is
+   * what get_function_values() does after collecting these values.
+   */
+  void get_function_values_from_local_dof_values (const Vector<double> &local_dof_values,
+                                                  std::vector<double>  &values) const;
+
+  /**
+   * Compute the gradients of a finite element function at the quadrature
+   * points from the values of its degrees of freedom on the current cell.
+   */
+  void get_function_gradients_from_local_dof_values (const Vector<double>        &local_dof_values,
+                                                     std::vector<Tensor<1,dim> > &gradients) const;
+
+  /**
+   * Add
+   * \f[
+   * r_i \mathrel{+}= \sum_q \left(v_q \varphi_i(x_q) + g_q \cdot \nabla
+   * \varphi_i(x_q)\right) JxW_q
+   * \f]
+   * to <tt>cell_vector</tt>, where <i>v<sub>q</sub></i> and
+   * <i>g<sub>q</sub></i> are the entries of <tt>values</tt> and
+   * <tt>gradients</tt>. Note that the factors <i>JxW<sub>q</sub></i> are
+   * applied by this function and must not be contained in the arguments.
+   * Either of the two arguments may be an empty vector, in which case the
+   * respective term is omitted; otherwise its size must equal
+   * n_quadrature_points.
+   */
+  void integrate (const std::vector<double>         &values,
+                  const std::vector<Tensor<1,dim> > &gradients,
+                  Vector<double>                    &cell_vector) const;
+
+  /**
+   * Position of the <tt>q</tt>th quadrature point in real space.
+   */
+  const Point<dim> &quadrature_point (const unsigned int q) const;
+
+  /**
+   * Return the positions of all quadrature points in real space.
+   */
+  const std::vector<Point<dim> > &get_quadrature_points () const;
+
+  /**
+   * Mapped quadrature weight of the <tt>q</tt>th quadrature point.
+   */
+  double JxW (const unsigned int q) const;
+
+  /**
+   * Return the mapped quadrature weights of all quadrature points.
+   */
+  const std::vector<double> &get_JxW_values () const;
+
+  /**
+   * Return the inverse of the Jacobian of the mapping from the reference
+   * cell to the current cell, which is the same at all points of the cell.
+   */
+  const Tensor<2,dim> &inverse_jacobian () const;
+
+  /**
+   * Return a reference to the finite element.
+   */
+  const FiniteElement<dim> &get_fe () const;
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of this
+   * object.
+   */
+  std::size_t memory_consumption () const;
+
+  /**
+   * Exception
+   */
+  DeclException0 (ExcFENotTensorProduct);
+  /**
+   * Exception thrown by reinit() if the cell is not an affine image of the
+   * reference cell.
+   */
+  DeclException0 (ExcCellNotAffine);
+  /**
+   * Exception
+   */
+  DeclException0 (ExcNoDoFIndices);
+
+private:
+  /**
+   * Apply the one-dimensional shape data <tt>shape_data[d]</tt> in each
+   * direction <i>d</i> to the lexicographically ordered array <tt>in</tt>,
+   * interpolating from degrees of freedom to quadrature points if
+   * <tt>dof_to_quad</tt> is true and integrating in the opposite direction
+   * otherwise. If <tt>add</tt> is true, the result is added to
+   * <tt>out</tt>.
+   */
+  template <bool dof_to_quad, bool add>
+  void apply_tensor_product (const double *const shape_data[dim],
+                             const double       *in,
+                             double             *out) const;
+
+  /**
+   * Copy the values of the degrees of freedom into lexicographic order.
+   */
+  void read_local_dof_values (const Vector<double> &local_dof_values) const;
+
+  /**
+   * Pointer to the finite element.
+   */
+  const SmartPointer<const FiniteElement<dim>,FEValuesTensorProduct<dim> > fe;
+
+  /**
+   * The values and derivatives of the one-dimensional shape functions at
+   * the one-dimensional quadrature points, and the renumbering of the
+   * degrees of freedom into lexicographic order.
+   */
+  internal::MatrixFreeFunctions::ShapeInfo<double> shape_info;
+
+  /**
+   * Number of shape functions and quadrature points in each direction.
+   */
+  const unsigned int n_dofs_1d;
+  const unsigned int n_q_points_1d;
+
+  /**
+   * The tensor product quadrature formula on the reference cell.
+   */
+  const Quadrature<dim> quadrature;
+
+  /**
+   * Inverse of the Jacobian of the present cell.
+   */
+  Tensor<2,dim> present_inverse_jacobian;
+
+  /**
+   * Quadrature points and mapped weights on the present cell.
+   */
+  std::vector<Point<dim> > quadrature_points;
+  std::vector<double>      JxW_values;
+
+  /**
+   * Global indices of the degrees of freedom on the present cell, or an
+   * empty vector if reinit() was called with a cell without degrees of
+   * freedom.
+   */
+  std::vector<types::global_dof_index> dof_indices;
+
+  /**
+   * Scratch arrays for the values of the degrees of freedom in
+   * lexicographic order and for intermediate results.
+   */
+  mutable std::vector<double> lexicographic_values;
+  mutable std::vector<double> scratch;
+};
+
+
+/*------------------------ Inline functions -----------------------------*/
+
+#ifndef DOXYGEN
+
+template <int dim>
+template <class DH, bool level_dof_access>
+inline
+void
+FEValuesTensorProduct<dim>::reinit (const TriaIterator<DoFCellAccessor<DH,level_dof_access> > &cell)
+{
+  Assert (static_cast<const FiniteElementData<dim>&>(*fe) ==
+          static_cast<const FiniteElementData<dim>&>(cell->get_fe()),
+          ExcMessage ("The finite element of the cell does not match the one "
+                      "of this object."));
+  reinit (typename Triangulation<dim>::cell_iterator (cell));
+  dof_indices.resize (dofs_per_cell);
+  cell->get_dof_indices (dof_indices);
+}
+
+
+
+template <int dim>
+template <class InputVector>
+inline
+void
+FEValuesTensorProduct<dim>::get_function_values (const InputVector   &fe_function,
+                                                 std::vector<double> &values) const
+{
+  Assert (dof_indices.size() == dofs_per_cell, ExcNoDoFIndices());
+  Vector<double> local_dof_values (dofs_per_cell);
+  fe_function.extract_subvector_to (dof_indices.begin(), dof_indices.end(),
+                                    local_dof_values.begin());
+  get_function_values_from_local_dof_values (local_dof_values, values);
+}
+
+
+
+template <int dim>
+template <class InputVector>
+inline
+void
+FEValuesTensorProduct<dim>::get_function_gradients (const InputVector           &fe_function,
+                                                    std::vector<Tensor<1,dim> > &gradients) const
+{
+  Assert (dof_indices.size() == dofs_per_cell, ExcNoDoFIndices());
+  Vector<double> local_dof_values (dofs_per_cell);
+  fe_function.extract_subvector_to (dof_indices.begin(), dof_indices.end(),
+                                    local_dof_values.begin());
+  get_function_gradients_from_local_dof_values (local_dof_values, gradients);
+}
+
+
+
+template <int dim>
+inline
+const Point<dim> &
+FEValuesTensorProduct<dim>::quadrature_point (const unsigned int q) const
+{
+  AssertIndexRange (q, quadrature_points.size());
+  return quadrature_points[q];
+}
+
+
+
+template <int dim>
+inline
+const std::vector<Point<dim> > &
+FEValuesTensorProduct<dim>::get_quadrature_points () const
+{
+  return quadrature_points;
+}
+
+
+
+template <int dim>
+inline
+double
+FEValuesTensorProduct<dim>::JxW (const unsigned int q) const
+{
+  AssertIndexRange (q, JxW_values.size());
+  return JxW_values[q];
+}
+
+
+
+template <int dim>
+inline
+const std::vector<double> &
+FEValuesTensorProduct<dim>::get_JxW_values () const
+{
+  return JxW_values;
+}
+
+
+
+template <int dim>
+inline
+const Tensor<2,dim> &
+FEValuesTensorProduct<dim>::inverse_jacobian () const
+{
+  return present_inverse_jacobian;
+}
+
+
+
+template <int dim>
+inline
+const FiniteElement<dim> &
+FEValuesTensorProduct<dim>::get_fe () const
+{
+  return *fe;
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
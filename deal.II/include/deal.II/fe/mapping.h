@@ -286,6 +286,36 @@ public:
     const typename Triangulation<dim,spacedim>::cell_iterator &cell,
     const Point<spacedim>                            &p) const = 0;
 
+  /**
+   * Transform all of the points in @p real_points on the real cell
+   * @p cell to the unit cell and store the results in @p unit_points,
+   * which is resized as necessary. The result is the same as if
+   * transform_real_to_unit_cell() were called for each of the points,
+   * but derived classes can do so considerably faster by computing
+   * everything that only depends on the cell (such as the support
+   * points of the mapping) only once. (For points outside the cell, for
+   * which the Newton iteration of transform_real_to_unit_cell() may
+   * fail, the implementations in derived classes sometimes succeed in
+   * finding a solution nevertheless.)
+   *
+   * Unlike transform_real_to_unit_cell(), this function does not throw
+   * an exception if the transformation fails for some of the points,
+   * since the remaining points may well be transformed
+   * successfully. Rather, the first coordinate of the corresponding
+   * element of @p unit_points is set to
+   * <tt>std::numeric_limits<double>::infinity()</tt>, so that the
+   * point is certainly not inside the unit cell as determined by
+   * GeometryInfo::is_inside_unit_cell().
+   *
+   * The implementation in this class simply calls
+   * transform_real_to_unit_cell() for each point.
+   */
+  virtual void
+  transform_points_real_to_unit_cell (
+    const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+    const std::vector<Point<spacedim> >                       &real_points,
+    std::vector<Point<dim> >                                  &unit_points) const;
+
   /**
    * Base class for internal data
    * of finite element and mapping
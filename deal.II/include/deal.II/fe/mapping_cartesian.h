@@ -135,6 +135,17 @@ public:
     const typename Triangulation<dim,spacedim>::cell_iterator &cell,
     const Point<spacedim>                            &p) const;
 
+  /**
+   * Transform many points on the real cell @p cell to the unit cell at
+   * once. The extents of the cell are computed only once for all
+   * points.
+   */
+  virtual void
+  transform_points_real_to_unit_cell (
+    const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+    const std::vector<Point<spacedim> >                       &real_points,
+    std::vector<Point<dim> >                                  &unit_points) const;
+
 
   /**
    * Return a pointer to a copy of the
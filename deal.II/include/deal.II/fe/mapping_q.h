@@ -119,6 +119,24 @@ public:
     const typename Triangulation<dim,spacedim>::cell_iterator &cell,
     const Point<spacedim>                            &p) const;
 
+  /**
+   * Transform many points on the real cell @p cell to the unit cell at
+   * once. See the documentation of the base class for the meaning of
+   * the arguments and the treatment of points for which the
+   * transformation fails.
+   *
+   * As in transform_real_to_unit_cell(), the points are first
+   * transformed with the Q1 mapping, for which the function of the base
+   * class MappingQ1 is used. If the full mapping has to be used on this
+   * cell, the support points of the mapping are then computed only once
+   * for all points.
+   */
+  virtual void
+  transform_points_real_to_unit_cell (
+    const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+    const std::vector<Point<spacedim> >                       &real_points,
+    std::vector<Point<dim> >                                  &unit_points) const;
+
   virtual void
   transform (const VectorSlice<const std::vector<Tensor<1,dim> > > input,
              VectorSlice<std::vector<Tensor<1,spacedim> > > output,
@@ -114,6 +114,28 @@ public:
     const typename Triangulation<dim,spacedim>::cell_iterator &cell,
     const Point<spacedim>                            &p) const;
 
+  /**
+   * Transform many points on the real cell @p cell to the unit cell at
+   * once. See the documentation of the base class for the meaning of
+   * the arguments and the treatment of points for which the
+   * transformation fails.
+   *
+   * The support points of the mapping and the affine approximation of
+   * the cell that serves as initial guess are computed only once for
+   * all points. If the cell is a parallelogram or parallelepiped, this
+   * affine approximation is exact and no Newton iteration is
+   * necessary. Otherwise, if <tt>dim==spacedim</tt>, the Newton
+   * iterations for several points are run simultaneously on the lanes
+   * of a VectorizedArray. Points for which these iterations do not
+   * make progress with full Newton steps are handed over to the
+   * iteration with line search used by transform_real_to_unit_cell().
+   */
+  virtual void
+  transform_points_real_to_unit_cell (
+    const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+    const std::vector<Point<spacedim> >                       &real_points,
+    std::vector<Point<dim> >                                  &unit_points) const;
+
   virtual void
   transform (const VectorSlice<const std::vector<Tensor<1,dim> > > input,
              VectorSlice<std::vector<Tensor<1,spacedim> > > output,
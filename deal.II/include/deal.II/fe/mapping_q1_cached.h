@@ -0,0 +1,262 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef __deal2__mapping_q1_cached_h
+#define __deal2__mapping_q1_cached_h
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/std_cxx1x/shared_ptr.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <boost/signals2.hpp>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+/*!@addtogroup mapping */
+/*@{*/
+
+/**
+ * A d-linear mapping like MappingQ1 that stores the geometric data it
+ * computes on each cell, i.e. the quadrature points, Jacobians, their
+ * inverses, the JxW values and so on, and returns the stored data
+ * whenever an FEValues object is re-initialized on a cell it has seen
+ * before with the same quadrature formula. This pays off if the same
+ * cells are visited many times, for example when several operators are
+ * assembled on the same mesh, in the iterations of a nonlinear solver,
+ * and when evaluating error estimators, since then the mapping only
+ * needs to compute anything the first time around.
+ *
+ * The stored data is shared between all FEValues objects that use this
+ * mapping with the same quadrature formula and the same update flags,
+ * regardless of whether they are created for the same finite element.
+ * FEFaceValues and FESubfaceValues objects are not affected by this
+ * class: they compute their data on every call just like with
+ * MappingQ1.
+ *
+ * <h3>Invalidating the stored data</h3>
+ *
+ * When an FEValues object is re-initialized on a cell, the vertices of
+ * the cell are compared with the ones for which the stored data was
+ * computed, and the data is re-computed if they differ. Consequently,
+ * moving vertices of the triangulation is safe. Furthermore, all stored
+ * data is discarded whenever the triangulation is refined, coarsened,
+ * re-created or cleared; this object is notified of such changes
+ * through the signals of the triangulation. You may also discard the
+ * data at any time by calling clear().
+ *
+ * The stored data is associated with one triangulation, the one on
+ * whose cells FEValues objects using this mapping were last
+ * re-initialized. Using the same object alternately on cells of
+ * different triangulations is therefore possible, but inefficient.
+ *
+ * <h3>Memory consumption</h3>
+ *
+ * The memory required by this class is proportional to the number of
+ * cells times the number of quadrature points, times the number of
+ * different combinations of quadrature formulas and update flags the
+ * mapping is used with. You can query it using memory_consumption().
+ *
+ * FEValues objects using this mapping may be used on several threads
+ * concurrently.
+ */
+template <int dim, int spacedim=dim>
+class MappingQ1Cached : public MappingQ1<dim,spacedim>
+{
+public:
+  /**
+   * Constructor.
+   */
+  MappingQ1Cached ();
+
+  /**
+   * Copy constructor. The new object starts out without any stored
+   * data.
+   */
+  MappingQ1Cached (const MappingQ1Cached<dim,spacedim> &mapping);
+
+  /**
+   * Destructor.
+   */
+  virtual ~MappingQ1Cached ();
+
+  /**
+   * Return a pointer to a copy of the present object. The caller of this
+   * copy then assumes ownership of it.
+   */
+  virtual
+  Mapping<dim,spacedim> *clone () const;
+
+  /**
+   * Discard all stored data. This function is called automatically
+   * whenever the triangulation changes.
+   */
+  void clear ();
+
+  /**
+   * Return an estimate (in bytes) of the memory consumption of this
+   * object, including the stored data.
+   */
+  std::size_t memory_consumption () const;
+
+  /**
+   * Implementation of the interface in Mapping. Return the stored data
+   * for the given cell if it exists, and compute and store it with the
+   * function of the base class otherwise.
+   */
+  virtual void
+  fill_fe_values (const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+                  const Quadrature<dim>                                     &quadrature,
+                  typename Mapping<dim,spacedim>::InternalDataBase          &mapping_data,
+                  typename std::vector<Point<spacedim> >                    &quadrature_points,
+                  std::vector<double>                                       &JxW_values,
+                  std::vector<DerivativeForm<1,dim,spacedim> >              &jacobians,
+                  std::vector<DerivativeForm<2,dim,spacedim> >              &jacobian_grads,
+                  std::vector<DerivativeForm<1,spacedim,dim> >              &inverse_jacobians,
+                  std::vector<Point<spacedim> >                             &cell_normal_vectors,
+                  CellSimilarity::Similarity                                &cell_similarity) const;
+
+private:
+  /**
+   * Internal data of this mapping. In addition to what the base class
+   * stores, it knows where the data for the quadrature formula and update
+   * flags it was created for is stored.
+   */
+  class InternalData : public MappingQ1<dim,spacedim>::InternalData
+  {
+  public:
+    /**
+     * Constructor.
+     */
+    InternalData (const unsigned int n_shape_functions);
+
+    /**
+     * Index into MappingQ1Cached::caches.
+     */
+    unsigned int cache_index;
+  };
+
+  /**
+   * The data stored for one cell.
+   */
+  struct CellData
+  {
+    /**
+     * The vertices of the cell at the time the data was computed. An
+     * empty vector indicates that no data has been computed yet.
+     */
+    std::vector<Point<spacedim> > vertices;
+
+    /**
+     * The data computed by MappingQ1::fill_fe_values() for this cell,
+     * both that returned to the caller and that stored in the
+     * InternalData object for later use by the transform() functions.
+     * Only the fields that correspond to the update flags of the cache
+     * are filled.
+     */
+    std::vector<Point<spacedim> >                quadrature_points;
+    std::vector<double>                          JxW_values;
+    std::vector<DerivativeForm<1,dim,spacedim> > jacobians;
+    std::vector<DerivativeForm<2,dim,spacedim> > jacobian_grads;
+    std::vector<DerivativeForm<1,spacedim,dim> > inverse_jacobians;
+    std::vector<Point<spacedim> >                normal_vectors;
+    std::vector<DerivativeForm<1,dim,spacedim> > covariant;
+    std::vector<DerivativeForm<1,dim,spacedim> > contravariant;
+    std::vector<double>                          volume_elements;
+  };
+
+  /**
+   * The data stored for one combination of quadrature formula and update
+   * flags.
+   */
+  struct Cache
+  {
+    /**
+     * Constructor.
+     */
+    Cache (const Quadrature<dim> &quadrature,
+           const UpdateFlags      update_flags);
+
+    /**
+     * The quadrature formula.
+     */
+    const Quadrature<dim> quadrature;
+
+    /**
+     * The flags that need to be updated on each cell.
+     */
+    const UpdateFlags update_flags;
+
+    /**
+     * The data for each cell, indexed by the level and index of the
+     * cell.
+     */
+    std::vector<std::vector<CellData> > cells;
+  };
+
+  /**
+   * Implementation of the interface in Mapping. In addition to what the
+   * base class does, find or create the cache for the given quadrature
+   * formula and update flags.
+   */
+  virtual
+  typename Mapping<dim,spacedim>::InternalDataBase *
+  get_data (const UpdateFlags,
+            const Quadrature<dim> &quadrature) const;
+
+  /**
+   * Return the stored data for the given cell in the cache with the given
+   * index, after making sure that the cache is associated with the
+   * triangulation of the cell and has space for the cell. Must be called
+   * with #mutex acquired.
+   */
+  CellData &
+  get_cell_data (const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+                 const unsigned int                                         cache_index) const;
+
+  /**
+   * The caches for all combinations of quadrature formulas and update
+   * flags this mapping has been used with so far. Only the data for the
+   * cells is discarded when the triangulation changes.
+   */
+  mutable std::vector<std_cxx1x::shared_ptr<Cache> > caches;
+
+  /**
+   * The triangulation with which the stored data is associated.
+   */
+  mutable const Triangulation<dim,spacedim> *triangulation;
+
+  /**
+   * The connection to the signal of the triangulation that notifies us
+   * of changes.
+   */
+  mutable boost::signals2::connection tria_listener;
+
+  /**
+   * A mutex that guards all accesses to the stored data.
+   */
+  mutable Threads::Mutex mutex;
+};
+
+/*@}*/
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
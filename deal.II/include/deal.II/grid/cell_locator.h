@@ -0,0 +1,313 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef __deal2__cell_locator_h
+#define __deal2__cell_locator_h
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/fe/mapping.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/grid/tria.h>
+
+#include <boost/signals2.hpp>
+
+#include <vector>
+#include <utility>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A class that finds the active cell of a mesh in which a given point
+ * lies, and the coordinates of the point on the reference cell. It
+ * provides the same functionality as
+ * GridTools::find_active_cell_around_point(), but whereas that function
+ * needs to look at all vertices of the mesh for every point, this class
+ * builds a hierarchy of bounding boxes around the active cells once,
+ * after which each point can be located in a time that grows only
+ * logarithmically with the number of cells. It is therefore the method
+ * of choice if many points need to be located on the same mesh.
+ *
+ * Like InterGridMap, this class is templatized on the type of the
+ * container of cells, which may be Triangulation, DoFHandler or
+ * hp::DoFHandler, and the iterators it returns are iterators into that
+ * container:
+ * @code
+ *   CellLocator<DoFHandler<dim> > cell_locator (dof_handler, mapping);
+ *   ...
+ *   std::pair<typename DoFHandler<dim>::active_cell_iterator, Point<dim> >
+ *   cell_and_point = cell_locator.find_active_cell_around_point (p);
+ * @endcode
+ *
+ * Besides the hierarchy of bounding boxes, the class also stores for
+ * each vertex the list of active cells that have this vertex as one of
+ * their vertices. This map is used when a point has been found close to
+ * but not inside a set of cells, which can happen for mappings that
+ * curve the cells, and is also made available through
+ * cells_adjacent_to_vertex().
+ *
+ * <h3>Building and invalidating the index</h3>
+ *
+ * The bounding box hierarchy is built the first time a point is
+ * searched for, and it is discarded whenever the triangulation is
+ * changed, i.e. when it is refined or coarsened, or re-created. It is
+ * then re-built the next time it is needed. Moving vertices of the
+ * triangulation does not trigger a notification from the
+ * triangulation, so in that case you need to call clear() yourself.
+ *
+ * The functions that locate points may be called from several threads
+ * concurrently. Furthermore, find_active_cells_around_points() locates
+ * all the points given to it in parallel.
+ *
+ * <h3>Bounding boxes and curved cells</h3>
+ *
+ * The bounding box of each cell is computed from its vertices. This is
+ * exact for the MappingQ1 mapping, but cells may extend beyond the box
+ * of their vertices for other mappings. The search therefore also
+ * considers all cells that share a vertex with the candidate cells
+ * found through the bounding boxes, and finally falls back to
+ * GridTools::find_active_cell_around_point() if this did not yield a
+ * cell either.
+ *
+ * @ingroup grid
+ */
+template <class Container>
+class CellLocator : public Subscriptor
+{
+public:
+  /**
+   * Dimension of the cells of the container.
+   */
+  static const unsigned int dimension = Container::dimension;
+
+  /**
+   * Dimension of the space in which the mesh lives.
+   */
+  static const unsigned int space_dimension = Container::space_dimension;
+
+  /**
+   * Typedef to the iterator type of the active cells of the container
+   * under consideration.
+   */
+  typedef typename Container::active_cell_iterator active_cell_iterator;
+
+  /**
+   * Constructor. Store references to the container in which cells are
+   * to be found and the mapping with which points are transformed to
+   * the reference cell. The index itself is only built when it is
+   * first needed.
+   */
+  CellLocator (const Container                            &container,
+               const Mapping<dimension,space_dimension> &mapping
+               = StaticMappingQ1<dimension,space_dimension>::mapping);
+
+  /**
+   * Copy constructor. The new object refers to the same container and
+   * mapping, but builds its own index when it is first needed.
+   */
+  CellLocator (const CellLocator<Container> &cell_locator);
+
+  /**
+   * Destructor.
+   */
+  ~CellLocator ();
+
+  /**
+   * Find the active cell that surrounds the point @p p, and return it
+   * along with the coordinates of the point on the reference cell. The
+   * rules for choosing among several candidate cells and for points
+   * that lie slightly outside the mesh are the same as those of
+   * GridTools::find_active_cell_around_point(), and so are the
+   * remarks made in its documentation.
+   *
+   * If the point does not lie in any of the cells of the mesh, an
+   * exception of type GridTools::ExcPointNotFound is thrown.
+   */
+  std::pair<active_cell_iterator, Point<dimension> >
+  find_active_cell_around_point (const Point<space_dimension> &p) const;
+
+  /**
+   * Like the previous function, but locate all of the given points at
+   * once, using several threads. The results are returned in the
+   * second argument, which is resized as necessary. For points that
+   * do not lie in any of the cells of the mesh, no exception is
+   * thrown; rather, the iterator of the corresponding element of
+   * @p cells equals the end() iterator of the container.
+   */
+  void
+  find_active_cells_around_points (const std::vector<Point<space_dimension> > &points,
+                                   std::vector<std::pair<active_cell_iterator, Point<dimension> > > &cells) const;
+
+  /**
+   * Return all active cells that have the vertex with index @p vertex
+   * as one of their vertices. Unlike
+   * GridTools::find_cells_adjacent_to_vertex(), this does not include
+   * cells on which the vertex is a hanging node.
+   */
+  std::vector<active_cell_iterator>
+  cells_adjacent_to_vertex (const unsigned int vertex) const;
+
+  /**
+   * Return a reference to the container in which cells are located.
+   */
+  const Container &get_container () const;
+
+  /**
+   * Return a reference to the mapping with which points are transformed
+   * to the reference cell.
+   */
+  const Mapping<dimension,space_dimension> &get_mapping () const;
+
+  /**
+   * Discard the index. It is re-built the next time it is needed.
+   * This function is called automatically whenever the triangulation
+   * changes.
+   */
+  void clear ();
+
+  /**
+   * Determine an estimate for the memory consumption (in bytes) of
+   * this object.
+   */
+  std::size_t memory_consumption () const;
+
+private:
+  /**
+   * A node of the bounding box hierarchy. The node holds the cells
+   * <tt>sorted_cells[begin]</tt> to <tt>sorted_cells[end-1]</tt>. Inner
+   * nodes have two children, whose indices are stored in @p children;
+   * for leaves, these are numbers::invalid_unsigned_int.
+   */
+  struct Node
+  {
+    Point<space_dimension> lower_corner;
+    Point<space_dimension> upper_corner;
+    unsigned int           begin;
+    unsigned int           end;
+    unsigned int           children[2];
+  };
+
+  /**
+   * Build the index if it does not currently exist.
+   */
+  void build () const;
+
+  /**
+   * Build the node of the hierarchy that holds the cells
+   * <tt>sorted_cells[begin]</tt> to <tt>sorted_cells[end-1]</tt> as
+   * well as all nodes below it, and return its index.
+   */
+  unsigned int build_node (const unsigned int begin,
+                           const unsigned int end) const;
+
+  /**
+   * Locate a point, assuming that the index exists. Return an
+   * iterator equal to the end() iterator of the container if the
+   * point was not found.
+   */
+  std::pair<active_cell_iterator, Point<dimension> >
+  find_cell (const Point<space_dimension> &p) const;
+
+  /**
+   * Locate the points <tt>points[begin]</tt> to
+   * <tt>points[end-1]</tt>, assuming that the index exists.
+   */
+  void
+  find_cells (const unsigned int                                begin,
+              const unsigned int                                end,
+              const std::vector<Point<space_dimension> >       &points,
+              std::vector<std::pair<active_cell_iterator, Point<dimension> > > &cells) const;
+
+  /**
+   * Transform @p p to the reference coordinates of each of the cells
+   * with the given indices, and update @p best_cell, @p best_distance
+   * and @p best_level if one of them is a better match than what we
+   * have so far.
+   */
+  void
+  check_cells (const std::vector<unsigned int>                  &cell_indices,
+               const Point<space_dimension>                     &p,
+               std::pair<active_cell_iterator, Point<dimension> > &best_cell,
+               double                                           &best_distance,
+               int                                              &best_level) const;
+
+  /**
+   * The container in which we search.
+   */
+  SmartPointer<const Container,CellLocator<Container> > container;
+
+  /**
+   * The mapping with which points are transformed to the reference
+   * cell.
+   */
+  SmartPointer<const Mapping<dimension,space_dimension>,CellLocator<Container> > mapping;
+
+  /**
+   * The connection to the signal of the triangulation that notifies us
+   * of changes.
+   */
+  boost::signals2::connection tria_listener;
+
+  /**
+   * Whether the following arrays describe the current state of the
+   * triangulation.
+   */
+  mutable bool is_built;
+
+  /**
+   * All active cells of the container, in the order in which the
+   * container enumerates them.
+   */
+  mutable std::vector<active_cell_iterator> active_cells;
+
+  /**
+   * The indices into @p active_cells of the cells, sorted such that
+   * the cells of each node of the hierarchy are stored contiguously.
+   */
+  mutable std::vector<unsigned int> sorted_cells;
+
+  /**
+   * The bounding boxes of the active cells, as lower and upper
+   * corners. These boxes are slightly enlarged to be robust against
+   * round-off.
+   */
+  mutable std::vector<std::pair<Point<space_dimension>,Point<space_dimension> > > cell_boxes;
+
+  /**
+   * The nodes of the hierarchy. The root is the first element.
+   */
+  mutable std::vector<Node> nodes;
+
+  /**
+   * For each vertex, the indices into @p active_cells of the cells
+   * that have this vertex as one of their vertices.
+   */
+  mutable std::vector<std::vector<unsigned int> > vertex_to_cells;
+
+  /**
+   * A mutex that guards building and clearing the index.
+   */
+  mutable Threads::Mutex mutex;
+};
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
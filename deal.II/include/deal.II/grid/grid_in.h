@@ -39,7 +39,9 @@ struct SubCellData;
  * cell data), DB Mesh, XDA, Gmsh, Tecplot, NetCDF, UNV, VTK, and Cubit are supported as
  * input format for grid data. Any numerical data other than geometric
  * (vertex locations) and topological (how vertices form cells) information is
- * ignored.
+ * ignored. In addition, triangulations that have been written in deal.II's
+ * own binary format by GridOut::write_binary() can be read back including
+ * their refinement hierarchy.
  *
  * @note Since deal.II only supports line, quadrilateral and hexahedral meshes,
  * the functions in this class can only read meshes that consist exclusively
@@ -149,7 +151,10 @@ struct SubCellData;
  *
  * <li> <tt>Gmsh 2.0 mesh</tt> format: this is a variant of the above format.
  * The read_msh() function automatically determines whether an input file
- * is version 1 or version 2.
+ * is version 1 or version 2, and whether a version 2 file has been written
+ * in ASCII or in binary form (the latter is generated by Gmsh if
+ * "Mesh.Binary = 1" is given in the input file, or if the option
+ * <tt>-bin</tt> is passed on the command line).
  *
  * <li> <tt>Tecplot</tt> format: this format is used by @p TECPLOT and often
  * serves as a basis for data exchange between different applications. Note,
@@ -234,6 +239,13 @@ struct SubCellData;
  *
  * To build the program, see the <code>doc/readmes.html</code> and
  * <code>doc/development/cmake.html</code> files.
+ *
+ * <li> <tt>deal.II binary</tt> format: this is the format written by
+ * GridOut::write_binary(). Unlike all other formats above, it stores the
+ * complete triangulation including all refinement levels, and since it
+ * stores numbers as raw bytes and the coarse mesh in the form the
+ * Triangulation class uses internally, it is by far the fastest way to
+ * read a mesh. It is read by the read_binary() function.
  * </ul>
  *
  *
@@ -343,7 +355,9 @@ public:
     /// Use read_tecplot()
     tecplot,
     /// Use read_vtk()
-    vtk
+    vtk,
+    /// Use read_binary()
+    binary
   };
 
   /**
@@ -399,6 +413,11 @@ public:
   /**
    * Read grid data from an ucd file.
    * Numerical data is ignored.
+   *
+   * The function reads everything that is left in the stream into
+   * memory first. If the vertices and cells are given one per line,
+   * as is the case for all files generated by common tools, they are
+   * then split into chunks of lines that are parsed in parallel.
    */
   void read_ucd (std::istream &in);
 
@@ -431,6 +450,16 @@ public:
    * will be able to read files in
    * a slightly more general format
    * than Gmsh.
+   *
+   * Both ASCII and binary files of
+   * version 2 can be read; binary
+   * files need to have been written
+   * on a machine with the same byte
+   * order. Like read_ucd(), this
+   * function reads everything that
+   * is left in the stream and
+   * parses the nodes and elements
+   * of ASCII files in parallel.
    */
   void read_msh (std::istream &in);
 
@@ -454,6 +483,37 @@ public:
    */
   void read_tecplot (std::istream &in);
 
+  /**
+   * Read a triangulation that has previously been written by
+   * GridOut::write_binary(). See there for a description of the file
+   * format.
+   *
+   * Other than the remaining functions of this class, this function
+   * does not only read a coarse mesh but restores the complete
+   * triangulation including its refinement hierarchy, the material ids
+   * of all cells, the boundary indicators and the locations of all
+   * vertices. Since the coarse mesh has been written by the
+   * Triangulation class itself, it is already consistently oriented and
+   * is handed to Triangulation::create_triangulation() directly,
+   * without calling GridTools::delete_unused_vertices() or the
+   * GridReordering class. The refinement hierarchy is then re-created
+   * by refining, level by level, exactly those cells that were refined
+   * in the original triangulation.
+   *
+   * For this to reproduce the original mesh, the triangulation to be
+   * filled must not have a mesh smoothing flag that would refine
+   * additional cells compared to the one used when creating the
+   * original triangulation; Triangulation::none is always safe. If
+   * the original triangulation had curved boundary descriptions
+   * attached, these need not be attached to the new triangulation
+   * before calling this function since all vertex locations are read
+   * from the file, but they will of course be needed for further
+   * refinement.
+   *
+   * The stream @p in should have been opened in binary mode.
+   */
+  void read_binary (std::istream &in);
+
   /**
    * Returns the standard suffix
    * for a file in this format.
@@ -550,6 +610,14 @@ public:
 
 
   DeclException0 (ExcGmshNoCellInformation);
+
+  /**
+   * Exception
+   */
+  DeclException1 (ExcInvalidBinaryMeshInput,
+                  std::string,
+                  << "The input stream does not contain a valid deal.II "
+                  << "binary mesh: " << arg1);
 protected:
   /**
    * Store address of the triangulation to
@@ -863,7 +863,9 @@ public:
     /// write() calls write_svg()
     svg,
     /// write() calls write_mathgl()
-    mathgl
+    mathgl,
+    /// write() calls write_binary()
+    binary
   };
 
   /**
@@ -1109,6 +1111,51 @@ public:
   void write_mathgl (const Triangulation<dim> &tria,
                      std::ostream             &out) const;
 
+  /**
+   * Write the complete triangulation, including its refinement
+   * hierarchy, in a native binary format that can be read back with
+   * GridIn::read_binary().
+   *
+   * In contrast to the other output formats of this class, the file
+   * written by this function is not meant to be looked at or
+   * processed by other programs. Rather, its purpose is to store a
+   * triangulation in a way that allows to re-create it as quickly as
+   * possible: the coarse mesh is written in the vertex ordering and
+   * orientation the Triangulation class already uses internally, so
+   * the reader does not have to run the GridReordering class on it,
+   * and all numbers are written as raw bytes rather than as text.
+   *
+   * The file consists of a short text header identifying the format,
+   * the version and the dimensions, followed by the following binary
+   * blocks:
+   * <ol>
+   * <li> The vertices of the coarse mesh.
+   * <li> The vertex indices of the coarse cells.
+   * <li> The refinement cases of all cells, coarse or refined, in
+   *   depth-first order, i.e. each refined cell is followed by the
+   *   entries of its children.
+   * <li> The material ids of all cells in the same order.
+   * <li> The boundary indicators of all boundary faces of all cells
+   *   and, in 3d, of the lines bounding these faces.
+   * <li> The locations of all vertices of the final mesh, enumerated
+   *   in the order in which they are first encountered when walking
+   *   over the active cells in depth-first order. This way, vertices
+   *   that have been moved after refinement, for example by
+   *   GridTools::transform() or by a curved boundary description,
+   *   are restored exactly.
+   * </ol>
+   *
+   * Since the data is written in the byte order and with the type sizes
+   * of the machine this function runs on, the file can only be read on
+   * machines with the same binary representation of numbers. The
+   * reader checks this and throws an exception if it is not the case.
+   *
+   * The stream @p out should have been opened in binary mode.
+   */
+  template <int dim, int spacedim>
+  void write_binary (const Triangulation<dim,spacedim> &tria,
+                     std::ostream                      &out) const;
+
   /**
    * Write grid to @p out according to the given data format. This
    * function simply calls the appropriate <tt>write_*</tt> function.
@@ -1189,6 +1236,7 @@ public:
    * <li> @p gnuplot: <tt>.gnuplot</tt>
    * <li> @p ucd: <tt>.inp</tt>
    * <li> @p eps: <tt>.eps</tt>.
+   * <li> @p binary: <tt>.bin</tt>.
    * </ul>
    *
    * Since this function does not need data from this object, it is
@@ -114,6 +114,24 @@ namespace internal
        */
       const FEValues &get_present_fe_values () const;
 
+      /**
+       * Create the ::FEValues objects that the <tt>reinit</tt> functions
+       * select by default for each finite element of the collection. For
+       * finite element index <tt>i</tt>, these use mapping and quadrature
+       * index <tt>i</tt> if the respective collection has more than one
+       * element, and zero otherwise. Combinations for which such an object
+       * has already been created, or whose mapping or quadrature index
+       * does not exist, are skipped. The objects are created in parallel.
+       *
+       * By default, these objects are only created the first time a cell
+       * with the corresponding finite element is visited, which for
+       * collections with many elements spreads the cost of setting them up
+       * erratically over the assembly loop. Calling this function right
+       * after construction moves this cost before the loop, and uses
+       * several threads for it.
+       */
+      void precalculate_fe_values ();
+
     protected:
 
       /**
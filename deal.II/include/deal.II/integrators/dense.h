@@ -0,0 +1,205 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef __deal2__integrators_dense_h
+#define __deal2__integrators_dense_h
+
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace LocalIntegrators
+{
+  /**
+   * @brief Building blocks for computing cell matrices as products of dense
+   * matrices.
+   *
+   * Most bilinear forms used in finite element codes are of the form
+   * \f[
+   * M_{ij} = \sum_q w_q \, D\varphi_j(x_q) \cdot D\varphi_i(x_q),
+   * \f]
+   * where <i>D</i> is some differential operator, for instance the
+   * identity, the gradient or the symmetric gradient, and the
+   * <i>w<sub>q</sub></i> are the quadrature weights multiplied by the
+   * Jacobian determinant and possibly a coefficient. If we collect the
+   * values of all components of <i>D</i>&phi;<sub><i>i</i></sub> at all
+   * quadrature points in the <i>i</i>th column of a matrix <i>G</i>, this
+   * becomes the matrix product
+   * \f[
+   * M = G^T W G,
+   * \f]
+   * with a diagonal matrix <i>W</i> containing the weights. The functions in
+   * this namespace compute the matrices <i>G</i> for the most common
+   * operators, and the weighted product. The latter uses
+   * FullMatrix::Tmmult(), which calls the BLAS function <tt>gemm</tt> if
+   * deal.II was configured with BLAS, such that the bulk of the work is done
+   * by a single matrix-matrix multiplication with good cache and register
+   * reuse, instead of quadruple loops over test functions, trial functions,
+   * quadrature points and components. Setting up <i>G</i> only requires one call to
+   * FEValuesBase::shape_value_component() or
+   * FEValuesBase::shape_grad_component() per shape function, quadrature
+   * point and component, rather than one per pair of shape functions.
+   *
+   * The rows of <i>G</i> are grouped by quadrature points, i.e., all rows
+   * belonging to the first quadrature point come first, then those of the
+   * second one, and so on. Each quadrature point owns the same number of
+   * rows. Within these groups, the ordering is as documented for each
+   * function.
+   *
+   * Laplace::cell_matrix(), L2::mass_matrix() and Elasticity::cell_matrix()
+   * are implemented using these functions. They can be used in the same way
+   * for other operators, for instance to assemble the matrix of a
+   * convection-diffusion problem as the sum of two products, or to compute
+   * the product of one <i>G</i> with several different weight vectors.
+   *
+   * @ingroup Integrators
+   */
+  namespace Dense
+  {
+    /**
+     * Fill <tt>V</tt> with the values of all shape functions at the
+     * quadrature points. The row of the value of component <i>c</i> at
+     * quadrature point <i>q</i> is <i>q n<sub>c</sub>+c</i>, where
+     * <i>n<sub>c</sub></i> is the number of components of the finite
+     * element. The matrix is resized by this function.
+     */
+    template<int dim>
+    void value_matrix (
+      FullMatrix<double> &V,
+      const FEValuesBase<dim> &fe)
+    {
+      const unsigned int n_dofs = fe.dofs_per_cell;
+      const unsigned int n_components = fe.get_fe().n_components();
+      const unsigned int nq = fe.n_quadrature_points;
+
+      V.reinit(nq*n_components, n_dofs);
+      for (unsigned int k=0; k<nq; ++k)
+        for (unsigned int d=0; d<n_components; ++d)
+          for (unsigned int i=0; i<n_dofs; ++i)
+            V(k*n_components+d, i) = fe.shape_value_component(i,k,d);
+    }
+
+
+    /**
+     * Fill <tt>G</tt> with the gradients of all shape functions at the
+     * quadrature points. The row of derivative <i>e</i> of component
+     * <i>c</i> at quadrature point <i>q</i> is <i>(q n<sub>c</sub>+c)
+     * dim+e</i>. The matrix is resized by this function.
+     */
+    template<int dim>
+    void gradient_matrix (
+      FullMatrix<double> &G,
+      const FEValuesBase<dim> &fe)
+    {
+      const unsigned int n_dofs = fe.dofs_per_cell;
+      const unsigned int n_components = fe.get_fe().n_components();
+      const unsigned int nq = fe.n_quadrature_points;
+
+      G.reinit(nq*n_components*dim, n_dofs);
+      for (unsigned int k=0; k<nq; ++k)
+        for (unsigned int d=0; d<n_components; ++d)
+          for (unsigned int i=0; i<n_dofs; ++i)
+            {
+              const Tensor<1,dim> grad = fe.shape_grad_component(i,k,d);
+              for (unsigned int e=0; e<dim; ++e)
+                G((k*n_components+d)*dim+e, i) = grad[e];
+            }
+    }
+
+
+    /**
+     * Fill <tt>E</tt> with the symmetric gradients
+     * \f[
+     * \varepsilon(\varphi)_{de} = \frac12 (\partial_e \varphi_d + \partial_d \varphi_e)
+     * \f]
+     * of all shape functions at the quadrature points. The finite element
+     * must have <tt>dim</tt> components. The row of entry <i>(d,e)</i> at
+     * quadrature point <i>q</i> is <i>(q dim+d) dim+e</i>. The matrix is
+     * resized by this function.
+     */
+    template<int dim>
+    void symmetric_gradient_matrix (
+      FullMatrix<double> &E,
+      const FEValuesBase<dim> &fe)
+    {
+      const unsigned int n_dofs = fe.dofs_per_cell;
+      const unsigned int nq = fe.n_quadrature_points;
+      AssertDimension(fe.get_fe().n_components(), dim);
+
+      E.reinit(nq*dim*dim, n_dofs);
+      for (unsigned int k=0; k<nq; ++k)
+        for (unsigned int i=0; i<n_dofs; ++i)
+          {
+            Tensor<1,dim> grad[dim];
+            for (unsigned int d=0; d<dim; ++d)
+              grad[d] = fe.shape_grad_component(i,k,d);
+            for (unsigned int d=0; d<dim; ++d)
+              for (unsigned int e=0; e<dim; ++e)
+                E((k*dim+d)*dim+e, i) = .5 * (grad[d][e] + grad[e][d]);
+          }
+    }
+
+
+    /**
+     * Add the product
+     * \f[
+     * M \mathrel{+}= \text{factor}\; A^T W B
+     * \f]
+     * to <tt>M</tt>, where <i>W</i> is the diagonal matrix which has the
+     * weight of quadrature point <i>q</i> in all rows belonging to this
+     * point. <tt>A</tt> and <tt>B</tt> are matrices as computed by the other
+     * functions in this namespace, and may be the same object. The number of
+     * their rows must be a multiple of the number of weights.
+     *
+     * Typically, the weights are FEValuesBase::get_JxW_values(), possibly
+     * multiplied by the values of a coefficient.
+     */
+    inline void weighted_product (
+      FullMatrix<double> &M,
+      const FullMatrix<double> &A,
+      const FullMatrix<double> &B,
+      const std::vector<double> &weights,
+      const double factor = 1.)
+    {
+      AssertDimension(A.m(), B.m());
+      AssertDimension(M.m(), A.n());
+      AssertDimension(M.n(), B.n());
+      Assert(weights.size() > 0, ExcNotInitialized());
+      Assert(B.m() % weights.size() == 0,
+             ExcDimensionMismatch(B.m(), weights.size()));
+
+      const unsigned int rows_per_point = B.m() / weights.size();
+      FullMatrix<double> WB(B.m(), B.n());
+      for (unsigned int k=0; k<B.m(); ++k)
+        {
+          const double w = factor * weights[k/rows_per_point];
+          for (unsigned int j=0; j<B.n(); ++j)
+            WB(k,j) = w * B(k,j);
+        }
+      A.Tmmult(M, WB, true);
+    }
+  }
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -25,6 +25,7 @@
 #include <deal.II/fe/mapping.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/meshworker/dof_info.h>
+#include <deal.II/integrators/dense.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -59,17 +60,9 @@ namespace LocalIntegrators
       AssertDimension(M.m(), n_dofs);
       AssertDimension(M.n(), n_dofs);
 
-      for (unsigned int k=0; k<fe.n_quadrature_points; ++k)
-        {
-          const double dx = factor * fe.JxW(k);
-          for (unsigned int i=0; i<n_dofs; ++i)
-            for (unsigned int j=0; j<n_dofs; ++j)
-              for (unsigned int d1=0; d1<dim; ++d1)
-                for (unsigned int d2=0; d2<dim; ++d2)
-                  M(i,j) += dx * .25 *
-                            (fe.shape_grad_component(j,k,d1)[d2] + fe.shape_grad_component(j,k,d2)[d1]) *
-                            (fe.shape_grad_component(i,k,d1)[d2] + fe.shape_grad_component(i,k,d2)[d1]);
-        }
+      FullMatrix<double> E;
+      Dense::symmetric_gradient_matrix(E, fe);
+      Dense::weighted_product(M, E, E, fe.get_JxW_values(), factor);
     }
 
 
@@ -25,6 +25,7 @@
 #include <deal.II/fe/mapping.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/meshworker/dof_info.h>
+#include <deal.II/integrators/dense.h>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -58,20 +59,9 @@ namespace LocalIntegrators
       const FEValuesBase<dim> &fe,
       const double factor = 1.)
     {
-      const unsigned int n_dofs = fe.dofs_per_cell;
-      const unsigned int n_components = fe.get_fe().n_components();
-
-      for (unsigned int k=0; k<fe.n_quadrature_points; ++k)
-        {
-          const double dx = fe.JxW(k) * factor;
-          for (unsigned int i=0; i<n_dofs; ++i)
-            {
-              for (unsigned int j=0; j<n_dofs; ++j)
-                for (unsigned int d=0; d<n_components; ++d)
-                  M(i,j) += dx *
-                            (fe.shape_grad_component(j,k,d) * fe.shape_grad_component(i,k,d));
-            }
-        }
+      FullMatrix<double> G;
+      Dense::gradient_matrix(G, fe);
+      Dense::weighted_product(M, G, G, fe.get_JxW_values(), factor);
     }
 
     /**
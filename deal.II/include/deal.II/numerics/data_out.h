@@ -255,11 +255,13 @@ private:
   /**
    * Build one patch. This function is called in a WorkStream context.
    *
-   * The result is written into the patch variable.
+   * The result is written directly into the element of @p patches that
+   * corresponds to the cell. The third argument is the object WorkStream
+   * uses for data to be copied; it is not used.
    */
   void build_one_patch (const std::pair<cell_iterator, unsigned int> *cell_and_index,
                         internal::DataOut::ParallelData<DH::dimension, DH::space_dimension> &data,
-                        ::dealii::DataOutBase::Patch<DH::dimension, DH::space_dimension> &patch,
+                        ::dealii::DataOutBase::Patch<DH::dimension, DH::space_dimension> &,
                         const CurvedCellRegion curved_cell_region,
                         std::vector<dealii::DataOutBase::Patch<DH::dimension, DH::space_dimension> > &patches);
 };
@@ -0,0 +1,107 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef __deal2__data_out_coarse_h
+#define __deal2__data_out_coarse_h
+
+
+#include <deal.II/base/config.h>
+#include <deal.II/numerics/data_out.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * This class generates output on a coarser level of the mesh than the one
+ * the computation was done on. It writes one patch for each cell on the
+ * given level of the mesh hierarchy, and for each active cell on a
+ * coarser level. Since each level of refinement multiplies the number of
+ * cells by <tt>2<sup>dim</sup></tt>, writing output a few levels below
+ * the finest one reduces its size by orders of magnitude, which makes it
+ * possible to write output much more often, for example to monitor a
+ * simulation while it runs:
+ * @code
+ *   DataOutCoarse<dim> data_out (triangulation.n_levels() - 3);
+ *   data_out.attach_dof_handler (dof_handler);
+ *   data_out.add_data_vector (solution, "solution");
+ *   data_out.build_patches ();
+ *   data_out.write_vtu (output);
+ * @endcode
+ *
+ * This class only overloads the DataOut::first_cell() and
+ * DataOut::next_cell() functions. The values on cells that have children
+ * are therefore computed the way DataOut does for such cells: through
+ * DoFCellAccessor::get_interpolated_dof_values(), i.e., by restricting
+ * the values from the children using the restriction matrices of the
+ * finite element. For Lagrange elements, this amounts to interpolation,
+ * for discontinuous elements to an average over the children.
+ *
+ * Since cell data is only defined on active cells, it can not be written
+ * with this class unless the level passed to the constructor is at least
+ * the one of the finest active cell, in which case this class generates
+ * the same output as DataOut.
+ *
+ * @note Cells with children are not owned by any single process of a
+ * parallel::distributed::Triangulation, and the restriction of values
+ * requires all values on the children to be available. This class is
+ * therefore meant for use with sequential triangulations.
+ *
+ * @ingroup output
+ */
+template <int dim, class DH=DoFHandler<dim> >
+class DataOutCoarse : public DataOut<dim,DH>
+{
+public:
+  /**
+   * Typedef to the iterator type of the dof handler class under
+   * consideration.
+   */
+  typedef typename DataOut<dim,DH>::cell_iterator cell_iterator;
+
+  /**
+   * Constructor. Output is generated on the cells of level
+   * <tt>max_level</tt> and on all active cells on coarser levels.
+   */
+  DataOutCoarse (const unsigned int max_level);
+
+  /**
+   * Return the first cell on the level given to the constructor, or the
+   * first active cell on a coarser level.
+   */
+  virtual cell_iterator first_cell ();
+
+  /**
+   * Return the next cell after @p cell on the level given to the
+   * constructor, or the next active cell on a coarser level.
+   */
+  virtual cell_iterator next_cell (const cell_iterator &cell);
+
+private:
+  /**
+   * The finest level on which output is generated.
+   */
+  const unsigned int max_level;
+
+  /**
+   * Return whether output is to be generated on the given cell.
+   */
+  bool is_output_cell (const cell_iterator &cell) const;
+};
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
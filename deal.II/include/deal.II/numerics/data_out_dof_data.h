@@ -806,6 +806,14 @@ protected:
   virtual
   const std::vector<Patch> &get_patches () const;
 
+  /**
+   * Hand the patches over to the caller without copying them. This
+   * object does not have any patches afterwards. See
+   * DataOutInterface::release_patches() for more information.
+   */
+  virtual
+  void release_patches (std::vector<Patch> &patches);
+
   /**
    * Virtual function through which the names of data sets are obtained by the
    * output functions of the base class.
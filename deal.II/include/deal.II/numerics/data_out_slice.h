@@ -0,0 +1,206 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef __deal2__data_out_slice_h
+#define __deal2__data_out_slice_h
+
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/numerics/data_out.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace DataOutSlice
+  {
+    /**
+     * A derived class for use in the DataOutSlice class. This is a class
+     * for the AdditionalData kind of data structure discussed in the
+     * documentation of the WorkStream context.
+     */
+    template <int dim, int spacedim>
+    struct ParallelData : public internal::DataOut::ParallelDataBase<dim,spacedim>
+    {
+      ParallelData (const unsigned int n_datasets,
+                    const unsigned int n_subdivisions,
+                    const std::vector<unsigned int> &n_postprocessor_outputs,
+                    const Mapping<dim,spacedim> &mapping,
+                    const std::vector<std_cxx1x::shared_ptr<dealii::hp::FECollection<dim,spacedim> > > &finite_elements,
+                    const UpdateFlags update_flags);
+
+      /**
+       * Replace the FEValues objects of the base class by ones that
+       * evaluate the finite element fields at the given points of the
+       * unit cell.
+       */
+      void reinit_quadrature (const Quadrature<dim> &quadrature);
+
+      std::vector<Point<spacedim> > patch_normals;
+      std::vector<Point<spacedim> > patch_evaluation_points;
+    };
+  }
+}
+
+
+
+/**
+ * This class generates output on the intersection of a triangulation with
+ * a plane, i.e. on a cut through the domain. Writing output on a few such
+ * slices instead of the whole domain reduces the amount of data by orders
+ * of magnitude, which makes it possible to monitor three-dimensional
+ * simulations in every time step. The plane is given by a point on it
+ * and its normal vector:
+ * @code
+ *   DataOutSlice<3> data_out (Point<3>(0.5,0,0), Point<3>(1,0,0));
+ *   data_out.attach_dof_handler (dof_handler);
+ *   data_out.add_data_vector (solution, "solution");
+ *   data_out.build_patches (2);
+ *   data_out.write_vtu (output);
+ * @endcode
+ *
+ * The output of this class is a set of patches of dimension
+ * <tt>dim-1</tt> that cover the intersection of the plane with all active
+ * cells. In 2d, each cell that is cut by the plane (which then is a line)
+ * yields a line segment. In 3d, the intersection of a cell with the plane
+ * is a polygon with three to six vertices, which is split into one or two
+ * quadrilaterals; in the case of a triangle, two of the vertices of the
+ * quadrilateral coincide. The patches can then be written in all of the
+ * graphical formats of the base classes, just like the output of
+ * DataOutFaces.
+ *
+ * The intersection is computed from the vertices of the cells, i.e., as
+ * if the cells had straight edges. The positions at which the finite
+ * element fields are evaluated are the images of the corresponding points
+ * of the reference cell under the mapping passed to build_patches(). For
+ * cells that are parallelograms or parallelepipeds, these points lie
+ * exactly on the plane; for other cells, the patches are a multilinear
+ * approximation of the intersection.
+ *
+ * If the plane passes exactly through a face of the mesh, output is
+ * generated only once for this face, from the cell on the side of the
+ * plane opposite to its normal vector.
+ *
+ * If postprocessors are attached to this object and ask for normal
+ * vectors, they are given the normal vector of the plane.
+ *
+ * The patches are built in parallel. Since the positions of the points at
+ * which the fields are evaluated differ from cell to cell, the FEValues
+ * objects have to be re-created for each patch. Building the patches of a
+ * slice is therefore more expensive per patch than building those of
+ * DataOut, but there are far fewer of them.
+ *
+ * @precondition This class only makes sense if the first template
+ * argument, <code>dim</code> equals the dimension of the DoFHandler type
+ * given as the second template argument, i.e., if <code>dim ==
+ * DH::dimension</code>.
+ *
+ * @ingroup output
+ */
+template <int dim, class DH=DoFHandler<dim> >
+class DataOutSlice : public DataOut_DoFData<DH,DH::dimension-1,
+  DH::dimension>
+{
+public:
+  /**
+   * Dimension parameters for the iterators.
+   */
+  static const unsigned int dimension = DH::dimension;
+  static const unsigned int space_dimension = DH::space_dimension;
+
+  /**
+   * Typedef to the iterator type of the dof handler class under
+   * consideration.
+   */
+  typedef typename DataOut_DoFData<DH,dimension-1,
+          dimension>::cell_iterator cell_iterator;
+
+  /**
+   * Constructor. The plane on which output is generated is the one that
+   * contains <tt>point_on_plane</tt> and is orthogonal to
+   * <tt>normal</tt>. The normal vector need not have unit length.
+   */
+  DataOutSlice (const Point<DH::space_dimension> &point_on_plane,
+                const Point<DH::space_dimension> &normal);
+
+  /**
+   * Change the plane on which output is generated. This only takes
+   * effect with the next call to build_patches().
+   */
+  void set_plane (const Point<DH::space_dimension> &point_on_plane,
+                  const Point<DH::space_dimension> &normal);
+
+  /**
+   * This is the central function of this class since it builds the list
+   * of patches to be written by the low-level functions of the base
+   * class. See the general documentation of this class for further
+   * information.
+   *
+   * The function supports multithreading, if deal.II is compiled in
+   * multithreading mode.
+   */
+  virtual void
+  build_patches (const unsigned int n_subdivisions = 0);
+
+  /**
+   * Same as above, except that the positions of the points at which the
+   * fields are evaluated are computed with the given mapping.
+   */
+  virtual void build_patches (const Mapping<dimension> &mapping,
+                              const unsigned int n_subdivisions = 0);
+
+  /**
+   * Exception
+   */
+  DeclException1 (ExcInvalidNumberOfSubdivisions,
+                  int,
+                  << "The number of subdivisions per patch, " << arg1
+                  << ", is not valid.");
+
+private:
+  /**
+   * A point on the plane, and the normal vector of the plane, normalized
+   * to unit length.
+   */
+  Point<space_dimension> point_on_plane;
+  Point<space_dimension> normal;
+
+  /**
+   * Return the signed distances of the vertices of the given cell from
+   * the plane.
+   */
+  void
+  compute_vertex_distances (const cell_iterator &cell,
+                            double (&distances)[GeometryInfo<dimension>::vertices_per_cell]) const;
+
+  /**
+   * Build the patches for the intersection of the plane with the given
+   * cell. The second element of the pair is the index of the cell among
+   * the active cells, which is needed to access cell data.
+   */
+  void build_patches_on_cell (const std::pair<cell_iterator,unsigned int> *cell_and_index,
+                              internal::DataOutSlice::ParallelData<dimension, dimension> &data,
+                              std::vector<DataOutBase::Patch<dimension-1,space_dimension> > &cell_patches);
+};
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
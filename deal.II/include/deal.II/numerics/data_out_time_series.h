@@ -0,0 +1,190 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef __deal2__data_out_time_series_h
+#define __deal2__data_out_time_series_h
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/grid/tria.h>
+
+#include <boost/signals2.hpp>
+
+#include <string>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A class that writes the output of a time dependent simulation to HDF5
+ * files and an XDMF file that describes them, writing the mesh only when
+ * it has changed. For simulations on a fixed mesh, the node coordinates
+ * and the connectivity usually make up the larger part of each output
+ * file, even though only the data values change from one time step to
+ * the next. This class writes the mesh into a separate HDF5 file the
+ * first time write() is called and reuses it for all later time steps,
+ * for which only the data values are written. The mesh is only written
+ * again after the triangulation has changed, for example because it has
+ * been refined.
+ *
+ * The class is used as follows:
+ * @code
+ *   DataOutTimeSeries<dim> time_series (triangulation, "solution",
+ *                                       MPI_COMM_WORLD);
+ *
+ *   for (timestep=0; ...)
+ *     {
+ *       ... // solve, possibly refine the mesh
+ *
+ *       DataOut<dim> data_out;
+ *       data_out.attach_dof_handler (dof_handler);
+ *       data_out.add_data_vector (solution, "solution");
+ *       data_out.build_patches ();
+ *
+ *       time_series.write (data_out, time);
+ *     }
+ * @endcode
+ *
+ * For a file name prefix <tt>solution</tt>, this writes the files
+ * <tt>solution-mesh-0000.h5</tt>, <tt>solution-mesh-0001.h5</tt>, ...
+ * holding the meshes, the files <tt>solution-00000.h5</tt>,
+ * <tt>solution-00001.h5</tt>, ... holding the data of each time step,
+ * and the file <tt>solution.xdmf</tt> that lists the data files along
+ * with the mesh each of them refers to and the time they belong to. The
+ * XDMF file is rewritten in each call to write(), so it is always
+ * complete, and can be opened by ParaView or VisIt. The names of the
+ * HDF5 files are stored in it without the directory part of the prefix,
+ * i.e., relative to the location of the XDMF file.
+ *
+ * Whether the mesh has changed is detected by listening to the signals of
+ * the triangulation passed to the constructor. In addition, the mesh is
+ * written again if the number of nodes or cells of the data passed to
+ * write() differs from the one of the last mesh. However, the class can
+ * not detect changes that leave these numbers alone, for example if the
+ * mapping used to build the patches changes, or if the mesh is moved.
+ * In these cases, call mesh_changed() before the next call to write().
+ *
+ * If the flags passed to the constructor ask for duplicate vertices to
+ * be filtered (the default), data values are written only once per
+ * vertex. This further reduces the amount of data, but is only
+ * appropriate for continuous fields; see DataOutBase::DataOutFilter.
+ *
+ * @note This class requires deal.II to be configured with HDF5 support,
+ * and only supports output in two and three space dimensions.
+ *
+ * @ingroup output
+ */
+template <int dim, int spacedim=dim>
+class DataOutTimeSeries : public Subscriptor
+{
+public:
+  /**
+   * Constructor. Mesh changes are detected through the signals of the
+   * given triangulation. All files are named after the given prefix,
+   * which may include a directory. All processes in the given
+   * communicator have to call write() together.
+   */
+  DataOutTimeSeries (const Triangulation<dim,spacedim>     &triangulation,
+                     const std::string                     &filename_prefix,
+                     MPI_Comm                               mpi_communicator,
+                     const DataOutBase::DataOutFilterFlags &flags = DataOutBase::DataOutFilterFlags (true, true));
+
+  /**
+   * Destructor.
+   */
+  ~DataOutTimeSeries ();
+
+  /**
+   * Write the data of the given object for the given time. The mesh is
+   * written as well if this is the first call to this function, or if
+   * the mesh has changed since it was last written.
+   */
+  void write (const DataOutInterface<dim,spacedim> &data_out,
+              const double                          time);
+
+  /**
+   * Make sure the mesh is written in the next call to write(), even if
+   * no change of the triangulation was detected.
+   */
+  void mesh_changed ();
+
+  /**
+   * Return the number of meshes written so far.
+   */
+  unsigned int n_written_meshes () const;
+
+  /**
+   * Return the number of time steps written so far.
+   */
+  unsigned int n_written_time_steps () const;
+
+private:
+  /**
+   * The triangulation whose changes trigger writing the mesh.
+   */
+  SmartPointer<const Triangulation<dim,spacedim>,DataOutTimeSeries<dim,spacedim> > triangulation;
+
+  /**
+   * The prefix of all file names, and the same without its directory
+   * part as it is used in the XDMF file.
+   */
+  const std::string filename_prefix;
+  const std::string relative_filename_prefix;
+
+  /**
+   * The communicator of all processes that write output.
+   */
+  MPI_Comm mpi_communicator;
+
+  /**
+   * The flags used to filter the data.
+   */
+  const DataOutBase::DataOutFilterFlags flags;
+
+  /**
+   * Whether the mesh has to be written in the next call to write().
+   */
+  bool write_mesh;
+
+  /**
+   * The number of meshes written so far, the number of nodes and cells
+   * of the last of them on the current process, and what has been
+   * appended to the prefix to get the name of the file it was written to.
+   */
+  unsigned int n_meshes;
+  unsigned int mesh_n_nodes;
+  unsigned int mesh_n_cells;
+  std::string  mesh_filename_suffix;
+
+  /**
+   * The entries of the XDMF file for all time steps written so far.
+   */
+  std::vector<XDMFEntry> xdmf_entries;
+
+  /**
+   * Used to detect signals from the Triangulation.
+   */
+  boost::signals2::connection tria_listener;
+};
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
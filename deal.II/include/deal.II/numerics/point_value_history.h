@@ -203,6 +203,11 @@ namespace internal
  * node_monitor.write_gnuplot("node"); // write out data files
  *
  * @endcode
+ *
+ * This class keeps all data in memory until the end of the computation and
+ * only works on sequential triangulations. For many points or long time
+ * series, or for parallel computations, consider the
+ * PointValueHistoryStream class instead.
  */
 template <int dim>
 class PointValueHistory
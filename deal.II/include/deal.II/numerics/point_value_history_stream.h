@@ -0,0 +1,280 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef __dealii__point_value_history_stream_h
+#define __dealii__point_value_history_stream_h
+
+#include <deal.II/base/config.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+#include <deal.II/base/subscriptor.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <boost/signals2.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A class that records the values of a finite element field at a fixed set
+ * of points in every time step and writes them to a binary file while the
+ * computation runs. It serves the same purpose as PointValueHistory, but is
+ * designed for large numbers of points and time steps, and for parallel
+ * computations:
+ * <ul>
+ * <li> The points are located once, and for each point the class stores
+ * the degrees of freedom of the cell it lies in and the values of the shape
+ * functions at it. Evaluating the field in a time step then only amounts to
+ * one short scalar product per point and vector component, rather than a
+ * search for the point and the initialization of an FEValues object.
+ * <li> The values of a number of time steps are collected in a buffer of
+ * fixed size, in which the values of each point and component (a
+ * "column") are stored contiguously. Once the buffer is full, it is
+ * appended to the output file and cleared. The memory used by this class
+ * therefore does not grow with the number of time steps, and no output has
+ * to be written at the end of the computation.
+ * <li> On a parallel::distributed::Triangulation, each point is owned by
+ * the process that owns the cell it lies in, and only this process
+ * evaluates it. When a buffer is written, the columns of all processes are
+ * sent to the first process of the communicator, which writes the file.
+ * </ul>
+ *
+ * The class is used as follows:
+ * @code
+ *   PointValueHistoryStream<dim> probes (dof_handler, points, "probes.bin",
+ *                                        MPI_COMM_WORLD);
+ *   for (timestep=0; ...)
+ *     {
+ *       ... // compute locally_relevant_solution
+ *       probes.add_sample (time, locally_relevant_solution);
+ *     }
+ *   probes.flush ();
+ * @endcode
+ * The vector passed to add_sample() needs to contain the values of all
+ * degrees of freedom of the locally owned cells, i.e., in parallel
+ * computations it has to be a vector with ghost elements.
+ *
+ * If the triangulation changes, the points are located again in the next
+ * call to add_sample(), after the samples collected on the old mesh have
+ * been written. This requires the DoFHandler to have been re-initialized
+ * on the new mesh by then. If the degrees of freedom are renumbered
+ * without a change of the mesh, call invalidate_cache().
+ *
+ * <h3>File format</h3>
+ *
+ * The file starts with the line <tt>deal.II point value history 1</tt>,
+ * followed by the number of points, the number of vector components of
+ * the finite element and the space dimension as 32 bit unsigned integers,
+ * and the coordinates of the points as doubles. Each buffer that is
+ * written then adds a chunk that consists of the number of time steps in
+ * it as a 32 bit unsigned integer, the times of these steps, and then for
+ * each point and each component the values at these times, all as doubles
+ * in the byte order of the machine the file was written on. The static
+ * function read() reads such a file.
+ *
+ * @note All functions of this class that write to the file, i.e. the
+ * constructor, add_sample(), flush() and the destructor, need to be called
+ * on all processes of the communicator at the same time.
+ *
+ * @ingroup output
+ */
+template <int dim, int spacedim=dim>
+class PointValueHistoryStream : public Subscriptor
+{
+public:
+  /**
+   * Constructor. Record the values of finite element fields described by
+   * the given DoFHandler at the given points, which are mapped to the
+   * reference cell with the given mapping. The first process of the
+   * communicator creates the file and writes its header. At most
+   * <tt>chunk_size</tt> time steps are kept in memory before they are
+   * appended to the file.
+   */
+  PointValueHistoryStream (const DoFHandler<dim,spacedim>      &dof_handler,
+                           const std::vector<Point<spacedim> > &points,
+                           const std::string                   &filename,
+                           MPI_Comm                             mpi_communicator,
+                           const unsigned int                   chunk_size = 1024,
+                           const Mapping<dim,spacedim>         &mapping = StaticMappingQ1<dim,spacedim>::mapping);
+
+  /**
+   * Destructor. Writes the samples that are still in the buffer.
+   */
+  ~PointValueHistoryStream ();
+
+  /**
+   * Evaluate the given finite element field at all points and record the
+   * values along with the given time.
+   */
+  template <class VECTOR>
+  void add_sample (const double  time,
+                   const VECTOR &solution);
+
+  /**
+   * Append the samples collected since the last write to the file, and
+   * clear the buffer.
+   */
+  void flush ();
+
+  /**
+   * Locate the points again before the next sample is taken. This is
+   * necessary if the degrees of freedom have been renumbered.
+   */
+  void invalidate_cache ();
+
+  /**
+   * Return the number of points.
+   */
+  unsigned int n_points () const;
+
+  /**
+   * Return the number of points owned by the current process, i.e. the
+   * number of points that lie in locally owned cells. The result is only
+   * meaningful after the first call to add_sample().
+   */
+  unsigned int n_locally_owned_points () const;
+
+  /**
+   * Return the total number of samples taken so far, including those
+   * that have already been written to the file.
+   */
+  unsigned int n_samples () const;
+
+  /**
+   * Read a file written by this class. The locations of the points are
+   * returned in the second argument, the times of all samples in the
+   * third, and the values as <tt>values[point][component][step]</tt>.
+   */
+  static void read (std::istream                                    &in,
+                    std::vector<Point<spacedim> >                   &locations,
+                    std::vector<double>                             &times,
+                    std::vector<std::vector<std::vector<double> > > &values);
+
+  /**
+   * Exception
+   */
+  DeclException1 (ExcInvalidFile,
+                  std::string,
+                  << "The input does not have the format written by "
+                  << "PointValueHistoryStream: " << arg1);
+
+private:
+  /**
+   * Locate the points and compute the degrees of freedom and shape
+   * function values needed to evaluate the field at the locally owned
+   * ones.
+   */
+  void build_cache ();
+
+  /**
+   * Called when the triangulation changes.
+   */
+  void tria_change_listener ();
+
+  /**
+   * The DoFHandler and mapping with which the field is evaluated.
+   */
+  SmartPointer<const DoFHandler<dim,spacedim>,PointValueHistoryStream<dim,spacedim> > dof_handler;
+  SmartPointer<const Mapping<dim,spacedim>,PointValueHistoryStream<dim,spacedim> > mapping;
+
+  /**
+   * The points at which the field is evaluated.
+   */
+  const std::vector<Point<spacedim> > points;
+
+  /**
+   * The name of the output file.
+   */
+  const std::string filename;
+
+  /**
+   * The communicator of all processes that record values.
+   */
+  MPI_Comm mpi_communicator;
+
+  /**
+   * The maximal number of time steps kept in the buffer.
+   */
+  const unsigned int chunk_size;
+
+  /**
+   * The number of vector components of the finite element.
+   */
+  const unsigned int n_components;
+
+  /**
+   * Whether the cache describes the current mesh and degrees of freedom.
+   */
+  bool cache_is_valid;
+
+  /**
+   * For each point, the process that owns it. For each process, the
+   * number of points it owns, and for each point, its position among the
+   * points owned by its process. These are needed on the first process to
+   * put the columns it receives in order.
+   */
+  std::vector<unsigned int> point_owners;
+  std::vector<unsigned int> n_points_per_process;
+  std::vector<unsigned int> position_on_owner;
+
+  /**
+   * The global indices of the points owned by the current process, in
+   * ascending order.
+   */
+  std::vector<unsigned int> locally_owned_points;
+
+  /**
+   * For each locally owned point, the degrees of freedom of the cell it
+   * lies in are <tt>cache_dof_indices[cache_start[i]]</tt> to
+   * <tt>cache_dof_indices[cache_start[i+1]-1]</tt>, and the values of the
+   * shape functions at the point follow each other component by
+   * component, starting at <tt>cache_shape_values[n_components *
+   * cache_start[i]]</tt>.
+   */
+  std::vector<unsigned int>            cache_start;
+  std::vector<types::global_dof_index> cache_dof_indices;
+  std::vector<double>                  cache_shape_values;
+
+  /**
+   * The times of the samples in the buffer, and their values. The values
+   * of component <tt>c</tt> at the <tt>i</tt>th locally owned point start
+   * at <tt>value_buffer[(i*n_components+c)*chunk_size]</tt>.
+   */
+  std::vector<double> time_buffer;
+  std::vector<double> value_buffer;
+
+  /**
+   * The number of samples that have been written to the file.
+   */
+  unsigned int n_written_samples;
+
+  /**
+   * Used to detect signals from the Triangulation.
+   */
+  boost::signals2::connection tria_listener;
+};
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
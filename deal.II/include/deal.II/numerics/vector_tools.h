@@ -42,6 +42,7 @@ template <typename number> class FullMatrix;
 template <int dim, int spacedim> class Mapping;
 template <int dim, int spacedim> class DoFHandler;
 template <typename gridtype> class InterGridMap;
+template <class Container> class CellLocator;
 namespace hp
 {
   template <int dim, int spacedim> class DoFHandler;
@@ -2363,6 +2364,58 @@ namespace VectorTools
                const InVector                            &fe_function,
                const Point<spacedim>                     &point);
 
+  /**
+   * Evaluate a possibly vector-valued finite element function defined by
+   * the given DoFHandler and nodal vector at all of the given points, and
+   * return the values through the last argument, which is resized as
+   * necessary. The result is the same as calling point_value() for each of
+   * the points, but this function is much faster if there are many
+   * points, for example when sampling a solution along lines or at a set
+   * of probes in every time step: the points are located with a
+   * CellLocator, which does the search for all points in parallel and
+   * needs a time that grows only logarithmically with the number of
+   * cells, and the points that lie in the same cell are evaluated
+   * together.
+   *
+   * If a point does not lie in the mesh, an exception of type
+   * GridTools::ExcPointNotFound is thrown. If the cell in which a point
+   * is found is not locally owned, an exception of type
+   * VectorTools::ExcPointNotAvailableHere is thrown.
+   *
+   * If the same mesh is used for several calls, it is cheaper to use the
+   * variant of this function that takes a CellLocator, since the
+   * bounding box hierarchy is then only built once.
+   */
+  template <int dim, class InVector, int spacedim>
+  void
+  point_values (const Mapping<dim,spacedim>      &mapping,
+                const DoFHandler<dim,spacedim>   &dof,
+                const InVector                   &fe_function,
+                const std::vector<Point<spacedim> > &points,
+                std::vector<Vector<double> >     &values);
+
+  /**
+   * Same as above, using a Q1-mapping.
+   */
+  template <int dim, class InVector, int spacedim>
+  void
+  point_values (const DoFHandler<dim,spacedim>   &dof,
+                const InVector                   &fe_function,
+                const std::vector<Point<spacedim> > &points,
+                std::vector<Vector<double> >     &values);
+
+  /**
+   * Same as above, but use the given CellLocator, which must have been
+   * created for the DoFHandler, to locate the points. The mapping used
+   * for the evaluation is the one the CellLocator was created with.
+   */
+  template <int dim, class InVector, int spacedim>
+  void
+  point_values (const CellLocator<DoFHandler<dim,spacedim> > &cell_locator,
+                const InVector                   &fe_function,
+                const std::vector<Point<spacedim> > &points,
+                std::vector<Vector<double> >     &values);
+
   //@}
   /**
    * Mean value operations
@@ -21,6 +21,7 @@
 #include <deal.II/base/derivative_form.h>
 #include <deal.II/base/function.h>
 #include <deal.II/base/quadrature.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/block_vector.h>
 #include <deal.II/lac/parallel_vector.h>
@@ -41,6 +42,7 @@
 #include <deal.II/grid/tria_accessor.h>
 #include <deal.II/grid/tria_boundary.h>
 #include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/cell_locator.h>
 #include <deal.II/grid/intergrid_map.h>
 #include <deal.II/dofs/dof_accessor.h>
 #include <deal.II/dofs/dof_handler.h>
@@ -5853,6 +5855,159 @@ namespace VectorTools
 
 
 
+  namespace internal
+  {
+    namespace PointValues
+    {
+      /**
+       * Evaluate the given finite element function at the points that lie
+       * in the cells <tt>cells[begin]</tt> to <tt>cells[end-1]</tt>. For
+       * each of these cells, <tt>point_indices[cell_start[c]]</tt> to
+       * <tt>point_indices[cell_start[c+1]-1]</tt> are the indices of the
+       * points within it, and @p cell_points holds their coordinates on
+       * the reference cell, indexed in the same way as @p points.
+       */
+      template <int dim, class InVector, int spacedim>
+      void
+      evaluate_on_cells (const unsigned int begin,
+                         const unsigned int end,
+                         const Mapping<dim,spacedim>     &mapping,
+                         const InVector                  &fe_function,
+                         const std::vector<typename DoFHandler<dim,spacedim>::active_cell_iterator> &cells,
+                         const std::vector<unsigned int> &cell_start,
+                         const std::vector<unsigned int> &point_indices,
+                         const std::vector<Point<dim> >  &cell_points,
+                         std::vector<Vector<double> >    &values)
+      {
+        for (unsigned int c=begin; c<end; ++c)
+          {
+            const unsigned int n_points = cell_start[c+1] - cell_start[c];
+
+            std::vector<Point<dim> > quadrature_points (n_points);
+            for (unsigned int q=0; q<n_points; ++q)
+              quadrature_points[q]
+                = GeometryInfo<dim>::project_to_unit_cell (cell_points[point_indices[cell_start[c]+q]]);
+            const Quadrature<dim> quadrature (quadrature_points,
+                                              std::vector<double> (n_points, 1.));
+
+            FEValues<dim,spacedim> fe_values (mapping, cells[c]->get_fe(),
+                                              quadrature, update_values);
+            fe_values.reinit (cells[c]);
+
+            std::vector<Vector<double> >
+            u_values (n_points, Vector<double> (cells[c]->get_fe().n_components()));
+            fe_values.get_function_values (fe_function, u_values);
+
+            for (unsigned int q=0; q<n_points; ++q)
+              values[point_indices[cell_start[c]+q]] = u_values[q];
+          }
+      }
+    }
+  }
+
+
+
+  template <int dim, class InVector, int spacedim>
+  void
+  point_values (const CellLocator<DoFHandler<dim,spacedim> > &cell_locator,
+                const InVector                   &fe_function,
+                const std::vector<Point<spacedim> > &points,
+                std::vector<Vector<double> >     &values)
+  {
+    typedef typename DoFHandler<dim,spacedim>::active_cell_iterator active_cell_iterator;
+
+    const DoFHandler<dim,spacedim> &dof = cell_locator.get_container();
+    values.resize (points.size(), Vector<double> (dof.get_fe().n_components()));
+    if (points.size() == 0)
+      return;
+
+    // first find the cells in which the points are, for all points at once
+    std::vector<std::pair<active_cell_iterator, Point<dim> > > cell_points;
+    cell_locator.find_active_cells_around_points (points, cell_points);
+
+    // then sort the points by the cells they are in, so that we only need
+    // to initialize an FEValues object once for all points in a cell
+    std::vector<std::pair<std::pair<int,int>, unsigned int> > sorted_points (points.size());
+    for (unsigned int i=0; i<points.size(); ++i)
+      {
+        AssertThrow (cell_points[i].first != dof.end(),
+                     GridTools::ExcPointNotFound<spacedim>(points[i]));
+        AssertThrow (cell_points[i].first->is_locally_owned(),
+                     ExcPointNotAvailableHere());
+        Assert (GeometryInfo<dim>::distance_to_unit_cell(cell_points[i].second) < 1e-10,
+                ExcInternalError());
+
+        sorted_points[i] = std::make_pair (std::make_pair (cell_points[i].first->level(),
+                                                           cell_points[i].first->index()),
+                                           i);
+      }
+    std::sort (sorted_points.begin(), sorted_points.end());
+
+    std::vector<active_cell_iterator> cells;
+    std::vector<unsigned int>         cell_start;
+    std::vector<unsigned int>         point_indices (points.size());
+    std::vector<Point<dim> >          unit_points (points.size());
+    for (unsigned int i=0; i<sorted_points.size(); ++i)
+      {
+        const unsigned int point = sorted_points[i].second;
+        if ((i == 0) || (sorted_points[i].first != sorted_points[i-1].first))
+          {
+            cells.push_back (cell_points[point].first);
+            cell_start.push_back (i);
+          }
+        point_indices[i] = point;
+        unit_points[point] = cell_points[point].second;
+      }
+    cell_start.push_back (points.size());
+
+    // finally evaluate the function on the cells in parallel. each task
+    // writes to the values of different points
+    parallel::apply_to_subranges (0U, cells.size(),
+                                  std_cxx1x::bind (&internal::PointValues::
+                                                   evaluate_on_cells<dim,InVector,spacedim>,
+                                                   std_cxx1x::_1, std_cxx1x::_2,
+                                                   std_cxx1x::cref (cell_locator.get_mapping()),
+                                                   std_cxx1x::cref (fe_function),
+                                                   std_cxx1x::cref (cells),
+                                                   std_cxx1x::cref (cell_start),
+                                                   std_cxx1x::cref (point_indices),
+                                                   std_cxx1x::cref (unit_points),
+                                                   std_cxx1x::ref (values)),
+                                  16);
+  }
+
+
+
+  template <int dim, class InVector, int spacedim>
+  void
+  point_values (const Mapping<dim,spacedim>      &mapping,
+                const DoFHandler<dim,spacedim>   &dof,
+                const InVector                   &fe_function,
+                const std::vector<Point<spacedim> > &points,
+                std::vector<Vector<double> >     &values)
+  {
+    const CellLocator<DoFHandler<dim,spacedim> > cell_locator (dof, mapping);
+    point_values (cell_locator, fe_function, points, values);
+  }
+
+
+
+  template <int dim, class InVector, int spacedim>
+  void
+  point_values (const DoFHandler<dim,spacedim>   &dof,
+                const InVector                   &fe_function,
+                const std::vector<Point<spacedim> > &points,
+                std::vector<Vector<double> >     &values)
+  {
+    point_values (StaticMappingQ1<dim,spacedim>::mapping,
+                  dof,
+                  fe_function,
+                  points,
+                  values);
+  }
+
+
+
   template <class VECTOR>
   void
   subtract_mean_value(VECTOR                  &v,
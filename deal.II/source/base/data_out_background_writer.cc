@@ -0,0 +1,223 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/data_out_background_writer.h>
+#include <deal.II/base/memory_consumption.h>
+
+#include <fstream>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, int spacedim>
+DataOutBackgroundWriter<dim,spacedim>::QueuedFile::
+QueuedFile (const DataOutInterface<dim,spacedim> &data_out,
+            const std::string                    &filename,
+            const DataOutBase::OutputFormat       output_format)
+  :
+  DataOutInterface<dim,spacedim> (data_out),
+  filename (filename),
+  output_format (output_format),
+  memory (0)
+{}
+
+
+
+template <int dim, int spacedim>
+const std::vector<DataOutBase::Patch<dim,spacedim> > &
+DataOutBackgroundWriter<dim,spacedim>::QueuedFile::get_patches () const
+{
+  return patches;
+}
+
+
+
+template <int dim, int spacedim>
+std::vector<std::string>
+DataOutBackgroundWriter<dim,spacedim>::QueuedFile::get_dataset_names () const
+{
+  return dataset_names;
+}
+
+
+
+template <int dim, int spacedim>
+std::vector<std_cxx1x::tuple<unsigned int, unsigned int, std::string> >
+DataOutBackgroundWriter<dim,spacedim>::QueuedFile::get_vector_data_ranges () const
+{
+  return vector_data_ranges;
+}
+
+
+
+template <int dim, int spacedim>
+DataOutBackgroundWriter<dim,spacedim>::
+DataOutBackgroundWriter (const std::size_t max_queued_memory)
+  :
+  max_queued_memory (max_queued_memory),
+  queued_memory (0),
+  writer_is_running (false)
+{}
+
+
+
+template <int dim, int spacedim>
+DataOutBackgroundWriter<dim,spacedim>::~DataOutBackgroundWriter ()
+{
+  // wait for all files to be written. we can't throw exceptions from a
+  // destructor, so errors go unreported here
+  try
+    {
+      wait ();
+    }
+  catch (...)
+    {}
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutBackgroundWriter<dim,spacedim>::
+write (DataOutInterface<dim,spacedim> &data_out,
+       const std::string              &filename,
+       const DataOutBase::OutputFormat output_format)
+{
+  // take over the data while the caller waits, since the object may be
+  // modified or destroyed as soon as we return
+  std_cxx1x::shared_ptr<QueuedFile> file (new QueuedFile (data_out, filename,
+                                                          output_format));
+  data_out.release_patches (file->patches);
+  file->dataset_names      = data_out.get_dataset_names ();
+  file->vector_data_ranges = data_out.get_vector_data_ranges ();
+  file->memory             = MemoryConsumption::memory_consumption (file->patches);
+
+  {
+    Threads::Mutex::ScopedLock lock (mutex);
+
+    // wait until the writer thread has made enough room for the new
+    // patches, unless there is nothing left to write
+    while ((queue.size() > 0)
+           &&
+           (queued_memory + file->memory > max_queued_memory))
+      file_written.wait (mutex);
+
+    queue.push_back (file);
+    queued_memory += file->memory;
+
+    if (writer_is_running)
+      return;
+    writer_is_running = true;
+  }
+
+  // start a new writer thread. a previous one has already taken its last
+  // file from the queue, but may not have returned yet
+  writer_thread.join ();
+  writer_thread
+    = Threads::new_thread (&DataOutBackgroundWriter<dim,spacedim>::write_queued_files,
+                           *this);
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutBackgroundWriter<dim,spacedim>::wait ()
+{
+  {
+    Threads::Mutex::ScopedLock lock (mutex);
+    while (writer_is_running)
+      file_written.wait (mutex);
+  }
+  writer_thread.join ();
+
+  Threads::Mutex::ScopedLock lock (mutex);
+  if (errors.size() > 0)
+    {
+      const std::pair<std::string,std::string> error = errors.front();
+      errors.clear ();
+      AssertThrow (false, ExcWriteFailed (error.first, error.second));
+    }
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+DataOutBackgroundWriter<dim,spacedim>::n_queued_files () const
+{
+  Threads::Mutex::ScopedLock lock (mutex);
+  return queue.size();
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutBackgroundWriter<dim,spacedim>::write_queued_files ()
+{
+  while (true)
+    {
+      // get the next file to write, or stop if there is none. files are
+      // only removed from the queue once they are written so that their
+      // memory keeps being accounted for
+      mutex.acquire ();
+      if (queue.size() == 0)
+        {
+          writer_is_running = false;
+          file_written.broadcast ();
+          mutex.release ();
+          return;
+        }
+      const std_cxx1x::shared_ptr<QueuedFile> file = queue.front();
+      mutex.release ();
+
+      // write the file without holding the lock, and record errors
+      // instead of letting exceptions escape from the thread
+      std::string error;
+      try
+        {
+          std::ofstream out (file->filename.c_str());
+          AssertThrow (out, ExcFileNotOpen (file->filename.c_str()));
+          file->write (out, file->output_format);
+          out.close ();
+          AssertThrow (out, ExcIO());
+        }
+      catch (const std::exception &exc)
+        {
+          error = exc.what();
+        }
+      catch (...)
+        {
+          error = "unknown exception";
+        }
+
+      mutex.acquire ();
+      if (error != "")
+        errors.push_back (std::make_pair (file->filename, error));
+      queue.pop_front ();
+      queued_memory -= file->memory;
+      file_written.broadcast ();
+      mutex.release ();
+    }
+}
+
+
+// explicit instantiations
+#include "data_out_background_writer.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
@@ -36,6 +36,8 @@
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/thread_management.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx1x/bind.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/std_cxx1x/shared_ptr.h>
 #include <deal.II/base/mpi.h>
@@ -223,6 +225,125 @@ namespace
 
 
 #ifdef DEAL_II_WITH_ZLIB
+  /**
+   * The size, in bytes, of the blocks into which data arrays are split
+   * before compression. Each block is compressed independently of the
+   * others, which allows compressing several of them in parallel. This
+   * is the block size VTK uses itself.
+   */
+  const std::size_t compression_block_size = 32768;
+
+
+  /**
+   * Convert the compression level given in the VtkFlags into the
+   * corresponding zlib constant.
+   */
+  int
+  get_zlib_compression_level (const DataOutBase::VtkFlags::ZlibCompressionLevel level)
+  {
+    switch (level)
+      {
+      case DataOutBase::VtkFlags::no_compression:
+        return Z_NO_COMPRESSION;
+      case DataOutBase::VtkFlags::best_speed:
+        return Z_BEST_SPEED;
+      case DataOutBase::VtkFlags::best_compression:
+        return Z_BEST_COMPRESSION;
+      case DataOutBase::VtkFlags::default_compression:
+        return Z_DEFAULT_COMPRESSION;
+      default:
+        Assert (false, ExcNotImplemented());
+        return Z_NO_COMPRESSION;
+      }
+  }
+
+
+  /**
+   * Compress the blocks with numbers <tt>[begin,end)</tt> of the given
+   * data, which is split into blocks of size @p block_size, and store
+   * the results in the corresponding elements of @p compressed_blocks.
+   */
+  void compress_blocks (const unsigned int               begin,
+                        const unsigned int               end,
+                        const char                      *data,
+                        const std::size_t                data_size,
+                        const std::size_t                block_size,
+                        const int                        compression_level,
+                        std::vector<std::vector<char> > &compressed_blocks)
+  {
+    for (unsigned int block=begin; block<end; ++block)
+      {
+        const std::size_t offset = block * block_size;
+        const uLong block_length = std::min (block_size, data_size - offset);
+
+        uLongf compressed_length = compressBound (block_length);
+        compressed_blocks[block].resize (compressed_length);
+        const int err = compress2 ((Bytef *) &compressed_blocks[block][0],
+                                   &compressed_length,
+                                   (const Bytef *) (data + offset),
+                                   block_length,
+                                   compression_level);
+        Assert (err == Z_OK, ExcInternalError());
+        (void)err;
+        compressed_blocks[block].resize (compressed_length);
+      }
+  }
+
+
+  /**
+   * Do a zlib compression of the given data in the multi-block format
+   * VTK expects: the data is split into blocks that are compressed
+   * independently (and in parallel), and the header lists the number of
+   * blocks, the uncompressed size of the blocks and of the last block,
+   * and the compressed size of each block. The compressed blocks are
+   * returned one after the other in @p compressed_data.
+   */
+  template <typename T>
+  void compress_data_array (const std::vector<T> &data,
+                            const DataOutBase::VtkFlags::ZlibCompressionLevel level,
+                            std::vector<uint32_t> &header,
+                            std::vector<char>     &compressed_data)
+  {
+    header.clear ();
+    compressed_data.clear ();
+    if (data.size() == 0)
+      return;
+
+    const std::size_t data_size  = data.size() * sizeof(T);
+    const std::size_t block_size = std::min (compression_block_size, data_size);
+    const unsigned int n_blocks  = (data_size + block_size - 1) / block_size;
+
+    std::vector<std::vector<char> > compressed_blocks (n_blocks);
+    parallel::apply_to_subranges (0U, n_blocks,
+                                  std_cxx1x::bind (&compress_blocks,
+                                                   std_cxx1x::_1,
+                                                   std_cxx1x::_2,
+                                                   reinterpret_cast<const char *>(&data[0]),
+                                                   data_size,
+                                                   block_size,
+                                                   get_zlib_compression_level (level),
+                                                   std_cxx1x::ref (compressed_blocks)),
+                                  4);
+
+    header.resize (3 + n_blocks);
+    header[0] = n_blocks;
+    header[1] = block_size;
+    header[2] = data_size - (n_blocks-1) * block_size;
+    std::size_t compressed_size = 0;
+    for (unsigned int block=0; block<n_blocks; ++block)
+      {
+        header[3+block] = compressed_blocks[block].size();
+        compressed_size += compressed_blocks[block].size();
+      }
+
+    compressed_data.reserve (compressed_size);
+    for (unsigned int block=0; block<n_blocks; ++block)
+      compressed_data.insert (compressed_data.end(),
+                              compressed_blocks[block].begin(),
+                              compressed_blocks[block].end());
+  }
+
+
   /**
    * Do a zlib compression followed
    * by a base64 encoding of the
@@ -231,45 +352,56 @@ namespace
    */
   template <typename T>
   void write_compressed_block (const std::vector<T> &data,
+                               const DataOutBase::VtkFlags::ZlibCompressionLevel level,
                                std::ostream         &output_stream)
   {
     if (data.size() != 0)
       {
-        // allocate a buffer for compressing
-        // data and do so
-        uLongf compressed_data_length
-          = compressBound (data.size() * sizeof(T));
-        char *compressed_data = new char[compressed_data_length];
-        int err = compress2 ((Bytef *) compressed_data,
-                             &compressed_data_length,
-                             (const Bytef *) &data[0],
-                             data.size() * sizeof(T),
-                             Z_BEST_COMPRESSION);
-        Assert (err == Z_OK, ExcInternalError());
-
-        // now encode the compression header
-        const uint32_t compression_header[4]
-          = { 1,                                   /* number of blocks */
-              (uint32_t)(data.size() * sizeof(T)), /* size of block */
-              (uint32_t)(data.size() * sizeof(T)), /* size of last block */
-              (uint32_t)compressed_data_length
-            }; /* list of compressed sizes of blocks */
+        std::vector<uint32_t> compression_header;
+        std::vector<char>     compressed_data;
+        compress_data_array (data, level, compression_header, compressed_data);
 
+        // header and data are encoded
+        // separately
         char *encoded_header = encode_block ((char *)&compression_header[0],
-                                             4 * sizeof(compression_header[0]));
+                                             compression_header.size() * sizeof(compression_header[0]));
         output_stream << encoded_header;
         delete[] encoded_header;
 
-        // next do the compressed
-        // data encoding in base64
-        char *encoded_data = encode_block (compressed_data,
-                                           compressed_data_length);
-        delete[] compressed_data;
-
+        char *encoded_data = encode_block (&compressed_data[0],
+                                           compressed_data.size());
         output_stream << encoded_data;
         delete[] encoded_data;
       }
   }
+
+
+  /**
+   * Do a zlib compression of the given data and append the compression
+   * header and the compressed data in raw binary form to
+   * @p appended_data, as is needed for the appended data section of VTU
+   * files.
+   */
+  template <typename T>
+  void append_compressed_block (const std::vector<T> &data,
+                                const DataOutBase::VtkFlags::ZlibCompressionLevel level,
+                                std::vector<char>    &appended_data)
+  {
+    if (data.size() != 0)
+      {
+        std::vector<uint32_t> compression_header;
+        std::vector<char>     compressed_data;
+        compress_data_array (data, level, compression_header, compressed_data);
+
+        const char *header_begin = reinterpret_cast<const char *>(&compression_header[0]);
+        appended_data.insert (appended_data.end(),
+                              header_begin,
+                              header_begin + compression_header.size() * sizeof(compression_header[0]));
+        appended_data.insert (appended_data.end(),
+                              compressed_data.begin(),
+                              compressed_data.end());
+      }
+  }
 #endif
 }
 
@@ -419,6 +551,52 @@ namespace DataOutBase
         Assert (data_vectors[data_set].size() == next_value,
                 ExcInternalError());
     }
+
+
+
+    /**
+     * Round the given value to the nearest multiple of the largest
+     * power of two that does not exceed twice the given tolerance, so
+     * that the result differs from the value by at most the
+     * tolerance. Since the step is a power of two, the result is
+     * computed exactly and has only few significant bits; the zero bits
+     * at the end of its mantissa are what makes it compress well. A
+     * tolerance of zero leaves the value unchanged.
+     */
+    double
+    quantize_value (const double value,
+                    const double tolerance)
+    {
+      if (tolerance <= 0)
+        return value;
+
+      int exponent;
+      std::frexp (2*tolerance, &exponent);
+      const double step = std::ldexp (1., exponent-1);
+      return std::floor (value/step + 0.5) * step;
+    }
+
+
+
+    /**
+     * Apply quantize_value() to all values of each data set, with the
+     * tolerance given for this data set. An empty list of tolerances
+     * leaves all data unchanged.
+     */
+    void
+    quantize_data_vectors (const std::vector<double> &tolerances,
+                           Table<2,double>           &data_vectors)
+    {
+      if (tolerances.size() == 0)
+        return;
+
+      AssertDimension (tolerances.size(), data_vectors.size()[0]);
+      for (unsigned int data_set=0; data_set<tolerances.size(); ++data_set)
+        if (tolerances[data_set] > 0)
+          for (unsigned int i=0; i<data_vectors.size()[1]; ++i)
+            data_vectors[data_set][i] = quantize_value (data_vectors[data_set][i],
+                                                        tolerances[data_set]);
+    }
   }
 }
 
@@ -426,57 +604,117 @@ namespace DataOutBase
 // DataOutFilter class member functions
 //----------------------------------------------------------------------//
 
+namespace
+{
+  /**
+   * Return a hash value for a point, for use in the hash table of
+   * DataOutFilter. Points that compare equal have the same hash value.
+   */
+  uint64_t hash_point (const Point<3> &p)
+  {
+    uint64_t hash = 0;
+    for (unsigned int d=0; d<3; ++d)
+      {
+        // adding zero turns -0. into +0., which compare equal but have
+        // different bit patterns
+        const double coordinate = p(d) + 0.;
+        uint64_t bits;
+        std::memcpy (&bits, &coordinate, sizeof(bits));
+
+        hash ^= bits + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+      }
+    // mix the bits so that the lower ones, which are used to index the
+    // table, depend on all bits of the coordinates
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+}
+
+
+unsigned int DataOutBase::DataOutFilter::internal_add_point(const Point<3> &p)
+{
+  if (!flags.filter_duplicate_vertices)
+    {
+      existing_points.push_back(p);
+      return existing_points.size()-1;
+    }
+
+  // Grow the table if it would become more than half full, and reinsert
+  // the points recorded so far
+  if (2*(existing_points.size()+1) > point_hash_table.size())
+    {
+      std::vector<unsigned int> new_table(std::max<std::size_t>(16, 2*point_hash_table.size()),
+                                          numbers::invalid_unsigned_int);
+      const uint64_t mask = new_table.size()-1;
+      for (unsigned int i=0; i<existing_points.size(); ++i)
+        {
+          uint64_t slot = hash_point(existing_points[i]) & mask;
+          while (new_table[slot] != numbers::invalid_unsigned_int)
+            slot = (slot+1) & mask;
+          new_table[slot] = i;
+        }
+      point_hash_table.swap(new_table);
+    }
+
+  // Look for the point, and record it in the first empty slot if it
+  // isn't there yet
+  const uint64_t mask = point_hash_table.size()-1;
+  uint64_t slot = hash_point(p) & mask;
+  while (point_hash_table[slot] != numbers::invalid_unsigned_int)
+    {
+      if (existing_points[point_hash_table[slot]] == p)
+        return point_hash_table[slot];
+      slot = (slot+1) & mask;
+    }
+
+  point_hash_table[slot] = existing_points.size();
+  existing_points.push_back(p);
+  return existing_points.size()-1;
+}
+
 template<int dim>
 void DataOutBase::DataOutFilter::write_point(const unsigned int &index, const Point<dim> &p)
 {
-  Map3DPoint::const_iterator  it;
-  unsigned int      internal_ind;
   Point<3>      int_pt;
 
   for (int d=0; d<3; ++d) int_pt(d) = (d < dim ? p(d) : 0);
   node_dim = dim;
-  it = existing_points.find(int_pt);
 
-  // If the point isn't in the set, or we're not filtering duplicate points, add it
-  if (it == existing_points.end() || !flags.filter_duplicate_vertices)
-    {
-      internal_ind = existing_points.size();
-      existing_points.insert(std::make_pair(int_pt, internal_ind));
-    }
-  else
-    {
-      internal_ind = it->second;
-    }
   // Now add the index to the list of filtered points
-  filtered_points[index] = internal_ind;
+  if (index >= filtered_points.size())
+    filtered_points.resize(index+1, numbers::invalid_unsigned_int);
+  filtered_points[index] = internal_add_point(int_pt);
 }
 
 void DataOutBase::DataOutFilter::internal_add_cell(const unsigned int &cell_index, const unsigned int &pt_index)
 {
+  Assert (pt_index < filtered_points.size(),
+          ExcIndexRange (pt_index, 0, filtered_points.size()));
+
+  if (cell_index >= filtered_cells.size())
+    filtered_cells.resize(cell_index+1);
   filtered_cells[cell_index] = filtered_points[pt_index];
 }
 
 void DataOutBase::DataOutFilter::fill_node_data(std::vector<double> &node_data) const
 {
-  Map3DPoint::const_iterator  it;
-
   node_data.resize(existing_points.size()*node_dim);
 
-  for (it=existing_points.begin(); it!=existing_points.end(); ++it)
+  for (unsigned int i=0; i<existing_points.size(); ++i)
     {
-      for (int d=0; d<node_dim; ++d) node_data[node_dim*it->second+d] = it->first(d);
+      for (int d=0; d<node_dim; ++d) node_data[node_dim*i+d] = existing_points[i](d);
     }
 }
 
 void DataOutBase::DataOutFilter::fill_cell_data(const unsigned int &local_node_offset, std::vector<unsigned int> &cell_data) const
 {
-  std::map<unsigned int, unsigned int>::const_iterator  it;
-
   cell_data.resize(filtered_cells.size());
 
-  for (it=filtered_cells.begin(); it!=filtered_cells.end(); ++it)
+  for (unsigned int i=0; i<filtered_cells.size(); ++i)
     {
-      cell_data[it->first] = it->second+local_node_offset;
+      cell_data[i] = filtered_cells[i]+local_node_offset;
     }
 }
 
@@ -527,7 +765,14 @@ void DataOutBase::DataOutFilter::write_data_set(const std::string &name, const u
       for (d=0; d<new_dim; ++d)
         {
           r = filtered_points[i];
-          if (d < dimension) data_sets.back()[r*new_dim+d] = data_vectors(set_num+d, i);
+          if (d < dimension)
+            data_sets.back()[r*new_dim+d]
+              = (flags.data_tolerances.size() == 0
+                 ?
+                 data_vectors(set_num+d, i)
+                 :
+                 quantize_value (data_vectors(set_num+d, i),
+                                 flags.data_tolerances[set_num+d]));
           else data_sets.back()[r*new_dim+d] = 0;
         }
     }
@@ -1197,13 +1442,36 @@ namespace
      * configuration, this operator
      * compresses and encodes the
      * entire data
-     * block. Otherwise, it simply
-     * writes it element by
-     * element.
+     * block, or appends it to the
+     * data that will later be
+     * written by
+     * write_appended_data(). Otherwise,
+     * it simply writes it element
+     * by element.
      */
     template <typename T>
     std::ostream &operator<< (const std::vector<T> &);
 
+    /**
+     * Return the <tt>format</tt>
+     * attribute, and in case of
+     * appended data the
+     * <tt>offset</tt> attribute, of
+     * the next data array that is
+     * written through this object.
+     */
+    std::string data_array_format () const;
+
+    /**
+     * Write the
+     * <tt>AppendedData</tt> section
+     * holding all the data arrays
+     * written so far, if data is
+     * appended rather than written
+     * inline.
+     */
+    void write_appended_data ();
+
   private:
     /**
      * The ostream to use. Since
@@ -1233,6 +1501,14 @@ namespace
      */
     std::vector<double>  vertices;
     std::vector<int32_t> cells;
+
+    /**
+     * The data arrays written so
+     * far in raw binary form, if
+     * VtkFlags::write_appended_raw_data
+     * is set.
+     */
+    std::vector<char> appended_data;
   };
 
 
@@ -1722,8 +1998,11 @@ namespace
 #ifdef DEAL_II_WITH_ZLIB
     // compress the data we have in
     // memory and write them to the
-    // stream. then release the data
-    write_compressed_block (data, stream);
+    // stream or the appended data
+    if (flags.write_appended_raw_data)
+      append_compressed_block (data, flags.compression_level, appended_data);
+    else
+      write_compressed_block (data, flags.compression_level, stream);
 #else
     for (unsigned int i=0; i<data.size(); ++i)
       stream << data[i] << ' ';
@@ -1732,6 +2011,44 @@ namespace
     return stream;
   }
 
+
+
+  std::string
+  VtuStream::data_array_format () const
+  {
+#ifdef DEAL_II_WITH_ZLIB
+    if (flags.write_appended_raw_data)
+      {
+        std::ostringstream format;
+        format << "format=\"appended\" offset=\"" << appended_data.size() << "\"";
+        return format.str();
+      }
+    else
+      return "format=\"binary\"";
+#else
+    return "format=\"ascii\"";
+#endif
+  }
+
+
+
+  void
+  VtuStream::write_appended_data ()
+  {
+#ifdef DEAL_II_WITH_ZLIB
+    if (flags.write_appended_raw_data)
+      {
+        // the data starts right
+        // after the underscore
+        stream << " <AppendedData encoding=\"raw\">\n_";
+        if (appended_data.size() != 0)
+          stream.write (&appended_data[0], appended_data.size());
+        stream << "\n </AppendedData>\n";
+        std::vector<char>().swap (appended_data);
+      }
+#endif
+  }
+
   template <typename T>
   std::ostream &
   DXStream::operator<< (const T &t)
@@ -2392,11 +2709,15 @@ namespace DataOutBase
 
   VtkFlags::VtkFlags (const double time,
                       const unsigned int cycle,
-                      const bool print_date_and_time)
+                      const bool print_date_and_time,
+                      const VtkFlags::ZlibCompressionLevel compression_level,
+                      const bool write_appended_raw_data)
     :
     time (time),
     cycle (cycle),
-    print_date_and_time (print_date_and_time)
+    print_date_and_time (print_date_and_time),
+    compression_level (compression_level),
+    write_appended_raw_data (write_appended_raw_data)
   {}
 
 
@@ -2420,20 +2741,27 @@ namespace DataOutBase
   }
 
 
-  Deal_II_IntermediateFlags::Deal_II_IntermediateFlags ()
+  Deal_II_IntermediateFlags::Deal_II_IntermediateFlags (const bool binary)
     :
-    dummy (0)
+    binary (binary)
   {}
 
 
 
-  void Deal_II_IntermediateFlags::declare_parameters (ParameterHandler &/*prm*/)
-  {}
+  void Deal_II_IntermediateFlags::declare_parameters (ParameterHandler &prm)
+  {
+    prm.declare_entry ("Binary", "false",
+                       Patterns::Bool(),
+                       "Whether the patches are written in binary rather "
+                       "than as text");
+  }
 
 
 
-  void Deal_II_IntermediateFlags::parse_parameters (const ParameterHandler &/*prm*/) const
-  {}
+  void Deal_II_IntermediateFlags::parse_parameters (const ParameterHandler &prm)
+  {
+    binary = prm.get_bool ("Binary");
+  }
 
 
   std::size_t
@@ -5394,6 +5722,23 @@ namespace DataOutBase
 
 
 
+  namespace
+  {
+    /**
+     * Write the main part of a VTU file, i.e. the <tt>Piece</tt>
+     * element, through the given VtuStream object.
+     */
+    template <int dim, int spacedim>
+    void write_vtu_piece (const std::vector<Patch<dim,spacedim> > &patches,
+                          const std::vector<std::string>          &data_names,
+                          const std::vector<std_cxx1x::tuple<unsigned int, unsigned int, std::string> > &vector_data_ranges,
+                          const VtkFlags                          &flags,
+                          VtuStream                               &vtu_out,
+                          std::ostream                            &out);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   write_vtu (const std::vector<Patch<dim,spacedim> > &patches,
@@ -5403,8 +5748,25 @@ namespace DataOutBase
              std::ostream                            &out)
   {
     write_vtu_header(out, flags);
-    write_vtu_main (patches, data_names, vector_data_ranges, flags, out);
-    write_vtu_footer(out);
+    if (flags.write_appended_raw_data)
+      {
+        // the appended data has to be
+        // placed after the
+        // UnstructuredGrid element, so
+        // we can't use
+        // write_vtu_footer here
+        VtuStream vtu_out(out, flags);
+        write_vtu_piece (patches, data_names, vector_data_ranges, flags,
+                         vtu_out, out);
+        out << " </UnstructuredGrid>\n";
+        vtu_out.write_appended_data ();
+        out << "</VTKFile>\n";
+      }
+    else
+      {
+        write_vtu_main (patches, data_names, vector_data_ranges, flags, out);
+        write_vtu_footer(out);
+      }
 
     out << std::flush;
   }
@@ -5417,365 +5779,382 @@ namespace DataOutBase
                        const VtkFlags                          &flags,
                        std::ostream                            &out)
   {
-    AssertThrow (out, ExcIO());
+    // we only write a part of the
+    // file here and don't know where
+    // an appended data section would
+    // go, so always write data inline
+    VtkFlags inline_flags = flags;
+    inline_flags.write_appended_raw_data = false;
+
+    VtuStream vtu_out(out, inline_flags);
+    write_vtu_piece (patches, data_names, vector_data_ranges, inline_flags,
+                     vtu_out, out);
+  }
 
-#ifndef DEAL_II_WITH_MPI
-    // verify that there are indeed
-    // patches to be written out. most
-    // of the times, people just forget
-    // to call build_patches when there
-    // are no patches, so a warning is
-    // in order. that said, the
-    // assertion is disabled if we
-    // support MPI since then it can
-    // happen that on the coarsest
-    // mesh, a processor simply has no
-    // cells it actually owns, and in
-    // that case it is legit if there
-    // are no patches
-    Assert (patches.size() > 0, ExcNoPatches());
-#else
-    if (patches.size() == 0)
-      {
-        // we still need to output a valid vtu file, because other CPUs
-        // might output data. This is the minimal file that is accepted by paraview and visit.
-        // if we remove the field definitions, visit is complaining.
-        out << "<Piece NumberOfPoints=\"0\" NumberOfCells=\"0\" >\n"
-            << "<Cells>\n"
-            << "<DataArray type=\"UInt8\" Name=\"types\"></DataArray>\n"
-            << "</Cells>\n"
-            << "  <PointData Scalars=\"scalars\">\n";
-        std::vector<bool> data_set_written (data_names.size(), false);
-        for (unsigned int n_th_vector=0; n_th_vector<vector_data_ranges.size(); ++n_th_vector)
-          {
-            // mark these components as already
-            // written:
-            for (unsigned int i=std_cxx1x::get<0>(vector_data_ranges[n_th_vector]);
-                 i<=std_cxx1x::get<1>(vector_data_ranges[n_th_vector]);
-                 ++i)
-              data_set_written[i] = true;
 
-            // write the
-            // header. concatenate all the
-            // component names with double
-            // underscores unless a vector
-            // name has been specified
-            out << "    <DataArray type=\"Float64\" Name=\"";
 
-            if (std_cxx1x::get<2>(vector_data_ranges[n_th_vector]) != "")
-              out << std_cxx1x::get<2>(vector_data_ranges[n_th_vector]);
-            else
+  namespace
+  {
+    template <int dim, int spacedim>
+    void write_vtu_piece (const std::vector<Patch<dim,spacedim> > &patches,
+                          const std::vector<std::string>          &data_names,
+                          const std::vector<std_cxx1x::tuple<unsigned int, unsigned int, std::string> > &vector_data_ranges,
+                          const VtkFlags                          &flags,
+                          VtuStream                               &vtu_out,
+                          std::ostream                            &out)
+    {
+      AssertThrow (out, ExcIO());
+
+  #ifndef DEAL_II_WITH_MPI
+      // verify that there are indeed
+      // patches to be written out. most
+      // of the times, people just forget
+      // to call build_patches when there
+      // are no patches, so a warning is
+      // in order. that said, the
+      // assertion is disabled if we
+      // support MPI since then it can
+      // happen that on the coarsest
+      // mesh, a processor simply has no
+      // cells it actually owns, and in
+      // that case it is legit if there
+      // are no patches
+      Assert (patches.size() > 0, ExcNoPatches());
+  #else
+      if (patches.size() == 0)
+        {
+          // we still need to output a valid vtu file, because other CPUs
+          // might output data. This is the minimal file that is accepted by paraview and visit.
+          // if we remove the field definitions, visit is complaining.
+          out << "<Piece NumberOfPoints=\"0\" NumberOfCells=\"0\" >\n"
+              << "<Cells>\n"
+              << "<DataArray type=\"UInt8\" Name=\"types\"></DataArray>\n"
+              << "</Cells>\n"
+              << "  <PointData Scalars=\"scalars\">\n";
+          std::vector<bool> data_set_written (data_names.size(), false);
+          for (unsigned int n_th_vector=0; n_th_vector<vector_data_ranges.size(); ++n_th_vector)
+            {
+              // mark these components as already
+              // written:
+              for (unsigned int i=std_cxx1x::get<0>(vector_data_ranges[n_th_vector]);
+                   i<=std_cxx1x::get<1>(vector_data_ranges[n_th_vector]);
+                   ++i)
+                data_set_written[i] = true;
+
+              // write the
+              // header. concatenate all the
+              // component names with double
+              // underscores unless a vector
+              // name has been specified
+              out << "    <DataArray type=\"Float64\" Name=\"";
+
+              if (std_cxx1x::get<2>(vector_data_ranges[n_th_vector]) != "")
+                out << std_cxx1x::get<2>(vector_data_ranges[n_th_vector]);
+              else
+                {
+                  for (unsigned int i=std_cxx1x::get<0>(vector_data_ranges[n_th_vector]);
+                       i<std_cxx1x::get<1>(vector_data_ranges[n_th_vector]);
+                       ++i)
+                    out << data_names[i] << "__";
+                  out << data_names[std_cxx1x::get<1>(vector_data_ranges[n_th_vector])];
+                }
+
+              out << "\" NumberOfComponents=\"3\"></DataArray>\n";
+            }
+
+          for (unsigned int data_set=0; data_set<data_names.size(); ++data_set)
+            if (data_set_written[data_set] == false)
               {
-                for (unsigned int i=std_cxx1x::get<0>(vector_data_ranges[n_th_vector]);
-                     i<std_cxx1x::get<1>(vector_data_ranges[n_th_vector]);
-                     ++i)
-                  out << data_names[i] << "__";
-                out << data_names[std_cxx1x::get<1>(vector_data_ranges[n_th_vector])];
+                out << "    <DataArray type=\"Float64\" Name=\""
+                    << data_names[data_set]
+                    << "\"></DataArray>\n";
               }
 
-            out << "\" NumberOfComponents=\"3\"></DataArray>\n";
-          }
+          out << "  </PointData>\n";
+          out << "</Piece>\n";
 
-        for (unsigned int data_set=0; data_set<data_names.size(); ++data_set)
-          if (data_set_written[data_set] == false)
-            {
-              out << "    <DataArray type=\"Float64\" Name=\""
-                  << data_names[data_set]
-                  << "\"></DataArray>\n";
-            }
+          out << std::flush;
 
-        out << "  </PointData>\n";
-        out << "</Piece>\n";
+          return;
+        }
+  #endif
 
-        out << std::flush;
+      // first up: metadata
+      //
+      // if desired, output time and cycle of the simulation, following
+      // the instructions at
+      // http://www.visitusers.org/index.php?title=Time_and_Cycle_in_VTK_files
+      {
+        const unsigned int
+        n_metadata = ((flags.cycle != std::numeric_limits<unsigned int>::min() ? 1 : 0)
+                      +
+                      (flags.time != std::numeric_limits<double>::min() ? 1 : 0));
+        if (n_metadata > 0)
+          out << "<FieldData>\n";
+
+        if (flags.cycle != std::numeric_limits<unsigned int>::min())
+          {
+            out << "<DataArray type=\"Float32\" Name=\"CYCLE\" NumberOfTuples=\"1\" format=\"ascii\">"
+                << flags.cycle
+                << "</DataArray>\n";
+          }
+        if (flags.time != std::numeric_limits<double>::min())
+          {
+            out << "<DataArray type=\"Float32\" Name=\"TIME\" NumberOfTuples=\"1\" format=\"ascii\">"
+                << flags.time
+                << "</DataArray>\n";
+          }
 
-        return;
+        if (n_metadata > 0)
+          out << "</FieldData>\n";
       }
-#endif
 
-    // first up: metadata
-    //
-    // if desired, output time and cycle of the simulation, following
-    // the instructions at
-    // http://www.visitusers.org/index.php?title=Time_and_Cycle_in_VTK_files
-    {
-      const unsigned int
-      n_metadata = ((flags.cycle != std::numeric_limits<unsigned int>::min() ? 1 : 0)
-                    +
-                    (flags.time != std::numeric_limits<double>::min() ? 1 : 0));
-      if (n_metadata > 0)
-        out << "<FieldData>\n";
 
-      if (flags.cycle != std::numeric_limits<unsigned int>::min())
-        {
-          out << "<DataArray type=\"Float32\" Name=\"CYCLE\" NumberOfTuples=\"1\" format=\"ascii\">"
-              << flags.cycle
-              << "</DataArray>\n";
-        }
-      if (flags.time != std::numeric_limits<double>::min())
-        {
-          out << "<DataArray type=\"Float32\" Name=\"TIME\" NumberOfTuples=\"1\" format=\"ascii\">"
-              << flags.time
-              << "</DataArray>\n";
-        }
+      const unsigned int n_data_sets = data_names.size();
+      // check against # of data sets in
+      // first patch. checks against all
+      // other patches are made in
+      // write_gmv_reorder_data_vectors
+      Assert ((patches[0].data.n_rows() == n_data_sets && !patches[0].points_are_available) ||
+              (patches[0].data.n_rows() == n_data_sets+spacedim && patches[0].points_are_available),
+              ExcDimensionMismatch (patches[0].points_are_available
+                                    ?
+                                    (n_data_sets + spacedim)
+                                    :
+                                    n_data_sets,
+                                    patches[0].data.n_rows()));
 
-      if (n_metadata > 0)
-        out << "</FieldData>\n";
-    }
 
+      // first count the number of cells
+      // and cells for later use
+      unsigned int n_nodes;
+      unsigned int n_cells;
+      compute_sizes<dim,spacedim>(patches, n_nodes, n_cells);
+      // in gmv format the vertex
+      // coordinates and the data have an
+      // order that is a bit unpleasant
+      // (first all x coordinates, then
+      // all y coordinate, ...; first all
+      // data of variable 1, then
+      // variable 2, etc), so we have to
+      // copy the data vectors a bit around
+      //
+      // note that we copy vectors when
+      // looping over the patches since we
+      // have to write them one variable
+      // at a time and don't want to use
+      // more than one loop
+      //
+      // this copying of data vectors can
+      // be done while we already output
+      // the vertices, so do this on a
+      // separate task and when wanting
+      // to write out the data, we wait
+      // for that task to finish
+      Table<2,double> data_vectors (n_data_sets, n_nodes);
+
+      void (*fun_ptr) (const std::vector<Patch<dim,spacedim> > &,
+                       Table<2,double> &)
+        = &write_gmv_reorder_data_vectors<dim,spacedim>;
+      Threads::Task<> reorder_task = Threads::new_task (fun_ptr, patches,
+                                                        data_vectors);
+
+      ///////////////////////////////
+      // first make up a list of used
+      // vertices along with their
+      // coordinates
+      //
+      // note that according to the standard, we
+      // have to print d=1..3 dimensions, even if
+      // we are in reality in 2d, for example
+      out << "<Piece NumberOfPoints=\"" << n_nodes
+          <<"\" NumberOfCells=\"" << n_cells << "\" >\n";
+      out << "  <Points>\n";
+      out << "    <DataArray type=\"Float64\" NumberOfComponents=\"3\" "
+          << vtu_out.data_array_format() << ">\n";
+      write_nodes(patches, vtu_out);
+      out << "    </DataArray>\n";
+      out << "  </Points>\n\n";
+      /////////////////////////////////
+      // now for the cells
+      out << "  <Cells>\n";
+      out << "    <DataArray type=\"Int32\" Name=\"connectivity\" "
+          << vtu_out.data_array_format() << ">\n";
+      write_cells(patches, vtu_out);
+      out << "    </DataArray>\n";
+
+      // XML VTU format uses offsets; this is
+      // different than the VTK format, which
+      // puts the number of nodes per cell in
+      // front of the connectivity list.
+      out << "    <DataArray type=\"Int32\" Name=\"offsets\" "
+          << vtu_out.data_array_format() << ">\n";
+
+      std::vector<int32_t> offsets (n_cells);
+      for (unsigned int i=0; i<n_cells; ++i)
+        offsets[i] = (i+1)*GeometryInfo<dim>::vertices_per_cell;
+      vtu_out << offsets;
+      out << "\n";
+      out << "    </DataArray>\n";
+
+      // next output the types of the
+      // cells. since all cells are
+      // the same, this is simple
+      out << "    <DataArray type=\"UInt8\" Name=\"types\" "
+          << vtu_out.data_array_format() << ">\n";
 
-    VtuStream vtu_out(out, flags);
+      {
+        // uint8_t might be a typedef to unsigned
+        // char which is then not printed as
+        // ascii integers
+  #ifdef DEAL_II_WITH_ZLIB
+        std::vector<uint8_t> cell_types (n_cells,
+                                         static_cast<uint8_t>(vtk_cell_type[dim]));
+  #else
+        std::vector<unsigned int> cell_types (n_cells,
+                                              vtk_cell_type[dim]);
+  #endif
+        // this should compress well :-)
+        vtu_out << cell_types;
+      }
+      out << "\n";
+      out << "    </DataArray>\n";
+      out << "  </Cells>\n";
+
+
+      ///////////////////////////////////////
+      // data output.
+
+      // now write the data vectors to
+      // @p{out} first make sure that all
+      // data is in place
+      reorder_task.join ();
+      quantize_data_vectors (flags.data_tolerances, data_vectors);
+
+      // then write data.  the
+      // 'POINT_DATA' means: node data
+      // (as opposed to cell data, which
+      // we do not support explicitly
+      // here). all following data sets
+      // are point data
+      out << "  <PointData Scalars=\"scalars\">\n";
+
+      // when writing, first write out
+      // all vector data, then handle the
+      // scalar data sets that have been
+      // left over
+      std::vector<bool> data_set_written (n_data_sets, false);
+      for (unsigned int n_th_vector=0; n_th_vector<vector_data_ranges.size(); ++n_th_vector)
+        {
+          AssertThrow (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]) >=
+                       std_cxx1x::get<0>(vector_data_ranges[n_th_vector]),
+                       ExcLowerRange (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]),
+                                      std_cxx1x::get<0>(vector_data_ranges[n_th_vector])));
+          AssertThrow (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]) < n_data_sets,
+                       ExcIndexRange (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]),
+                                      0, n_data_sets));
+          AssertThrow (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]) + 1
+                       - std_cxx1x::get<0>(vector_data_ranges[n_th_vector]) <= 3,
+                       ExcMessage ("Can't declare a vector with more than 3 components "
+                                   "in VTK"));
+
+          // mark these components as already
+          // written:
+          for (unsigned int i=std_cxx1x::get<0>(vector_data_ranges[n_th_vector]);
+               i<=std_cxx1x::get<1>(vector_data_ranges[n_th_vector]);
+               ++i)
+            data_set_written[i] = true;
 
-    const unsigned int n_data_sets = data_names.size();
-    // check against # of data sets in
-    // first patch. checks against all
-    // other patches are made in
-    // write_gmv_reorder_data_vectors
-    Assert ((patches[0].data.n_rows() == n_data_sets && !patches[0].points_are_available) ||
-            (patches[0].data.n_rows() == n_data_sets+spacedim && patches[0].points_are_available),
-            ExcDimensionMismatch (patches[0].points_are_available
-                                  ?
-                                  (n_data_sets + spacedim)
-                                  :
-                                  n_data_sets,
-                                  patches[0].data.n_rows()));
+          // write the
+          // header. concatenate all the
+          // component names with double
+          // underscores unless a vector
+          // name has been specified
+          out << "    <DataArray type=\"Float64\" Name=\"";
 
+          if (std_cxx1x::get<2>(vector_data_ranges[n_th_vector]) != "")
+            out << std_cxx1x::get<2>(vector_data_ranges[n_th_vector]);
+          else
+            {
+              for (unsigned int i=std_cxx1x::get<0>(vector_data_ranges[n_th_vector]);
+                   i<std_cxx1x::get<1>(vector_data_ranges[n_th_vector]);
+                   ++i)
+                out << data_names[i] << "__";
+              out << data_names[std_cxx1x::get<1>(vector_data_ranges[n_th_vector])];
+            }
 
-#ifdef DEAL_II_WITH_ZLIB
-    const char *ascii_or_binary = "binary";
-#else
-    const char *ascii_or_binary = "ascii";
-#endif
+          out << "\" NumberOfComponents=\"3\" "
+              << vtu_out.data_array_format() << ">\n";
 
+          // now write data. pad all
+          // vectors to have three
+          // components
+          std::vector<double> data;
+          data.reserve (n_nodes*dim);
 
-    // first count the number of cells
-    // and cells for later use
-    unsigned int n_nodes;
-    unsigned int n_cells;
-    compute_sizes<dim,spacedim>(patches, n_nodes, n_cells);
-    // in gmv format the vertex
-    // coordinates and the data have an
-    // order that is a bit unpleasant
-    // (first all x coordinates, then
-    // all y coordinate, ...; first all
-    // data of variable 1, then
-    // variable 2, etc), so we have to
-    // copy the data vectors a bit around
-    //
-    // note that we copy vectors when
-    // looping over the patches since we
-    // have to write them one variable
-    // at a time and don't want to use
-    // more than one loop
-    //
-    // this copying of data vectors can
-    // be done while we already output
-    // the vertices, so do this on a
-    // separate task and when wanting
-    // to write out the data, we wait
-    // for that task to finish
-    Table<2,double> data_vectors (n_data_sets, n_nodes);
-
-    void (*fun_ptr) (const std::vector<Patch<dim,spacedim> > &,
-                     Table<2,double> &)
-      = &write_gmv_reorder_data_vectors<dim,spacedim>;
-    Threads::Task<> reorder_task = Threads::new_task (fun_ptr, patches,
-                                                      data_vectors);
-
-    ///////////////////////////////
-    // first make up a list of used
-    // vertices along with their
-    // coordinates
-    //
-    // note that according to the standard, we
-    // have to print d=1..3 dimensions, even if
-    // we are in reality in 2d, for example
-    out << "<Piece NumberOfPoints=\"" << n_nodes
-        <<"\" NumberOfCells=\"" << n_cells << "\" >\n";
-    out << "  <Points>\n";
-    out << "    <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\""
-        << ascii_or_binary << "\">\n";
-    write_nodes(patches, vtu_out);
-    out << "    </DataArray>\n";
-    out << "  </Points>\n\n";
-    /////////////////////////////////
-    // now for the cells
-    out << "  <Cells>\n";
-    out << "    <DataArray type=\"Int32\" Name=\"connectivity\" format=\""
-        << ascii_or_binary << "\">\n";
-    write_cells(patches, vtu_out);
-    out << "    </DataArray>\n";
-
-    // XML VTU format uses offsets; this is
-    // different than the VTK format, which
-    // puts the number of nodes per cell in
-    // front of the connectivity list.
-    out << "    <DataArray type=\"Int32\" Name=\"offsets\" format=\""
-        << ascii_or_binary << "\">\n";
-
-    std::vector<int32_t> offsets (n_cells);
-    for (unsigned int i=0; i<n_cells; ++i)
-      offsets[i] = (i+1)*GeometryInfo<dim>::vertices_per_cell;
-    vtu_out << offsets;
-    out << "\n";
-    out << "    </DataArray>\n";
-
-    // next output the types of the
-    // cells. since all cells are
-    // the same, this is simple
-    out << "    <DataArray type=\"UInt8\" Name=\"types\" format=\""
-        << ascii_or_binary << "\">\n";
-
-    {
-      // uint8_t might be a typedef to unsigned
-      // char which is then not printed as
-      // ascii integers
-#ifdef DEAL_II_WITH_ZLIB
-      std::vector<uint8_t> cell_types (n_cells,
-                                       static_cast<uint8_t>(vtk_cell_type[dim]));
-#else
-      std::vector<unsigned int> cell_types (n_cells,
-                                            vtk_cell_type[dim]);
-#endif
-      // this should compress well :-)
-      vtu_out << cell_types;
-    }
-    out << "\n";
-    out << "    </DataArray>\n";
-    out << "  </Cells>\n";
-
-
-    ///////////////////////////////////////
-    // data output.
-
-    // now write the data vectors to
-    // @p{out} first make sure that all
-    // data is in place
-    reorder_task.join ();
-
-    // then write data.  the
-    // 'POINT_DATA' means: node data
-    // (as opposed to cell data, which
-    // we do not support explicitly
-    // here). all following data sets
-    // are point data
-    out << "  <PointData Scalars=\"scalars\">\n";
-
-    // when writing, first write out
-    // all vector data, then handle the
-    // scalar data sets that have been
-    // left over
-    std::vector<bool> data_set_written (n_data_sets, false);
-    for (unsigned int n_th_vector=0; n_th_vector<vector_data_ranges.size(); ++n_th_vector)
-      {
-        AssertThrow (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]) >=
-                     std_cxx1x::get<0>(vector_data_ranges[n_th_vector]),
-                     ExcLowerRange (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]),
-                                    std_cxx1x::get<0>(vector_data_ranges[n_th_vector])));
-        AssertThrow (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]) < n_data_sets,
-                     ExcIndexRange (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]),
-                                    0, n_data_sets));
-        AssertThrow (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]) + 1
-                     - std_cxx1x::get<0>(vector_data_ranges[n_th_vector]) <= 3,
-                     ExcMessage ("Can't declare a vector with more than 3 components "
-                                 "in VTK"));
-
-        // mark these components as already
-        // written:
-        for (unsigned int i=std_cxx1x::get<0>(vector_data_ranges[n_th_vector]);
-             i<=std_cxx1x::get<1>(vector_data_ranges[n_th_vector]);
-             ++i)
-          data_set_written[i] = true;
-
-        // write the
-        // header. concatenate all the
-        // component names with double
-        // underscores unless a vector
-        // name has been specified
-        out << "    <DataArray type=\"Float64\" Name=\"";
-
-        if (std_cxx1x::get<2>(vector_data_ranges[n_th_vector]) != "")
-          out << std_cxx1x::get<2>(vector_data_ranges[n_th_vector]);
-        else
-          {
-            for (unsigned int i=std_cxx1x::get<0>(vector_data_ranges[n_th_vector]);
-                 i<std_cxx1x::get<1>(vector_data_ranges[n_th_vector]);
-                 ++i)
-              out << data_names[i] << "__";
-            out << data_names[std_cxx1x::get<1>(vector_data_ranges[n_th_vector])];
-          }
+          for (unsigned int n=0; n<n_nodes; ++n)
+            {
+              switch (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]) -
+                      std_cxx1x::get<0>(vector_data_ranges[n_th_vector]))
+                {
+                case 0:
+                  data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector]), n));
+                  data.push_back (0);
+                  data.push_back (0);
+                  break;
 
-        out << "\" NumberOfComponents=\"3\" format=\""
-            << ascii_or_binary << "\">\n";
+                case 1:
+                  data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector]),   n));
+                  data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector])+1, n));
+                  data.push_back (0);
+                  break;
+                case 2:
+                  data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector]),   n));
+                  data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector])+1, n));
+                  data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector])+2, n));
+                  break;
 
-        // now write data. pad all
-        // vectors to have three
-        // components
-        std::vector<double> data;
-        data.reserve (n_nodes*dim);
+                default:
+                  // VTK doesn't
+                  // support
+                  // anything else
+                  // than vectors
+                  // with 1, 2, or
+                  // 3 components
+                  Assert (false, ExcInternalError());
+                }
+            }
+          vtu_out << data;
+          out << "    </DataArray>\n";
+        }
 
-        for (unsigned int n=0; n<n_nodes; ++n)
+      // now do the left over scalar data sets
+      for (unsigned int data_set=0; data_set<n_data_sets; ++data_set)
+        if (data_set_written[data_set] == false)
           {
-            switch (std_cxx1x::get<1>(vector_data_ranges[n_th_vector]) -
-                    std_cxx1x::get<0>(vector_data_ranges[n_th_vector]))
-              {
-              case 0:
-                data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector]), n));
-                data.push_back (0);
-                data.push_back (0);
-                break;
-
-              case 1:
-                data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector]),   n));
-                data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector])+1, n));
-                data.push_back (0);
-                break;
-              case 2:
-                data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector]),   n));
-                data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector])+1, n));
-                data.push_back (data_vectors(std_cxx1x::get<0>(vector_data_ranges[n_th_vector])+2, n));
-                break;
+            out << "    <DataArray type=\"Float64\" Name=\""
+                << data_names[data_set]
+                << "\" "
+                << vtu_out.data_array_format() << ">\n";
 
-              default:
-                // VTK doesn't
-                // support
-                // anything else
-                // than vectors
-                // with 1, 2, or
-                // 3 components
-                Assert (false, ExcInternalError());
-              }
+            std::vector<double> data (data_vectors[data_set].begin(),
+                                      data_vectors[data_set].end());
+            vtu_out << data;
+            out << "    </DataArray>\n";
           }
-        vtu_out << data;
-        out << "    </DataArray>\n";
-      }
 
-    // now do the left over scalar data sets
-    for (unsigned int data_set=0; data_set<n_data_sets; ++data_set)
-      if (data_set_written[data_set] == false)
-        {
-          out << "    <DataArray type=\"Float64\" Name=\""
-              << data_names[data_set]
-              << "\" format=\""
-              << ascii_or_binary << "\">\n";
+      out << "  </PointData>\n";
 
-          std::vector<double> data (data_vectors[data_set].begin(),
-                                    data_vectors[data_set].end());
-          vtu_out << data;
-          out << "    </DataArray>\n";
-        }
+      // Finish up writing a valid XML file
+      out << " </Piece>\n";
 
-    out << "  </PointData>\n";
+      // make sure everything now gets to
+      // disk
+      out.flush ();
 
-    // Finish up writing a valid XML file
-    out << " </Piece>\n";
-
-    // make sure everything now gets to
-    // disk
-    out.flush ();
-
-    // assert the stream is still ok
-    AssertThrow (out, ExcIO());
+      // assert the stream is still ok
+      AssertThrow (out, ExcIO());
+    }
   }
 
 
@@ -6430,12 +6809,107 @@ namespace DataOutBase
 
 
 
+  namespace
+  {
+    // functions to write and read the binary version of the intermediate
+    // format. numbers are stored as they are in memory, strings as their
+    // length followed by their characters
+    template <typename T>
+    void write_binary (const T      &value,
+                       std::ostream &out)
+    {
+      out.write (reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+
+
+    void write_binary (const std::string &value,
+                       std::ostream      &out)
+    {
+      write_binary (static_cast<uint32_t>(value.size()), out);
+      out.write (value.data(), value.size());
+    }
+
+
+
+    template <typename T>
+    void read_binary (T            &value,
+                      std::istream &in)
+    {
+      in.read (reinterpret_cast<char *>(&value), sizeof(T));
+    }
+
+
+
+    void read_binary (std::string  &value,
+                      std::istream &in)
+    {
+      uint32_t size = 0;
+      read_binary (size, in);
+      value.resize (size);
+      if (size > 0)
+        in.read (&value[0], size);
+    }
+
+
+
+    template <int dim, int spacedim>
+    void write_binary (const Patch<dim,spacedim> &patch,
+                       std::ostream              &out)
+    {
+      for (unsigned int i=0; i<GeometryInfo<dim>::vertices_per_cell; ++i)
+        for (unsigned int d=0; d<spacedim; ++d)
+          write_binary (patch.vertices[i][d], out);
+      for (unsigned int i=0; i<GeometryInfo<dim>::faces_per_cell; ++i)
+        write_binary (patch.neighbors[i], out);
+      write_binary (patch.patch_index, out);
+      write_binary (patch.n_subdivisions, out);
+      write_binary (static_cast<uint8_t>(patch.points_are_available), out);
+
+      // the elements of a table are stored contiguously, so write them
+      // in one piece
+      write_binary (static_cast<uint32_t>(patch.data.n_rows()), out);
+      write_binary (static_cast<uint32_t>(patch.data.n_cols()), out);
+      if (patch.data.n_elements() > 0)
+        out.write (reinterpret_cast<const char *>(&patch.data[0][0]),
+                   patch.data.n_elements() * sizeof(float));
+    }
+
+
+
+    template <int dim, int spacedim>
+    void read_binary (Patch<dim,spacedim> &patch,
+                      std::istream        &in)
+    {
+      for (unsigned int i=0; i<GeometryInfo<dim>::vertices_per_cell; ++i)
+        for (unsigned int d=0; d<spacedim; ++d)
+          read_binary (patch.vertices[i][d], in);
+      for (unsigned int i=0; i<GeometryInfo<dim>::faces_per_cell; ++i)
+        read_binary (patch.neighbors[i], in);
+      read_binary (patch.patch_index, in);
+      read_binary (patch.n_subdivisions, in);
+      uint8_t points_are_available = 0;
+      read_binary (points_are_available, in);
+      patch.points_are_available = (points_are_available != 0);
+
+      uint32_t n_rows = 0, n_cols = 0;
+      read_binary (n_rows, in);
+      read_binary (n_cols, in);
+      patch.data.reinit (n_rows, n_cols);
+      if (patch.data.n_elements() > 0)
+        in.read (reinterpret_cast<char *>(&patch.data[0][0]),
+                 patch.data.n_elements() * sizeof(float));
+    }
+  }
+
+
+
   template <int dim, int spacedim>
   void
   write_deal_II_intermediate (const std::vector<Patch<dim,spacedim> > &patches,
                               const std::vector<std::string>          &data_names,
                               const std::vector<std_cxx1x::tuple<unsigned int, unsigned int, std::string> > &vector_data_ranges,
-                              const Deal_II_IntermediateFlags         &/*flags*/,
+                              const Deal_II_IntermediateFlags         &flags,
                               std::ostream                            &out)
   {
     AssertThrow (out, ExcIO());
@@ -6452,6 +6926,33 @@ namespace DataOutBase
         << "[written by " << DEAL_II_PACKAGE_NAME << " " << DEAL_II_PACKAGE_VERSION << "]" << '\n'
         << "[Version: " << Deal_II_IntermediateFlags::format_version << "]" << '\n';
 
+    // in binary mode, mark the file as such and write everything else
+    // without any separators
+    if (flags.binary)
+      {
+        out << "[binary]" << '\n';
+
+        write_binary (static_cast<uint32_t>(data_names.size()), out);
+        for (unsigned int i=0; i<data_names.size(); ++i)
+          write_binary (data_names[i], out);
+
+        write_binary (static_cast<uint32_t>(patches.size()), out);
+        for (unsigned int i=0; i<patches.size(); ++i)
+          write_binary (patches[i], out);
+
+        write_binary (static_cast<uint32_t>(vector_data_ranges.size()), out);
+        for (unsigned int i=0; i<vector_data_ranges.size(); ++i)
+          {
+            write_binary (static_cast<uint32_t>(std_cxx1x::get<0>(vector_data_ranges[i])), out);
+            write_binary (static_cast<uint32_t>(std_cxx1x::get<1>(vector_data_ranges[i])), out);
+            write_binary (std_cxx1x::get<2>(vector_data_ranges[i]), out);
+          }
+
+        out.flush ();
+        AssertThrow (out, ExcIO());
+        return;
+      }
+
     out << data_names.size() << '\n';
     for (unsigned int i=0; i<data_names.size(); ++i)
       out << data_names[i] << '\n';
@@ -6673,6 +7174,167 @@ void DataOutInterface<dim,spacedim>::write_vtu_in_parallel (const char *filename
 }
 
 
+template <int dim, int spacedim>
+void
+DataOutInterface<dim,spacedim>::
+write_vtu_aggregated (const std::string &filename_without_extension,
+                      const unsigned int n_aggregators,
+                      MPI_Comm           comm) const
+{
+  // the .pvtu record refers to the files relative to its own location
+  const std::string base_name
+    = filename_without_extension.substr (filename_without_extension.find_last_of('/') + 1);
+
+#ifndef DEAL_II_WITH_MPI
+  // without MPI, write a single file and the record for it
+  (void)n_aggregators;
+  (void)comm;
+
+  const std::string filename = filename_without_extension + ".0.vtu";
+  std::ofstream out (filename.c_str());
+  AssertThrow (out, ExcFileNotOpen (filename.c_str()));
+  write_vtu (out);
+  out.close ();
+  AssertThrow (out, ExcIO());
+
+  const std::string record_filename = filename_without_extension + ".pvtu";
+  std::ofstream record (record_filename.c_str());
+  AssertThrow (record, ExcFileNotOpen (record_filename.c_str()));
+  write_pvtu_record (record, std::vector<std::string> (1, base_name + ".0.vtu"));
+#else
+  const unsigned int myrank  = Utilities::MPI::this_mpi_process (comm);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes (comm);
+
+  // split the processes into the groups that write one file each. the
+  // ranks within each group are in the same order as in comm, so the
+  // process with the smallest rank is the aggregator
+  MPI_Comm group_comm;
+  if (n_aggregators == 0)
+    {
+#if MPI_VERSION >= 3
+      MPI_Comm_split_type (comm, MPI_COMM_TYPE_SHARED, myrank, MPI_INFO_NULL,
+                           &group_comm);
+#else
+      // identify the processes on the same node by the names of their
+      // processors
+      char processor_name[MPI_MAX_PROCESSOR_NAME];
+      std::fill (processor_name, processor_name+MPI_MAX_PROCESSOR_NAME, '\0');
+      int length;
+      MPI_Get_processor_name (processor_name, &length);
+
+      std::vector<char> all_names (n_procs * MPI_MAX_PROCESSOR_NAME);
+      MPI_Allgather (processor_name, MPI_MAX_PROCESSOR_NAME, MPI_CHAR,
+                     &all_names[0], MPI_MAX_PROCESSOR_NAME, MPI_CHAR, comm);
+
+      int color = myrank;
+      for (unsigned int p=0; p<myrank; ++p)
+        if (std::strncmp (&all_names[p*MPI_MAX_PROCESSOR_NAME], processor_name,
+                          MPI_MAX_PROCESSOR_NAME) == 0)
+          {
+            color = p;
+            break;
+          }
+      MPI_Comm_split (comm, color, myrank, &group_comm);
+#endif
+    }
+  else
+    {
+      // split into groups of consecutive ranks
+      const unsigned int n_groups = std::min (n_aggregators, n_procs);
+      const int color = static_cast<unsigned long long int>(myrank) * n_groups / n_procs;
+      MPI_Comm_split (comm, color, myrank, &group_comm);
+    }
+
+  const unsigned int group_rank = Utilities::MPI::this_mpi_process (group_comm);
+  const unsigned int group_size = Utilities::MPI::n_mpi_processes (group_comm);
+
+  // number the files in the order of the ranks of their aggregators
+  int is_aggregator = (group_rank == 0 ? 1 : 0);
+  int n_aggregators_up_to_here = 0;
+  MPI_Scan (&is_aggregator, &n_aggregators_up_to_here, 1, MPI_INT, MPI_SUM, comm);
+  const unsigned int n_files = Utilities::MPI::sum (is_aggregator, comm);
+
+  // every process generates (and compresses) its own piece of the file
+  std::string piece;
+  {
+    std::ostringstream piece_stream;
+    DataOutBase::write_vtu_main (get_patches(), get_dataset_names(),
+                                 get_vector_data_ranges(),
+                                 vtk_flags, piece_stream);
+    piece = piece_stream.str();
+  }
+
+  // the pieces are sent in chunks whose size fits into an int
+  const unsigned long long int max_chunk_size = 1ULL << 30;
+  const int size_tag = 0, data_tag = 1;
+
+  if (is_aggregator == 1)
+    {
+      // receive the pieces of all other processes of the group even if
+      // the file can not be written, so that they do not wait forever
+      const std::string filename = filename_without_extension + "."
+                                   + Utilities::int_to_string (n_aggregators_up_to_here-1)
+                                   + ".vtu";
+      std::ofstream out (filename.c_str());
+      const bool file_opened = static_cast<bool>(out);
+
+      DataOutBase::write_vtu_header (out, vtk_flags);
+      out << piece;
+
+      std::vector<char> buffer;
+      for (unsigned int p=1; p<group_size; ++p)
+        {
+          unsigned long long int size;
+          MPI_Recv (&size, 1, MPI_UNSIGNED_LONG_LONG, p, size_tag, group_comm,
+                    MPI_STATUS_IGNORE);
+          buffer.resize (std::min (size, max_chunk_size));
+
+          for (unsigned long long int received = 0; received < size; )
+            {
+              const int chunk_size = std::min (size-received, max_chunk_size);
+              MPI_Recv (&buffer[0], chunk_size, MPI_CHAR, p, data_tag, group_comm,
+                        MPI_STATUS_IGNORE);
+              out.write (&buffer[0], chunk_size);
+              received += chunk_size;
+            }
+        }
+
+      DataOutBase::write_vtu_footer (out);
+      out.close ();
+      AssertThrow (file_opened, ExcFileNotOpen (filename.c_str()));
+      AssertThrow (out, ExcIO());
+    }
+  else
+    {
+      const unsigned long long int size = piece.size();
+      MPI_Send (const_cast<unsigned long long int *>(&size), 1, MPI_UNSIGNED_LONG_LONG,
+                0, size_tag, group_comm);
+      for (unsigned long long int sent = 0; sent < size; )
+        {
+          const int chunk_size = std::min (size-sent, max_chunk_size);
+          MPI_Send (const_cast<char *>(piece.data()) + sent, chunk_size, MPI_CHAR,
+                    0, data_tag, group_comm);
+          sent += chunk_size;
+        }
+    }
+
+  MPI_Comm_free (&group_comm);
+
+  if (myrank == 0)
+    {
+      std::vector<std::string> filenames;
+      for (unsigned int i=0; i<n_files; ++i)
+        filenames.push_back (base_name + "." + Utilities::int_to_string (i) + ".vtu");
+
+      const std::string record_filename = filename_without_extension + ".pvtu";
+      std::ofstream record (record_filename.c_str());
+      AssertThrow (record, ExcFileNotOpen (record_filename.c_str()));
+      write_pvtu_record (record, filenames);
+    }
+#endif
+}
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim,spacedim>::
@@ -7077,7 +7739,7 @@ void DataOutBase::write_filtered_data (const std::vector<Patch<dim,spacedim> > &
 
   compute_sizes<dim,spacedim>(patches, n_node, n_cell);
 
-  data_vectors = Table<2,double> (n_data_sets, n_node);
+  data_vectors.reinit (n_data_sets, n_node);
   void (*fun_ptr) (const std::vector<Patch<dim,spacedim> > &, Table<2,double> &) = &DataOutBase::template write_gmv_reorder_data_vectors<dim,spacedim>;
   reorder_task = Threads::new_task (fun_ptr, patches, data_vectors);
 
@@ -7766,6 +8428,16 @@ DataOutInterface<dim,spacedim>::get_vector_data_ranges () const
 
 
 
+template <int dim, int spacedim>
+void
+DataOutInterface<dim,spacedim>::
+release_patches (std::vector<DataOutBase::Patch<dim,spacedim> > &patches)
+{
+  patches = get_patches();
+}
+
+
+
 
 // ---------------------------------------------- DataOutReader ----------
 
@@ -7843,39 +8515,75 @@ DataOutReader<dim,spacedim>::read (std::istream &in)
                        "are written by."));
   }
 
-  // then read the rest of the data
-  unsigned int n_datasets;
-  in >> n_datasets;
-  dataset_names.resize (n_datasets);
-  for (unsigned int i=0; i<n_datasets; ++i)
-    in >> dataset_names[i];
-
-  unsigned int n_patches;
-  in >> n_patches;
-  patches.resize (n_patches);
-  for (unsigned int i=0; i<n_patches; ++i)
-    in >> patches[i];
-
-  unsigned int n_vector_data_ranges;
-  in >> n_vector_data_ranges;
-  vector_data_ranges.resize (n_vector_data_ranges);
-  for (unsigned int i=0; i<n_vector_data_ranges; ++i)
+  // binary files have one more line in their header, whereas the data of
+  // text files starts with a number
+  if (in.peek() == '[')
+    {
+      std::string header;
+      getline (in, header);
+      Assert (header == "[binary]", ExcUnexpectedInput("[binary]",header));
+
+      uint32_t n_datasets = 0;
+      DataOutBase::read_binary (n_datasets, in);
+      dataset_names.resize (n_datasets);
+      for (unsigned int i=0; i<n_datasets; ++i)
+        DataOutBase::read_binary (dataset_names[i], in);
+
+      uint32_t n_patches = 0;
+      DataOutBase::read_binary (n_patches, in);
+      patches.resize (n_patches);
+      for (unsigned int i=0; i<n_patches; ++i)
+        DataOutBase::read_binary (patches[i], in);
+
+      uint32_t n_vector_data_ranges = 0;
+      DataOutBase::read_binary (n_vector_data_ranges, in);
+      vector_data_ranges.resize (n_vector_data_ranges);
+      for (unsigned int i=0; i<n_vector_data_ranges; ++i)
+        {
+          uint32_t first = 0, last = 0;
+          DataOutBase::read_binary (first, in);
+          DataOutBase::read_binary (last, in);
+          std_cxx1x::get<0>(vector_data_ranges[i]) = first;
+          std_cxx1x::get<1>(vector_data_ranges[i]) = last;
+          DataOutBase::read_binary (std_cxx1x::get<2>(vector_data_ranges[i]), in);
+        }
+    }
+  else
     {
-      in >> std_cxx1x::get<0>(vector_data_ranges[i])
-         >> std_cxx1x::get<1>(vector_data_ranges[i]);
-
-      // read in the name of that vector
-      // range. because it is on a separate
-      // line, we first need to read to the
-      // end of the previous line (nothing
-      // should be there any more after we've
-      // read the previous two integers) and
-      // then read the entire next line for
-      // the name
-      std::string name;
-      getline(in, name);
-      getline(in, name);
-      std_cxx1x::get<2>(vector_data_ranges[i]) = name;
+      // then read the rest of the data
+      unsigned int n_datasets;
+      in >> n_datasets;
+      dataset_names.resize (n_datasets);
+      for (unsigned int i=0; i<n_datasets; ++i)
+        in >> dataset_names[i];
+
+      unsigned int n_patches;
+      in >> n_patches;
+      patches.resize (n_patches);
+      for (unsigned int i=0; i<n_patches; ++i)
+        in >> patches[i];
+
+      unsigned int n_vector_data_ranges;
+      in >> n_vector_data_ranges;
+      vector_data_ranges.resize (n_vector_data_ranges);
+      for (unsigned int i=0; i<n_vector_data_ranges; ++i)
+        {
+          in >> std_cxx1x::get<0>(vector_data_ranges[i])
+             >> std_cxx1x::get<1>(vector_data_ranges[i]);
+
+          // read in the name of that vector
+          // range. because it is on a separate
+          // line, we first need to read to the
+          // end of the previous line (nothing
+          // should be there any more after we've
+          // read the previous two integers) and
+          // then read the entire next line for
+          // the name
+          std::string name;
+          getline(in, name);
+          getline(in, name);
+          std_cxx1x::get<2>(vector_data_ranges[i]) = name;
+        }
     }
 
   Assert (in, ExcIO());
@@ -7883,6 +8591,95 @@ DataOutReader<dim,spacedim>::read (std::istream &in)
 
 
 
+namespace
+{
+  template <int dim, int spacedim>
+  void read_intermediate_file (const std::string           &filename,
+                               DataOutReader<dim,spacedim> &reader)
+  {
+    std::ifstream in (filename.c_str(), std::ios::binary);
+    AssertThrow (in, ExcFileNotOpen (filename.c_str()));
+    reader.read (in);
+  }
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutReader<dim,spacedim>::read (const std::vector<std::string> &filenames)
+{
+  typedef typename dealii::DataOutBase::Patch<dim,spacedim> Patch;
+
+  Assert (filenames.size() > 0, ExcMessage ("No files to read."));
+
+  // read all files at the same time
+  std::vector<DataOutReader<dim,spacedim> > readers (filenames.size());
+  {
+    Threads::TaskGroup<> tasks;
+    for (unsigned int i=0; i<filenames.size(); ++i)
+      tasks += Threads::new_task (&read_intermediate_file<dim,spacedim>,
+                                  filenames[i], readers[i]);
+    tasks.join_all ();
+  }
+
+  dataset_names      = readers[0].dataset_names;
+  vector_data_ranges = readers[0].vector_data_ranges;
+
+  unsigned int n_patches = 0;
+  for (unsigned int i=0; i<readers.size(); ++i)
+    n_patches += readers[i].patches.size();
+  {
+    std::vector<Patch> tmp;
+    tmp.swap (patches);
+  }
+  patches.reserve (n_patches);
+
+  // then append the patches of one file after the other, shifting their
+  // indices and those of their neighbors by the number of patches
+  // before them. release the memory of each file as soon as its patches
+  // have been copied
+  for (unsigned int i=0; i<readers.size(); ++i)
+    {
+      Assert (readers[i].dataset_names == dataset_names,
+              ExcIncompatibleDatasetNames());
+      Assert (readers[i].vector_data_ranges.size() == vector_data_ranges.size(),
+              ExcMessage ("All files need to declare the same components "
+                          "as vectors."));
+      for (unsigned int r=0; r<vector_data_ranges.size(); ++r)
+        Assert ((std_cxx1x::get<0>(readers[i].vector_data_ranges[r]) ==
+                 std_cxx1x::get<0>(vector_data_ranges[r]))
+                &&
+                (std_cxx1x::get<1>(readers[i].vector_data_ranges[r]) ==
+                 std_cxx1x::get<1>(vector_data_ranges[r]))
+                &&
+                (std_cxx1x::get<2>(readers[i].vector_data_ranges[r]) ==
+                 std_cxx1x::get<2>(vector_data_ranges[r])),
+                ExcMessage ("All files need to declare the same components "
+                            "as vectors."));
+      Assert ((patches.size() == 0) || (readers[i].patches.size() == 0) ||
+              (patches[0].n_subdivisions == readers[i].patches[0].n_subdivisions),
+              ExcIncompatiblePatchLists());
+
+      const unsigned int offset = patches.size();
+      patches.insert (patches.end(),
+                      readers[i].patches.begin(),
+                      readers[i].patches.end());
+      for (unsigned int p=offset; p<patches.size(); ++p)
+        {
+          patches[p].patch_index += offset;
+          for (unsigned int n=0; n<GeometryInfo<dim>::faces_per_cell; ++n)
+            if (patches[p].neighbors[n] != Patch::no_neighbor)
+              patches[p].neighbors[n] += offset;
+        }
+
+      std::vector<Patch> tmp;
+      tmp.swap (readers[i].patches);
+    }
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOutReader<dim,spacedim>::
@@ -103,131 +103,7 @@ namespace Polynomials
                              std::vector<number> &values) const
   {
     Assert (values.size() > 0, ExcZero());
-    const unsigned int values_size=values.size();
-
-    // evaluate Lagrange polynomial and derivatives
-    if (in_lagrange_product_form == true)
-      {
-        // to compute the value and all derivatives of a polynomial of the
-        // form (x-x_1)*(x-x_2)*...*(x-x_n), expand the derivatives like
-        // automatic differentiation does.
-        const unsigned int n_supp = lagrange_support_points.size();
-        switch (values_size)
-          {
-          default:
-            values[0] = 1;
-            for (unsigned int d=1; d<values_size; ++d)
-              values[d] = 0;
-            for (unsigned int i=0; i<n_supp; ++i)
-              {
-                const number v = x-lagrange_support_points[i];
-
-                // multiply by (x-x_i) and compute action on all derivatives,
-                // too (inspired from automatic differentiation: implement the
-                // product rule for the old value and the new variable 'v',
-                // i.e., expand value v and derivative one). since we reuse a
-                // value from the next lower derivative from the steps before,
-                // need to start from the highest derivative
-                for (unsigned int k=values_size-1; k>0; --k)
-                  values[k] = (values[k] * v + values[k-1]);
-                values[0] *= v;
-              }
-            // finally, multiply by the weight in the Lagrange
-            // denominator. Could be done instead of setting values[0] = 1
-            // above, but that gives different accumulation of round-off
-            // errors (multiplication is not associative) compared to when we
-            // computed the weight, and hence a basis function might not be
-            // exactly one at the center point, which is nice to have. We also
-            // multiply derivatives by k! to transform the product p_n =
-            // p^(n)(x)/k! into the actual form of the derivative
-            {
-              number k_faculty = 1;
-              for (unsigned int k=0; k<values_size; ++k)
-                {
-                  values[k] *= k_faculty * lagrange_weight;
-                  k_faculty *= static_cast<number>(k+1);
-                }
-            }
-            break;
-
-          // manually implement size 1 (values only), size 2 (value + first
-          // derivative), and size 3 (up to second derivative) since they
-          // might be called often. then, we can unroll the loop.
-          case 1:
-            values[0] = 1;
-            for (unsigned int i=0; i<n_supp; ++i)
-              {
-                const number v = x-lagrange_support_points[i];
-                values[0] *= v;
-              }
-            values[0] *= lagrange_weight;
-            break;
-
-          case 2:
-            values[0] = 1;
-            values[1] = 0;
-            for (unsigned int i=0; i<n_supp; ++i)
-              {
-                const number v = x-lagrange_support_points[i];
-                values[1] = values[1] * v + values[0];
-                values[0] *= v;
-              }
-            values[0] *= lagrange_weight;
-            values[1] *= lagrange_weight;
-            break;
-
-          case 3:
-            values[0] = 1;
-            values[1] = 0;
-            values[2] = 0;
-            for (unsigned int i=0; i<n_supp; ++i)
-              {
-                const number v = x-lagrange_support_points[i];
-                values[2] = values[2] * v + values[1];
-                values[1] = values[1] * v + values[0];
-                values[0] *= v;
-              }
-            values[0] *= lagrange_weight;
-            values[1] *= lagrange_weight;
-            values[2] *= static_cast<number>(2) * lagrange_weight;
-            break;
-          }
-        return;
-      }
-
-    Assert (coefficients.size() > 0, ExcEmptyObject());
-
-    // if we only need the value, then call the other function since that is
-    // significantly faster (there is no need to allocate and free memory,
-    // which is really expensive compared to all the other operations!)
-    if (values_size == 1)
-      {
-        values[0] = value(x);
-        return;
-      };
-
-    // if there are derivatives needed, then do it properly by the full Horner
-    // scheme
-    const unsigned int m=coefficients.size();
-    std::vector<number> a(coefficients);
-    unsigned int j_faculty=1;
-
-    // loop over all requested derivatives. note that derivatives @p{j>m} are
-    // necessarily zero, as they differentiate the polynomial more often than
-    // the highest power is
-    const unsigned int min_valuessize_m=std::min(values_size, m);
-    for (unsigned int j=0; j<min_valuessize_m; ++j)
-      {
-        for (int k=m-2; k>=static_cast<int>(j); --k)
-          a[k]+=x*a[k+1];
-        values[j]=static_cast<number>(j_faculty)*a[j];
-
-        j_faculty*=j+1;
-      }
-
-    // fill higher derivatives by zero
-    for (unsigned int j=min_valuessize_m; j<values_size; ++j)
-      values[j] = 0;
+    value (x, values.size()-1, &values[0]);
   }
 
 
@@ -16,10 +16,12 @@
 
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/thread_management.h>
 
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include <map>
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -36,6 +38,189 @@ namespace
   {
     return ((a>0) ? a : -a);
   }
+
+
+
+  // the one-dimensional Gauss and Gauss-Lobatto formulas computed so far,
+  // indexed by the number of points. computing the points and weights of
+  // these formulas takes several Newton iterations in long double per
+  // point, so we only do it once per program run for each number of
+  // points. the caches are function-local static objects so that they are
+  // initialized on first use also if a quadrature formula is created during
+  // static initialization of another file
+  std::map<unsigned int, Quadrature<1> > &
+  gauss_cache ()
+  {
+    static std::map<unsigned int, Quadrature<1> > cache;
+    return cache;
+  }
+
+
+
+  std::map<unsigned int, Quadrature<1> > &
+  gauss_lobatto_cache ()
+  {
+    static std::map<unsigned int, Quadrature<1> > cache;
+    return cache;
+  }
+
+
+
+  // the mutex guarding the two caches above
+  Threads::Mutex &
+  cache_mutex ()
+  {
+    static Threads::Mutex mutex;
+    return mutex;
+  }
+
+
+
+  // if the given cache contains a formula with n points, copy its points
+  // and weights and return true
+  bool
+  read_from_cache (const std::map<unsigned int, Quadrature<1> > &cache,
+                   const unsigned int                            n,
+                   std::vector<Point<1> >                       &points,
+                   std::vector<double>                          &weights)
+  {
+    Threads::Mutex::ScopedLock lock (cache_mutex());
+    const std::map<unsigned int, Quadrature<1> >::const_iterator
+    entry = cache.find (n);
+    if (entry == cache.end())
+      return false;
+
+    points = entry->second.get_points();
+    weights = entry->second.get_weights();
+    return true;
+  }
+
+
+
+  void
+  write_to_cache (std::map<unsigned int, Quadrature<1> > &cache,
+                  const unsigned int                      n,
+                  const Quadrature<1>                    &quadrature)
+  {
+    Threads::Mutex::ScopedLock lock (cache_mutex());
+    cache.insert (std::make_pair (n, quadrature));
+  }
+
+
+
+  // the tolerance for the Newton iterations computing the points of Gauss
+  // type formulas. see QGauss<1>::QGauss for an explanation
+  long double
+  newton_tolerance ()
+  {
+    const long double
+    long_double_eps = static_cast<long double>(std::numeric_limits<long double>::epsilon()),
+    double_eps      = static_cast<long double>(std::numeric_limits<double>::epsilon());
+
+    volatile long double runtime_one = 1.0;
+    return (runtime_one + long_double_eps != runtime_one
+            ?
+            std::max (double_eps / 100, long_double_eps * 5)
+            :
+            double_eps * 5);
+  }
+
+
+
+  // evaluate the Legendre polynomials of degree n and n-1 at x with the
+  // three-term recurrence
+  void
+  legendre_polynomials (const unsigned int n,
+                        const long double  x,
+                        long double       &p_n,
+                        long double       &p_n_minus_1)
+  {
+    long double p1 = 1., p2 = 0., p3;
+    for (unsigned int j=0; j<n; ++j)
+      {
+        p3 = p2;
+        p2 = p1;
+        p1 = ((2.*j+1.)*x*p2-j*p3)/(j+1);
+      }
+    p_n = p1;
+    p_n_minus_1 = p2;
+  }
+
+
+
+  // compute the points and weights of the Gauss-Lobatto formula with n
+  // points on the interval [-1,1]. this is used for high orders, where the
+  // algorithm of QGaussLobatto<1>::compute_quadrature_points(), which
+  // deflates each root by all the ones found before, becomes expensive.
+  //
+  // the interior points are the roots of the derivative of the Legendre
+  // polynomial P_N of degree N=n-1. each of them lies between two adjacent
+  // roots of P_N, i.e., two points of the Gauss formula with N points,
+  // which we use as a bracket for a Newton iteration that falls back to
+  // bisection whenever a step would leave the bracket. the second
+  // derivative is obtained from the Legendre differential equation. only
+  // the points in the left half are computed, the others follow by
+  // symmetry. the weights are 2/(n(n-1)P_N(x)^2)
+  void
+  compute_gauss_lobatto_high_order (const unsigned int        n,
+                                    std::vector<long double> &points,
+                                    std::vector<long double> &weights)
+  {
+    const unsigned int N = n-1;
+    const unsigned int n_interior = n-2;
+    const long double tolerance = newton_tolerance();
+    const QGauss<1> gauss (N);
+
+    points.resize (n);
+    weights.resize (n);
+    points[0] = -1.L;
+    points[n-1] = 1.L;
+    weights[0] = weights[n-1] = 2.L/(static_cast<long double>(n)*N);
+
+    for (unsigned int k=0; k<(n_interior+1)/2; ++k)
+      {
+        long double x;
+        if (2*k+1 == n_interior)
+          x = 0.;
+        else
+          {
+            long double a = 2.L*gauss.point(k)(0)-1.L,
+                        b = 2.L*gauss.point(k+1)(0)-1.L;
+            long double p, q;
+            legendre_polynomials (N, a, p, q);
+            const long double derivative_a = N*(a*p-q)/(a*a-1);
+
+            x = (a+b)/2;
+            long double delta;
+            do
+              {
+                legendre_polynomials (N, x, p, q);
+                const long double derivative = N*(x*p-q)/(x*x-1),
+                                  second_derivative = (2*x*derivative - N*(N+1.L)*p)/(1-x*x);
+
+                if ((derivative < 0) == (derivative_a < 0))
+                  a = x;
+                else
+                  b = x;
+
+                long double x_new = x - derivative/second_derivative;
+                if (!(x_new > a && x_new < b))
+                  x_new = (a+b)/2;
+                delta = x_new - x;
+                x = x_new;
+              }
+            while (abs(delta) > tolerance);
+          }
+
+        long double p, q;
+        legendre_polynomials (N, x, p, q);
+        const long double w = 2.L/(static_cast<long double>(n)*N*p*p);
+
+        points[k+1] = x;
+        points[n-2-k] = -x;
+        weights[k+1] = weights[n-2-k] = w;
+      }
+  }
 }
 
 
@@ -76,6 +261,10 @@ QGauss<1>::QGauss (const unsigned int n)
   if (n == 0)
     return;
 
+  if (read_from_cache (gauss_cache(), n,
+                       this->quadrature_points, this->weights))
+    return;
+
   const unsigned int m = (n+1)/2;
 
   // tolerance for the Newton
@@ -140,6 +329,12 @@ QGauss<1>::QGauss (const unsigned int n)
     {
       long double z = std::cos(numbers::PI * (i-.25)/(n+.5));
 
+      // for high orders, improve the initial guess by the next term of
+      // Tricomi's asymptotic expansion of the roots, which saves about one
+      // Newton step per point
+      if (n > 50)
+        z *= 1. - (n-1.)/(8.*n*n*n);
+
       long double pp;
       long double p1, p2, p3;
 
@@ -168,6 +363,8 @@ QGauss<1>::QGauss (const unsigned int n)
       this->weights[i-1] = w;
       this->weights[n-i] = w;
     }
+
+  write_to_cache (gauss_cache(), n, *this);
 }
 
 
@@ -178,8 +375,18 @@ QGaussLobatto<1>::QGaussLobatto (const unsigned int n)
 {
   Assert (n >= 2, ExcNotImplemented());
 
-  std::vector<long double> points  = compute_quadrature_points(n, 1, 1);
-  std::vector<long double> w       = compute_quadrature_weights(points, 0, 0);
+  if (read_from_cache (gauss_lobatto_cache(), n,
+                       this->quadrature_points, this->weights))
+    return;
+
+  std::vector<long double> points, w;
+  if (n > 50)
+    compute_gauss_lobatto_high_order (n, points, w);
+  else
+    {
+      points = compute_quadrature_points(n, 1, 1);
+      w      = compute_quadrature_weights(points, 0, 0);
+    }
 
   // scale points to the interval
   // [0.0, 1.0]:
@@ -188,6 +395,8 @@ QGaussLobatto<1>::QGaussLobatto (const unsigned int n)
       this->quadrature_points[i] = Point<1>(0.5 + 0.5*static_cast<double>(points[i]));
       this->weights[i]           = 0.5*w[i];
     }
+
+  write_to_cache (gauss_lobatto_cache(), n, *this);
 }
 
 
@@ -991,6 +1200,62 @@ QWeddle<dim>::QWeddle ()
 {}
 
 
+namespace
+{
+  // the formulas handed out by QuadratureRegistry<dim>. map entries never
+  // move in memory, so references to them stay valid when further formulas
+  // are added
+  template <int dim>
+  std::map<unsigned int, Quadrature<dim> > &
+  registered_formulas (const bool gauss_lobatto)
+  {
+    static std::map<unsigned int, Quadrature<dim> > gauss_formulas;
+    static std::map<unsigned int, Quadrature<dim> > gauss_lobatto_formulas;
+    return (gauss_lobatto ? gauss_lobatto_formulas : gauss_formulas);
+  }
+
+
+
+  Threads::Mutex &
+  registry_mutex ()
+  {
+    static Threads::Mutex mutex;
+    return mutex;
+  }
+}
+
+
+
+template <int dim>
+const Quadrature<dim> &
+QuadratureRegistry<dim>::gauss (const unsigned int n)
+{
+  Threads::Mutex::ScopedLock lock (registry_mutex());
+  std::map<unsigned int, Quadrature<dim> > &formulas = registered_formulas<dim> (false);
+  typename std::map<unsigned int, Quadrature<dim> >::iterator
+  entry = formulas.find (n);
+  if (entry == formulas.end())
+    entry = formulas.insert (std::make_pair (n, QGauss<dim>(n))).first;
+  return entry->second;
+}
+
+
+
+template <int dim>
+const Quadrature<dim> &
+QuadratureRegistry<dim>::gauss_lobatto (const unsigned int n)
+{
+  Threads::Mutex::ScopedLock lock (registry_mutex());
+  std::map<unsigned int, Quadrature<dim> > &formulas = registered_formulas<dim> (true);
+  typename std::map<unsigned int, Quadrature<dim> >::iterator
+  entry = formulas.find (n);
+  if (entry == formulas.end())
+    entry = formulas.insert (std::make_pair (n, QGaussLobatto<dim>(n))).first;
+  return entry->second;
+}
+
+
+
 // explicit specialization
 // note that 1d formulae are specialized by implementation above
 template class QGauss<2>;
@@ -1009,4 +1274,8 @@ template class QSimpson<3>;
 template class QMilne<3>;
 template class QWeddle<3>;
 
+template class QuadratureRegistry<1>;
+template class QuadratureRegistry<2>;
+template class QuadratureRegistry<3>;
+
 DEAL_II_NAMESPACE_CLOSE
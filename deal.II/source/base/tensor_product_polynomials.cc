@@ -18,6 +18,9 @@
 #include <deal.II/base/polynomials_piecewise.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/table.h>
+#include <deal.II/base/vectorization.h>
+
+#include <algorithm>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -69,6 +72,63 @@ namespace internal
       indices[1] = (n/n_pols_0) % n_pols_1;
       indices[2] = n / (n_pols_0*n_pols_1);
     }
+
+
+
+    // evaluate all the given polynomials and their first n_values-1
+    // derivatives at all the given points. the result for polynomial i at
+    // point q is stored starting at values[(q*n_pols+i)*n_values]. this is
+    // the general version that evaluates each polynomial at each point
+    // individually
+    template <class POLY>
+    void evaluate_polynomials (const std::vector<POLY>   &polynomials,
+                               const std::vector<double> &points,
+                               const unsigned int         n_values,
+                               double                    *values)
+    {
+      const unsigned int n_pols = polynomials.size();
+      std::vector<double> tmp (n_values);
+      for (unsigned int q=0; q<points.size(); ++q)
+        for (unsigned int i=0; i<n_pols; ++i)
+          {
+            polynomials[i].value (points[q], tmp);
+            for (unsigned int e=0; e<n_values; ++e)
+              values[(q*n_pols+i)*n_values+e] = tmp[e];
+          }
+    }
+
+
+
+    // the same for polynomials of type Polynomials::Polynomial, which can
+    // be evaluated at several points at once with vectorized instructions
+    void evaluate_polynomials (const std::vector<Polynomials::Polynomial<double> > &polynomials,
+                               const std::vector<double>                          &points,
+                               const unsigned int                                  n_values,
+                               double                                             *values)
+    {
+      const unsigned int n_pols = polynomials.size();
+      const unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+      VectorizedArray<double> tmp[3];
+      Assert (n_values <= 3, ExcInternalError());
+
+      for (unsigned int q0=0; q0<points.size(); q0+=n_lanes)
+        {
+          // fill the last batch of points by repeating the last point
+          const unsigned int n_filled = std::min (n_lanes,
+                                                  static_cast<unsigned int>(points.size()-q0));
+          VectorizedArray<double> x;
+          for (unsigned int v=0; v<n_lanes; ++v)
+            x[v] = points[q0 + std::min (v, n_filled-1)];
+
+          for (unsigned int i=0; i<n_pols; ++i)
+            {
+              polynomials[i].value (x, n_values-1, &tmp[0]);
+              for (unsigned int v=0; v<n_filled; ++v)
+                for (unsigned int e=0; e<n_values; ++e)
+                  values[((q0+v)*n_pols+i)*n_values+e] = tmp[e][v];
+            }
+        }
+    }
   }
 }
 
@@ -332,6 +392,78 @@ compute (const Point<dim>            &p,
 
 
 
+template <int dim, typename POLY>
+void
+TensorProductPolynomials<dim,POLY>::
+compute (const std::vector<Point<dim> > &points,
+         Table<2,double>                &values,
+         Table<2,Tensor<1,dim> >        &grads) const
+{
+  const unsigned int n_points = points.size();
+  Assert ((values.n_rows()==n_tensor_pols && values.n_cols()==n_points) ||
+          values.n_elements()==0,
+          ExcDimensionMismatch2(values.n_rows(), n_tensor_pols, 0));
+  Assert ((grads.n_rows()==n_tensor_pols && grads.n_cols()==n_points) ||
+          grads.n_elements()==0,
+          ExcDimensionMismatch2(grads.n_rows(), n_tensor_pols, 0));
+
+  const bool update_values = (values.n_elements() > 0),
+             update_grads  = (grads.n_elements() > 0);
+  if ((update_values == false && update_grads == false) || n_points == 0)
+    return;
+
+  // compute the values (and first derivatives, if necessary) of all
+  // one-dimensional polynomials at the coordinates of all points in each
+  // direction
+  const unsigned int n_pols = polynomials.size();
+  const unsigned int n_values = update_grads ? 2 : 1;
+  std::vector<double> coordinates (n_points);
+  std::vector<double> v (dim*n_points*n_pols*n_values);
+  for (unsigned int d=0; d<dim; ++d)
+    {
+      for (unsigned int q=0; q<n_points; ++q)
+        coordinates[q] = points[q][d];
+      internal::evaluate_polynomials (polynomials, coordinates, n_values,
+                                      &v[d*n_points*n_pols*n_values]);
+    }
+
+  // then form the tensor products. the entry for derivative e of the
+  // one-dimensional polynomial i in direction d at point q is at
+  // position ((d*n_points+q)*n_pols+i)*n_values+e of v
+  for (unsigned int i=0; i<n_tensor_pols; ++i)
+    {
+      unsigned int indices[dim];
+      compute_index (i, indices);
+
+      const double *v_i[dim];
+      for (unsigned int d=0; d<dim; ++d)
+        v_i[d] = &v[(d*n_points*n_pols + indices[d])*n_values];
+      const unsigned int stride = n_pols*n_values;
+
+      if (update_values)
+        for (unsigned int q=0; q<n_points; ++q)
+          {
+            double value = 1.;
+            for (unsigned int x=0; x<dim; ++x)
+              value *= v_i[x][q*stride];
+            values(i,q) = value;
+          }
+
+      if (update_grads)
+        for (unsigned int q=0; q<n_points; ++q)
+          for (unsigned int d=0; d<dim; ++d)
+            {
+              double grad = 1.;
+              for (unsigned int x=0; x<dim; ++x)
+                grad *= v_i[x][q*stride + (d==x)];
+              grads(i,q)[d] = grad;
+            }
+    }
+}
+
+
+
+
 /* ------------------- AnisotropicPolynomials -------------- */
 
 
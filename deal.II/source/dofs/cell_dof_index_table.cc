@@ -0,0 +1,143 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/dofs/cell_dof_index_table.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/hp/dof_handler.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_iterator.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <class DH>
+CellDoFIndexTable<DH>::CellDoFIndexTable ()
+  :
+  n_dofs (0)
+{}
+
+
+
+template <class DH>
+CellDoFIndexTable<DH>::CellDoFIndexTable (const DH &dof_handler)
+  :
+  n_dofs (0)
+{
+  reinit (dof_handler);
+}
+
+
+
+template <class DH>
+void
+CellDoFIndexTable<DH>::reinit (const DH &dof_handler)
+{
+  clear ();
+  this->dof_handler = &dof_handler;
+  n_dofs = dof_handler.n_dofs();
+
+  cell_numbers.resize (dof_handler.get_tria().n_levels());
+  for (unsigned int level=0; level<cell_numbers.size(); ++level)
+    cell_numbers[level].resize (dof_handler.get_tria().n_raw_cells(level),
+                                numbers::invalid_unsigned_int);
+
+  // first count the degrees of freedom of all cells to allocate the
+  // table only once, then fill it
+  row_starts.push_back (0);
+  for (active_cell_iterator cell = dof_handler.begin_active();
+       cell != dof_handler.end(); ++cell)
+    {
+      cell_numbers[cell->level()][cell->index()] = row_starts.size()-1;
+      row_starts.push_back (row_starts.back() +
+                            (cell->is_artificial() ? 0 : cell->get_fe().dofs_per_cell));
+    }
+
+  dof_index_table.resize (row_starts.back());
+  std::vector<types::global_dof_index> local_dof_indices;
+  unsigned int index = 0;
+  for (active_cell_iterator cell = dof_handler.begin_active();
+       cell != dof_handler.end(); ++cell, ++index)
+    if (!cell->is_artificial())
+      {
+        local_dof_indices.resize (cell->get_fe().dofs_per_cell);
+        cell->get_dof_indices (local_dof_indices);
+        std::copy (local_dof_indices.begin(), local_dof_indices.end(),
+                   dof_index_table.begin() + row_starts[index]);
+      }
+}
+
+
+
+template <class DH>
+void
+CellDoFIndexTable<DH>::clear ()
+{
+  dof_handler = 0;
+  n_dofs = 0;
+  std::vector<std::size_t>().swap (row_starts);
+  std::vector<types::global_dof_index>().swap (dof_index_table);
+  std::vector<std::vector<unsigned int> >().swap (cell_numbers);
+}
+
+
+
+template <class DH>
+unsigned int
+CellDoFIndexTable<DH>::cell_number (const active_cell_iterator &cell) const
+{
+  Assert (&cell->get_dof_handler() == &*dof_handler,
+          ExcMessage ("The cell does not belong to the DoFHandler of this table."));
+  Assert (cell->active(), ExcMessage ("Cell must be active."));
+  AssertIndexRange (static_cast<unsigned int>(cell->level()), cell_numbers.size());
+  AssertIndexRange (static_cast<unsigned int>(cell->index()),
+                    cell_numbers[cell->level()].size());
+  Assert (cell_numbers[cell->level()][cell->index()] != numbers::invalid_unsigned_int,
+          ExcTableOutdated());
+
+  return cell_numbers[cell->level()][cell->index()];
+}
+
+
+
+template <class DH>
+void
+CellDoFIndexTable<DH>::get_dof_indices (const unsigned int                    cell,
+                                        std::vector<types::global_dof_index> &indices) const
+{
+  AssertDimension (indices.size(), n_dofs_per_cell(cell));
+  const types::global_dof_index *p = dof_indices (cell);
+  std::copy (p, p+indices.size(), indices.begin());
+}
+
+
+
+template <class DH>
+std::size_t
+CellDoFIndexTable<DH>::memory_consumption () const
+{
+  return (MemoryConsumption::memory_consumption (row_starts) +
+          MemoryConsumption::memory_consumption (dof_index_table) +
+          MemoryConsumption::memory_consumption (cell_numbers));
+}
+
+
+// explicit instantiations
+#include "cell_dof_index_table.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
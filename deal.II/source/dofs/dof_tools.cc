@@ -1060,6 +1060,52 @@ namespace DoFTools
 
 
 
+  namespace internal
+  {
+    namespace
+    {
+      /**
+       * Return the number of finite elements of a DoFHandler, i.e. one,
+       * or of an hp::DoFHandler.
+       */
+      template <int dim, int spacedim>
+      unsigned int
+      n_finite_elements (const dealii::hp::DoFHandler<dim,spacedim> &dof_handler)
+      {
+        return dof_handler.get_fe().size();
+      }
+
+
+      template <class DH>
+      unsigned int
+      n_finite_elements (const DH &)
+      {
+        return 1;
+      }
+    }
+  }
+
+
+
+  template <class DH>
+  std::vector<std::vector<typename DH::active_cell_iterator> >
+  get_active_cells_by_fe_index (const DH &dof_handler)
+  {
+    std::vector<std::vector<typename DH::active_cell_iterator> >
+    cells (internal::n_finite_elements (dof_handler));
+
+    typename DH::active_cell_iterator
+    cell = dof_handler.begin_active(),
+    endc = dof_handler.end();
+    for (; cell!=endc; ++cell)
+      if (!cell->is_artificial())
+        cells[cell->active_fe_index()].push_back (cell);
+
+    return cells;
+  }
+
+
+
   template <class DH>
   void
   get_subdomain_association (const DH                  &dof_handler,
@@ -1276,7 +1276,7 @@ FiniteElement<dim,spacedim>::compute_2nd (
 //                        0U),
 //        ExcInternalError());
   // Number of quadrature points
-  const unsigned int n_q_points = data.shape_hessians[0].size();
+  const unsigned int n_q_points = data.shape_hessians.n_cols();
 
   // first reinit the fe_values
   // objects used for the finite
@@ -55,8 +55,14 @@ FE_Poly<TensorProductPolynomials<1>,1,2>::fill_fe_values
           data.shape_values(k,i) = fe_data.shape_values[k][i];
 
       if (flags & update_gradients && cell_similarity != CellSimilarity::translation)
-        mapping.transform(fe_data.shape_gradients[k], data.shape_gradients[k],
-                          mapping_data, mapping_covariant);
+        {
+          fe_data.transformed_shape_gradients.resize (quadrature.size());
+          mapping.transform(fe_data.shape_gradients[k], fe_data.transformed_shape_gradients,
+                            mapping_data, mapping_covariant);
+          std::copy (fe_data.transformed_shape_gradients.begin(),
+                     fe_data.transformed_shape_gradients.end(),
+                     data.shape_gradients[k].begin());
+        }
     }
 
   if (flags & update_hessians && cell_similarity != CellSimilarity::translation)
@@ -92,8 +98,14 @@ FE_Poly<TensorProductPolynomials<2>,2,3>::fill_fe_values
           data.shape_values(k,i) = fe_data.shape_values[k][i];
 
       if (flags & update_gradients && cell_similarity != CellSimilarity::translation)
-        mapping.transform(fe_data.shape_gradients[k], data.shape_gradients[k],
-                          mapping_data, mapping_covariant);
+        {
+          fe_data.transformed_shape_gradients.resize (quadrature.size());
+          mapping.transform(fe_data.shape_gradients[k], fe_data.transformed_shape_gradients,
+                            mapping_data, mapping_covariant);
+          std::copy (fe_data.transformed_shape_gradients.begin(),
+                     fe_data.transformed_shape_gradients.end(),
+                     data.shape_gradients[k].begin());
+        }
     }
 
   if (flags & update_hessians && cell_similarity != CellSimilarity::translation)
@@ -130,8 +142,14 @@ FE_Poly<PolynomialSpace<1>,1,2>::fill_fe_values (
           data.shape_values(k,i) = fe_data.shape_values[k][i];
 
       if (flags & update_gradients && cell_similarity != CellSimilarity::translation)
-        mapping.transform(fe_data.shape_gradients[k], data.shape_gradients[k],
-                          mapping_data, mapping_covariant);
+        {
+          fe_data.transformed_shape_gradients.resize (quadrature.size());
+          mapping.transform(fe_data.shape_gradients[k], fe_data.transformed_shape_gradients,
+                            mapping_data, mapping_covariant);
+          std::copy (fe_data.transformed_shape_gradients.begin(),
+                     fe_data.transformed_shape_gradients.end(),
+                     data.shape_gradients[k].begin());
+        }
     }
 
   if (flags & update_hessians && cell_similarity != CellSimilarity::translation)
@@ -164,8 +182,14 @@ FE_Poly<PolynomialSpace<2>,2,3>::fill_fe_values
 
 
       if (flags & update_gradients && cell_similarity != CellSimilarity::translation)
-        mapping.transform(fe_data.shape_gradients[k], data.shape_gradients[k],
-                          mapping_data, mapping_covariant);
+        {
+          fe_data.transformed_shape_gradients.resize (quadrature.size());
+          mapping.transform(fe_data.shape_gradients[k], fe_data.transformed_shape_gradients,
+                            mapping_data, mapping_covariant);
+          std::copy (fe_data.transformed_shape_gradients.begin(),
+                     fe_data.transformed_shape_gradients.end(),
+                     data.shape_gradients[k].begin());
+        }
     }
 
   if (flags & update_hessians && cell_similarity != CellSimilarity::translation)
@@ -17,6 +17,7 @@
 
 #include <deal.II/base/derivative_form.h>
 #include <deal.II/base/qprojector.h>
+#include <deal.II/base/table.h>
 #include <deal.II/base/polynomials_bdm.h>
 #include <deal.II/base/polynomials_raviart_thomas.h>
 #include <deal.II/base/polynomials_abf.h>
@@ -342,42 +343,72 @@ FE_PolyTensor<POLY,dim,spacedim>::get_data (
   // N_i(v_j)=\delta_ij for all basis
   // functions v_j
   if (flags & (update_values | update_gradients))
-    for (unsigned int k=0; k<n_q_points; ++k)
-      {
-        poly_space.compute(quadrature.point(k),
-                           values, grads, grad_grads);
+    {
+      // first evaluate the polynomials at all quadrature points
+      Table<2,Tensor<1,dim> > raw_values ((flags & update_values) ? this->dofs_per_cell : 0,
+                                          n_q_points);
+      Table<2,Tensor<2,dim> > raw_grads ((flags & update_gradients) ? this->dofs_per_cell : 0,
+                                         n_q_points);
+      for (unsigned int k=0; k<n_q_points; ++k)
+        {
+          poly_space.compute(quadrature.point(k),
+                             values, grads, grad_grads);
+          for (unsigned int i=0; i<values.size(); ++i)
+            raw_values(i,k) = values[i];
+          for (unsigned int i=0; i<grads.size(); ++i)
+            raw_grads(i,k) = grads[i];
+        }
 
-        if (flags & update_values)
-          {
-            if (inverse_node_matrix.n_cols() == 0)
-              for (unsigned int i=0; i<this->dofs_per_cell; ++i)
-                data->shape_values[i][k] = values[i];
-            else
-              for (unsigned int i=0; i<this->dofs_per_cell; ++i)
-                {
-                  Tensor<1,dim> add_values;
-                  for (unsigned int j=0; j<this->dofs_per_cell; ++j)
-                    add_values += inverse_node_matrix(j,i) * values[j];
-                  data->shape_values[i][k] = add_values;
-                }
-          }
+      // then multiply by the inverse node matrix, one shape function at a
+      // time with the quadrature points in the innermost loop. entries of
+      // the node matrix that are zero, of which there are many for most
+      // elements, are skipped
+      if (flags & update_values)
+        {
+          if (inverse_node_matrix.n_cols() == 0)
+            for (unsigned int i=0; i<this->dofs_per_cell; ++i)
+              for (unsigned int k=0; k<n_q_points; ++k)
+                data->shape_values[i][k] = raw_values(i,k);
+          else
+            for (unsigned int i=0; i<this->dofs_per_cell; ++i)
+              {
+                Tensor<1,dim> *shape_values_i = &data->shape_values[i][0];
+                for (unsigned int j=0; j<this->dofs_per_cell; ++j)
+                  if (inverse_node_matrix(j,i) != 0)
+                    {
+                      const double c = inverse_node_matrix(j,i);
+                      for (unsigned int k=0; k<n_q_points; ++k)
+                        shape_values_i[k] += c * raw_values(j,k);
+                    }
+              }
+        }
 
-        if (flags & update_gradients)
-          {
-            if (inverse_node_matrix.n_cols() == 0)
-              for (unsigned int i=0; i<this->dofs_per_cell; ++i)
-                data->shape_grads[i][k] = grads[i];
-            else
+      if (flags & update_gradients)
+        {
+          if (inverse_node_matrix.n_cols() == 0)
+            for (unsigned int i=0; i<this->dofs_per_cell; ++i)
+              for (unsigned int k=0; k<n_q_points; ++k)
+                data->shape_grads[i][k] = raw_grads(i,k);
+          else
+            {
+              std::vector<Tensor<2,dim> > shape_grads_i (n_q_points);
               for (unsigned int i=0; i<this->dofs_per_cell; ++i)
                 {
-                  Tensor<2,dim> add_grads;
+                  std::fill (shape_grads_i.begin(), shape_grads_i.end(),
+                             Tensor<2,dim>());
                   for (unsigned int j=0; j<this->dofs_per_cell; ++j)
-                    add_grads += inverse_node_matrix(j,i) * grads[j];
-                  data->shape_grads[i][k] = add_grads;
+                    if (inverse_node_matrix(j,i) != 0)
+                      {
+                        const double c = inverse_node_matrix(j,i);
+                        for (unsigned int k=0; k<n_q_points; ++k)
+                          shape_grads_i[k] += c * raw_grads(j,k);
+                      }
+                  for (unsigned int k=0; k<n_q_points; ++k)
+                    data->shape_grads[i][k] = shape_grads_i[k];
                 }
-          }
-
-      }
+            }
+        }
+    }
   return data;
 }
 
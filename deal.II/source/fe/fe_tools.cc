@@ -49,6 +49,13 @@
 #include <deal.II/base/index_set.h>
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+#ifdef HAVE_UNISTD_H
+#  include <unistd.h>
+#endif
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -212,6 +219,23 @@ namespace
       std_cxx1x::shared_ptr<const FETools::FEFactoryBase<3> > >
       fe_name_map_3d
       = get_default_fe_names<3> ();
+
+  // the directory in which
+  // FETools::compute_embedding_matrices
+  // and
+  // FETools::compute_projection_matrices
+  // store the matrices they compute,
+  // and a lock that protects access to
+  // it. an empty string means that
+  // the matrices are not cached. the
+  // counter is used to create unique
+  // names for temporary files
+  static
+  std::string matrix_cache_directory;
+  static
+  unsigned int matrix_cache_file_counter = 0;
+  static
+  Threads::Mutex matrix_cache_lock;
 }
 
 
@@ -852,6 +876,351 @@ namespace FETools
       Assert (cell_number == GeometryInfo<dim>::n_children (RefinementCase<dim> (ref_case)),
               ExcInternalError ());
     }
+
+
+
+    template<int dim, typename number, int spacedim>
+    void
+    compute_projection_matrices_for_refinement_case (
+      const FiniteElement<dim, spacedim> &fe,
+      const FullMatrix<number> &inverse_mass,
+      std::vector<FullMatrix<number> > &matrices,
+      const unsigned int ref_case)
+    {
+      const unsigned int n  = fe.dofs_per_cell;
+      const unsigned int nd = fe.n_components();
+      const unsigned int degree = fe.degree;
+      const unsigned int
+      nc = GeometryInfo<dim>::n_children(RefinementCase<dim>(ref_case));
+
+      for (unsigned int i=0; i<nc; ++i)
+        {
+          Assert(matrices[i].n() == n,
+                 ExcDimensionMismatch(matrices[i].n(),n));
+          Assert(matrices[i].m() == n,
+                 ExcDimensionMismatch(matrices[i].m(),n));
+        }
+
+      // create a respective refinement on the
+      // triangulation
+      Triangulation<dim,spacedim> tr;
+      GridGenerator::hyper_cube (tr, 0, 1);
+      tr.begin_active()->set_refine_flag(RefinementCase<dim>(ref_case));
+      tr.execute_coarsening_and_refinement();
+
+      MappingQ1<dim,spacedim> mapping;
+      QGauss<dim> q_fine(degree+1);
+      const unsigned int nq = q_fine.size();
+
+      FEValues<dim,spacedim> fine (mapping, fe, q_fine,
+                                   update_quadrature_points | update_JxW_values |
+                                   update_values);
+
+      typename Triangulation<dim,spacedim>::cell_iterator coarse_cell
+        = tr.begin(0);
+
+      Vector<number> v_coarse(n);
+      Vector<number> v_fine(n);
+
+      for (unsigned int cell_number=0; cell_number<nc; ++cell_number)
+        {
+          FullMatrix<double> &this_matrix = matrices[cell_number];
+
+          // Compute right hand side,
+          // which is a fine level basis
+          // function tested with the
+          // coarse level functions.
+          fine.reinit(coarse_cell->child(cell_number));
+          const std::vector<Point<spacedim> > &q_points_fine = fine.get_quadrature_points();
+          std::vector<Point<dim> > q_points_coarse(q_points_fine.size());
+          for (unsigned int q=0; q<q_points_fine.size(); ++q)
+            for (unsigned int j=0; j<dim; ++j)
+              q_points_coarse[q](j) = q_points_fine[q](j);
+          Quadrature<dim> q_coarse (q_points_coarse,
+                                    fine.get_JxW_values());
+          FEValues<dim,spacedim> coarse (mapping, fe, q_coarse, update_values);
+          coarse.reinit(coarse_cell);
+
+          // Build RHS
+
+          const std::vector<double> &JxW = fine.get_JxW_values();
+
+          // Outer loop over all fine
+          // grid shape functions phi_j
+          for (unsigned int j=0; j<fe.dofs_per_cell; ++j)
+            {
+              for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
+                {
+                  if (fe.is_primitive())
+                    {
+                      const double *coarse_i = &coarse.shape_value(i,0);
+                      const double *fine_j = &fine.shape_value(j,0);
+
+                      double update = 0;
+                      for (unsigned int k=0; k<nq; ++k)
+                        update += JxW[k] * coarse_i[k] * fine_j[k];
+                      v_fine(i) = update;
+                    }
+                  else
+                    {
+                      double update = 0;
+                      for (unsigned int d=0; d<nd; ++d)
+                        for (unsigned int k=0; k<nq; ++k)
+                          update += JxW[k] * coarse.shape_value_component(i,k,d)
+                                    * fine.shape_value_component(j,k,d);
+                      v_fine(i) = update;
+                    }
+                }
+
+              // RHS ready. Solve system
+              // and enter row into
+              // matrix
+              inverse_mass.vmult (v_coarse, v_fine);
+              for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
+                this_matrix(i,j) = v_coarse(i);
+            }
+
+          // Remove small entries from
+          // the matrix
+          for (unsigned int i=0; i<this_matrix.m(); ++i)
+            for (unsigned int j=0; j<this_matrix.n(); ++j)
+              if (std::fabs(this_matrix(i,j)) < 1e-12)
+                this_matrix(i,j) = 0.;
+        }
+    }
+
+
+
+    /**
+     * Return the name of the file in
+     * which the matrices of the given
+     * kind are cached for the finite
+     * element @p fe, or an empty string
+     * if no cache directory was set. All
+     * characters of the name of the
+     * element that are not letters or
+     * digits are replaced by a '-'
+     * followed by their hexadecimal code.
+     */
+    template<int dim, int spacedim>
+    std::string
+    matrix_cache_file_name (const FiniteElement<dim,spacedim> &fe,
+                            const std::string                 &kind,
+                            const bool                         isotropic_only)
+    {
+      std::string directory;
+      {
+        Threads::Mutex::ScopedLock lock(matrix_cache_lock);
+        directory = matrix_cache_directory;
+      }
+      if (directory.size() == 0)
+        return "";
+
+      static const char hex_digits[] = "0123456789abcdef";
+      const std::string fe_name = fe.get_name();
+      std::string name;
+      for (unsigned int i=0; i<fe_name.size(); ++i)
+        {
+          const unsigned char c = fe_name[i];
+          if (((c >= 'a') && (c <= 'z')) ||
+              ((c >= 'A') && (c <= 'Z')) ||
+              ((c >= '0') && (c <= '9')))
+            name += c;
+          else
+            {
+              name += '-';
+              name += hex_digits[c / 16];
+              name += hex_digits[c % 16];
+            }
+        }
+
+      return (directory + "/" + name + "." + kind
+              + (isotropic_only ? ".isotropic" : "")
+              + "." + Utilities::int_to_string(spacedim)
+              + ".matrices");
+    }
+
+
+
+    /**
+     * The first line of files written
+     * by write_cached_matrices().
+     */
+    const char matrix_cache_header[] = "deal.II refinement matrices 1";
+
+
+
+    /**
+     * Return the values of all
+     * components of all shape functions
+     * of @p fe at an arbitrary point
+     * inside the reference cell. These
+     * values are stored along with the
+     * cached matrices to detect files
+     * that were written for a different
+     * element of the same name, for
+     * instance for an
+     * FE_DGQArbitraryNodes object with
+     * other support points.
+     */
+    template<int dim, int spacedim>
+    std::vector<double>
+    shape_function_fingerprint (const FiniteElement<dim,spacedim> &fe)
+    {
+      Point<dim> p;
+      for (unsigned int d=0; d<dim; ++d)
+        p(d) = 0.3141592 + 0.1 * d;
+
+      std::vector<double> values;
+      values.reserve (fe.dofs_per_cell * fe.n_components());
+      for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
+        for (unsigned int c=0; c<fe.n_components(); ++c)
+          values.push_back (fe.shape_value_component (i, p, c));
+      return values;
+    }
+
+
+
+    /**
+     * Read the matrices for the
+     * refinement cases starting at
+     * <tt>first_ref_case</tt> from the
+     * given file. The matrices must
+     * already have their correct
+     * sizes. Return whether reading was
+     * successful; if not, the contents
+     * of the matrices are undefined.
+     */
+    template<int dim, typename number, int spacedim>
+    bool
+    read_cached_matrices (const std::string                               &filename,
+                          const FiniteElement<dim,spacedim>               &fe,
+                          const unsigned int                               first_ref_case,
+                          std::vector<std::vector<FullMatrix<number> > > &matrices)
+    {
+      std::ifstream in (filename.c_str(), std::ios::binary);
+      if (!in)
+        return false;
+
+      std::string header, name;
+      std::getline (in, header);
+      std::getline (in, name);
+      if (!in || (header != matrix_cache_header) || (name != fe.get_name()))
+        return false;
+
+      const std::vector<double> fingerprint = shape_function_fingerprint (fe);
+      std::vector<double> values (fingerprint.size());
+      unsigned int n_values;
+      in.read (reinterpret_cast<char *>(&n_values), sizeof(n_values));
+      if (!in || (n_values != values.size()))
+        return false;
+      if (values.size() > 0)
+        in.read (reinterpret_cast<char *>(&values[0]),
+                 values.size() * sizeof(double));
+      if (!in)
+        return false;
+      for (unsigned int i=0; i<values.size(); ++i)
+        if (std::fabs (values[i] - fingerprint[i]) >
+            1e-12 * (1. + std::fabs (fingerprint[i])))
+          return false;
+
+      for (unsigned int ref_case = first_ref_case;
+           ref_case <= RefinementCase<dim>::isotropic_refinement; ++ref_case)
+        for (unsigned int c=0; c<matrices[ref_case-1].size(); ++c)
+          {
+            FullMatrix<number> &matrix = matrices[ref_case-1][c];
+
+            unsigned int size[2];
+            in.read (reinterpret_cast<char *>(&size[0]), sizeof(size));
+            if (!in || (size[0] != matrix.m()) || (size[1] != matrix.n()))
+              return false;
+
+            values.resize (matrix.m() * matrix.n());
+            if (values.size() == 0)
+              continue;
+            in.read (reinterpret_cast<char *>(&values[0]),
+                     values.size() * sizeof(double));
+            if (!in)
+              return false;
+
+            for (unsigned int i=0; i<matrix.m(); ++i)
+              for (unsigned int j=0; j<matrix.n(); ++j)
+                matrix(i,j) = values[i*matrix.n()+j];
+          }
+
+      // the file must not contain more
+      // data than we expected
+      return (in.peek() == std::ifstream::traits_type::eof());
+    }
+
+
+
+    /**
+     * The counterpart of
+     * read_cached_matrices(). The file
+     * is first written under a temporary
+     * name and then renamed, so that
+     * other threads or processes that
+     * compute the same matrices at the
+     * same time never read an incomplete
+     * file. Errors are ignored since the
+     * cache is only an optimization.
+     */
+    template<int dim, typename number, int spacedim>
+    void
+    write_cached_matrices (const std::string                                     &filename,
+                           const FiniteElement<dim,spacedim>                     &fe,
+                           const unsigned int                                     first_ref_case,
+                           const std::vector<std::vector<FullMatrix<number> > > &matrices)
+    {
+      std::ostringstream tmp_name;
+      tmp_name << filename << ".tmp." << Utilities::System::get_hostname();
+#ifdef HAVE_UNISTD_H
+      tmp_name << '.' << getpid();
+#endif
+      {
+        Threads::Mutex::ScopedLock lock(matrix_cache_lock);
+        tmp_name << '.' << matrix_cache_file_counter++;
+      }
+
+      bool success;
+      {
+        std::ofstream out (tmp_name.str().c_str(), std::ios::binary);
+        out << matrix_cache_header << '\n'
+            << fe.get_name() << '\n';
+
+        std::vector<double> values = shape_function_fingerprint (fe);
+        const unsigned int n_values = values.size();
+        out.write (reinterpret_cast<const char *>(&n_values), sizeof(n_values));
+        if (values.size() > 0)
+          out.write (reinterpret_cast<const char *>(&values[0]),
+                     values.size() * sizeof(double));
+
+        for (unsigned int ref_case = first_ref_case;
+             ref_case <= RefinementCase<dim>::isotropic_refinement; ++ref_case)
+          for (unsigned int c=0; c<matrices[ref_case-1].size(); ++c)
+            {
+              const FullMatrix<number> &matrix = matrices[ref_case-1][c];
+
+              const unsigned int size[2] = { matrix.m(), matrix.n() };
+              out.write (reinterpret_cast<const char *>(&size[0]), sizeof(size));
+
+              values.resize (matrix.m() * matrix.n());
+              for (unsigned int i=0; i<matrix.m(); ++i)
+                for (unsigned int j=0; j<matrix.n(); ++j)
+                  values[i*matrix.n()+j] = matrix(i,j);
+              if (values.size() > 0)
+                out.write (reinterpret_cast<const char *>(&values[0]),
+                           values.size() * sizeof(double));
+            }
+        out.close ();
+        success = !out.fail();
+      }
+
+      if (!success ||
+          (std::rename (tmp_name.str().c_str(), filename.c_str()) != 0))
+        std::remove (tmp_name.str().c_str());
+    }
   }
 
 
@@ -861,18 +1230,30 @@ namespace FETools
                              std::vector<std::vector<FullMatrix<number> > > &matrices,
                              const bool isotropic_only)
   {
+    const unsigned int first_ref_case = (isotropic_only)
+                                        ? RefinementCase<dim>::isotropic_refinement
+                                        : RefinementCase<dim>::cut_x;
+
+    // see whether we have computed
+    // these matrices before
+    const std::string cache_file = matrix_cache_file_name (fe, "embedding",
+                                                           isotropic_only);
+    if ((cache_file.size() > 0) &&
+        read_cached_matrices (cache_file, fe, first_ref_case, matrices))
+      return;
+
     Threads::TaskGroup<void> task_group;
 
     // loop over all possible refinement cases
-    unsigned int ref_case = (isotropic_only)
-                            ? RefinementCase<dim>::isotropic_refinement
-                            : RefinementCase<dim>::cut_x;
-
-    for (; ref_case <= RefinementCase<dim>::isotropic_refinement; ++ref_case)
+    for (unsigned int ref_case = first_ref_case;
+         ref_case <= RefinementCase<dim>::isotropic_refinement; ++ref_case)
       task_group += Threads::new_task (&compute_embedding_matrices_for_refinement_case<dim, number, spacedim>,
                                        fe, matrices[ref_case-1], ref_case);
 
     task_group.join_all ();
+
+    if (cache_file.size() > 0)
+      write_cached_matrices (cache_file, fe, first_ref_case, matrices);
   }
 
 
@@ -1109,6 +1490,18 @@ namespace FETools
                               std::vector<std::vector<FullMatrix<number> > > &matrices,
                               const bool isotropic_only)
   {
+    const unsigned int first_ref_case = (isotropic_only)
+                                        ? RefinementCase<dim>::isotropic_refinement
+                                        : RefinementCase<dim>::cut_x;
+
+    // see whether we have computed
+    // these matrices before
+    const std::string cache_file = matrix_cache_file_name (fe, "projection",
+                                                           isotropic_only);
+    if ((cache_file.size() > 0) &&
+        read_cached_matrices (cache_file, fe, first_ref_case, matrices))
+      return;
+
     const unsigned int n  = fe.dofs_per_cell;
     const unsigned int nd = fe.n_components();
     const unsigned int degree = fe.degree;
@@ -1160,106 +1553,29 @@ namespace FETools
     }
 
     // loop over all possible
-    // refinement cases
-    unsigned int ref_case = (isotropic_only)
-                            ? RefinementCase<dim>::isotropic_refinement
-                            : RefinementCase<dim>::cut_x;
-    for (; ref_case <= RefinementCase<dim>::isotropic_refinement; ++ref_case)
-      {
-        const unsigned int
-        nc = GeometryInfo<dim>::n_children(RefinementCase<dim>(ref_case));
-
-        for (unsigned int i=0; i<nc; ++i)
-          {
-            Assert(matrices[ref_case-1][i].n() == n,
-                   ExcDimensionMismatch(matrices[ref_case-1][i].n(),n));
-            Assert(matrices[ref_case-1][i].m() == n,
-                   ExcDimensionMismatch(matrices[ref_case-1][i].m(),n));
-          }
-
-        // create a respective refinement on the
-        // triangulation
-        Triangulation<dim,spacedim> tr;
-        GridGenerator::hyper_cube (tr, 0, 1);
-        tr.begin_active()->set_refine_flag(RefinementCase<dim>(ref_case));
-        tr.execute_coarsening_and_refinement();
-
-        FEValues<dim,spacedim> fine (mapping, fe, q_fine,
-                                     update_quadrature_points | update_JxW_values |
-                                     update_values);
-
-        typename Triangulation<dim,spacedim>::cell_iterator coarse_cell
-          = tr.begin(0);
+    // refinement cases. the
+    // computations for different
+    // refinement cases are independent,
+    // so run them in parallel
+    Threads::TaskGroup<void> task_group;
+    for (unsigned int ref_case = first_ref_case;
+         ref_case <= RefinementCase<dim>::isotropic_refinement; ++ref_case)
+      task_group += Threads::new_task (&compute_projection_matrices_for_refinement_case<dim, number, spacedim>,
+                                       fe, mass, matrices[ref_case-1], ref_case);
 
-        Vector<number> v_coarse(n);
-        Vector<number> v_fine(n);
+    task_group.join_all ();
 
-        for (unsigned int cell_number=0; cell_number<nc; ++cell_number)
-          {
-            FullMatrix<double> &this_matrix = matrices[ref_case-1][cell_number];
-
-            // Compute right hand side,
-            // which is a fine level basis
-            // function tested with the
-            // coarse level functions.
-            fine.reinit(coarse_cell->child(cell_number));
-            const std::vector<Point<spacedim> > &q_points_fine = fine.get_quadrature_points();
-            std::vector<Point<dim> > q_points_coarse(q_points_fine.size());
-            for (unsigned int q=0; q<q_points_fine.size(); ++q)
-              for (unsigned int j=0; j<dim; ++j)
-                q_points_coarse[q](j) = q_points_fine[q](j);
-            Quadrature<dim> q_coarse (q_points_coarse,
-                                      fine.get_JxW_values());
-            FEValues<dim,spacedim> coarse (mapping, fe, q_coarse, update_values);
-            coarse.reinit(coarse_cell);
-
-            // Build RHS
-
-            const std::vector<double> &JxW = fine.get_JxW_values();
-
-            // Outer loop over all fine
-            // grid shape functions phi_j
-            for (unsigned int j=0; j<fe.dofs_per_cell; ++j)
-              {
-                for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
-                  {
-                    if (fe.is_primitive())
-                      {
-                        const double *coarse_i = &coarse.shape_value(i,0);
-                        const double *fine_j = &fine.shape_value(j,0);
+    if (cache_file.size() > 0)
+      write_cached_matrices (cache_file, fe, first_ref_case, matrices);
+  }
 
-                        double update = 0;
-                        for (unsigned int k=0; k<nq; ++k)
-                          update += JxW[k] * coarse_i[k] * fine_j[k];
-                        v_fine(i) = update;
-                      }
-                    else
-                      {
-                        double update = 0;
-                        for (unsigned int d=0; d<nd; ++d)
-                          for (unsigned int k=0; k<nq; ++k)
-                            update += JxW[k] * coarse.shape_value_component(i,k,d)
-                                      * fine.shape_value_component(j,k,d);
-                        v_fine(i) = update;
-                      }
-                  }
 
-                // RHS ready. Solve system
-                // and enter row into
-                // matrix
-                mass.vmult (v_coarse, v_fine);
-                for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
-                  this_matrix(i,j) = v_coarse(i);
-              }
 
-            // Remove small entries from
-            // the matrix
-            for (unsigned int i=0; i<this_matrix.m(); ++i)
-              for (unsigned int j=0; j<this_matrix.n(); ++j)
-                if (std::fabs(this_matrix(i,j)) < 1e-12)
-                  this_matrix(i,j) = 0.;
-          }
-      }
+  void
+  set_matrix_cache_directory (const std::string &directory)
+  {
+    Threads::Mutex::ScopedLock lock(matrix_cache_lock);
+    matrix_cache_directory = directory;
   }
 
 
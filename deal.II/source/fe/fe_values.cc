@@ -492,13 +492,13 @@ namespace FEValuesViews
     template <int order, int dim, int spacedim>
     void
     do_function_derivatives (const ::dealii::Vector<double> &dof_values,
-                             const std::vector<std::vector<dealii::Tensor<order,spacedim> > > &shape_derivatives,
+                             const dealii::Table<2,dealii::Tensor<order,spacedim> > &shape_derivatives,
                              const std::vector<typename Scalar<dim,spacedim>::ShapeFunctionData> &shape_function_data,
                              std::vector<dealii::Tensor<order,spacedim> > &derivatives)
     {
       const unsigned int dofs_per_cell = dof_values.size();
       const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                               shape_derivatives[0].size() : derivatives.size();
+                                               shape_derivatives.n_cols() : derivatives.size();
       AssertDimension (derivatives.size(), n_quadrature_points);
 
       std::fill (derivatives.begin(), derivatives.end(),
@@ -524,13 +524,13 @@ namespace FEValuesViews
     template <int dim, int spacedim>
     void
     do_function_laplacians (const ::dealii::Vector<double> &dof_values,
-                            const std::vector<std::vector<dealii::Tensor<2,spacedim> > > &shape_hessians,
+                            const dealii::Table<2,dealii::Tensor<2,spacedim> > &shape_hessians,
                             const std::vector<typename Scalar<dim,spacedim>::ShapeFunctionData> &shape_function_data,
                             std::vector<double>           &laplacians)
     {
       const unsigned int dofs_per_cell = dof_values.size();
       const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                               shape_hessians[0].size() : laplacians.size();
+                                               shape_hessians.n_cols() : laplacians.size();
       AssertDimension (laplacians.size(), n_quadrature_points);
 
       std::fill (laplacians.begin(), laplacians.end(), 0.);
@@ -605,13 +605,13 @@ namespace FEValuesViews
     template <int order, int dim, int spacedim>
     void
     do_function_derivatives (const ::dealii::Vector<double> &dof_values,
-                             const std::vector<std::vector<dealii::Tensor<order,spacedim> > > &shape_derivatives,
+                             const dealii::Table<2,dealii::Tensor<order,spacedim> > &shape_derivatives,
                              const std::vector<typename Vector<dim,spacedim>::ShapeFunctionData> &shape_function_data,
                              std::vector<dealii::Tensor<order+1,spacedim> > &derivatives)
     {
       const unsigned int dofs_per_cell = dof_values.size();
       const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                               shape_derivatives[0].size() : derivatives.size();
+                                               shape_derivatives.n_cols() : derivatives.size();
       AssertDimension (derivatives.size(), n_quadrature_points);
 
       std::fill (derivatives.begin(), derivatives.end(),
@@ -657,13 +657,13 @@ namespace FEValuesViews
     template <int dim, int spacedim>
     void
     do_function_symmetric_gradients (const ::dealii::Vector<double> &dof_values,
-                                     const std::vector<std::vector<dealii::Tensor<1,spacedim> > > &shape_gradients,
+                                     const dealii::Table<2,dealii::Tensor<1,spacedim> > &shape_gradients,
                                      const std::vector<typename Vector<dim,spacedim>::ShapeFunctionData> &shape_function_data,
                                      std::vector<dealii::SymmetricTensor<2,spacedim> > &symmetric_gradients)
     {
       const unsigned int dofs_per_cell = dof_values.size();
       const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                               shape_gradients[0].size() : symmetric_gradients.size();
+                                               shape_gradients.n_cols() : symmetric_gradients.size();
       AssertDimension (symmetric_gradients.size(), n_quadrature_points);
 
       std::fill (symmetric_gradients.begin(), symmetric_gradients.end(),
@@ -710,13 +710,13 @@ namespace FEValuesViews
     template <int dim, int spacedim>
     void
     do_function_divergences (const ::dealii::Vector<double> &dof_values,
-                             const std::vector<std::vector<dealii::Tensor<1,spacedim> > > &shape_gradients,
+                             const dealii::Table<2,dealii::Tensor<1,spacedim> > &shape_gradients,
                              const std::vector<typename Vector<dim,spacedim>::ShapeFunctionData> &shape_function_data,
                              std::vector<double> &divergences)
     {
       const unsigned int dofs_per_cell = dof_values.size();
       const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                               shape_gradients[0].size() : divergences.size();
+                                               shape_gradients.n_cols() : divergences.size();
       AssertDimension (divergences.size(), n_quadrature_points);
 
       std::fill (divergences.begin(), divergences.end(), 0.);
@@ -760,13 +760,13 @@ namespace FEValuesViews
     template <int dim, int spacedim>
     void
     do_function_curls (const ::dealii::Vector<double> &dof_values,
-                       const std::vector<std::vector<dealii::Tensor<1,spacedim> > > &shape_gradients,
+                       const dealii::Table<2,dealii::Tensor<1,spacedim> > &shape_gradients,
                        const std::vector<typename Vector<dim,spacedim>::ShapeFunctionData> &shape_function_data,
                        std::vector<typename dealii::internal::CurlType<spacedim>::type> &curls)
     {
       const unsigned int dofs_per_cell = dof_values.size();
       const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                               shape_gradients[0].size() : curls.size();
+                                               shape_gradients.n_cols() : curls.size();
       AssertDimension (curls.size(), n_quadrature_points);
 
       std::fill (curls.begin(), curls.end(), typename dealii::internal::CurlType<spacedim>::type());
@@ -952,13 +952,13 @@ namespace FEValuesViews
     template <int dim, int spacedim>
     void
     do_function_laplacians (const ::dealii::Vector<double> &dof_values,
-                            const std::vector<std::vector<dealii::Tensor<2,spacedim> > > &shape_hessians,
+                            const dealii::Table<2,dealii::Tensor<2,spacedim> > &shape_hessians,
                             const std::vector<typename Vector<dim,spacedim>::ShapeFunctionData> &shape_function_data,
                             std::vector<dealii::Tensor<1,spacedim> > &laplacians)
     {
       const unsigned int dofs_per_cell = dof_values.size();
       const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                               shape_hessians[0].size() : laplacians.size();
+                                               shape_hessians.n_cols() : laplacians.size();
       AssertDimension (laplacians.size(), n_quadrature_points);
 
       std::fill (laplacians.begin(), laplacians.end(),
@@ -1061,13 +1061,13 @@ namespace FEValuesViews
     template <int dim, int spacedim>
     void
     do_function_divergences (const ::dealii::Vector<double> &dof_values,
-                             const std::vector<std::vector<dealii::Tensor<1,spacedim> > > &shape_gradients,
+                             const dealii::Table<2,dealii::Tensor<1,spacedim> > &shape_gradients,
                              const std::vector<typename SymmetricTensor<2,dim,spacedim>::ShapeFunctionData> &shape_function_data,
                              std::vector<dealii::Tensor<1,spacedim> > &divergences)
     {
       const unsigned int dofs_per_cell = dof_values.size();
       const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                               shape_gradients[0].size() : divergences.size();
+                                               shape_gradients.n_cols() : divergences.size();
       AssertDimension (divergences.size(), n_quadrature_points);
 
       std::fill (divergences.begin(), divergences.end(),
@@ -1205,13 +1205,13 @@ namespace FEValuesViews
     template <int dim, int spacedim>
     void
     do_function_divergences (const ::dealii::Vector<double> &dof_values,
-                             const std::vector<std::vector<dealii::Tensor<1,spacedim> > > &shape_gradients,
+                             const dealii::Table<2,dealii::Tensor<1,spacedim> > &shape_gradients,
                              const std::vector<typename Tensor<2,dim,spacedim>::ShapeFunctionData> &shape_function_data,
                              std::vector<dealii::Tensor<1,spacedim> > &divergences)
     {
       const unsigned int dofs_per_cell = dof_values.size();
       const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                               shape_gradients[0].size() : divergences.size();
+                                               shape_gradients.n_cols() : divergences.size();
       AssertDimension (divergences.size(), n_quadrature_points);
 
       std::fill (divergences.begin(), divergences.end(),
@@ -2111,12 +2111,12 @@ FEValuesData<dim,spacedim>::initialize (const unsigned int        n_quadrature_p
                               n_quadrature_points);
 
   if (flags & update_gradients)
-    this->shape_gradients.resize (n_nonzero_shape_components,
-                                  std::vector<Tensor<1,spacedim> > (n_quadrature_points));
+    this->shape_gradients.reinit (n_nonzero_shape_components,
+                                  n_quadrature_points);
 
   if (flags & update_hessians)
-    this->shape_hessians.resize (n_nonzero_shape_components,
-                                 std::vector<Tensor<2,spacedim> > (n_quadrature_points));
+    this->shape_hessians.reinit (n_nonzero_shape_components,
+                                 n_quadrature_points);
 
   if (flags & update_quadrature_points)
     this->quadrature_points.resize(n_quadrature_points);
@@ -2278,6 +2278,38 @@ namespace internal
           AssertDimension (values[i].size(), result_components);
       }
 
+    // if all shape functions are primitive, each of them has exactly one
+    // row in shape_values, and these rows are in the order of the shape
+    // functions. this is the case for all scalar elements and for systems
+    // of them, and we can then skip the lookups in the tables of nonzero
+    // components and rows
+    if (fe.is_primitive())
+      {
+        for (unsigned int mc = 0; mc < component_multiple; ++mc)
+          for (unsigned int shape_func=0; shape_func<dofs_per_cell; ++shape_func)
+            {
+              const double value = dof_values_ptr[shape_func+mc*dofs_per_cell];
+              if (value == 0.)
+                continue;
+
+              const unsigned int comp =
+                fe.system_to_component_index(shape_func).first
+                + mc * n_components;
+              const double *shape_value_ptr = &shape_values(shape_func, 0);
+
+              if (quadrature_points_fastest)
+                {
+                  VectorType &values_comp = values[comp];
+                  for (unsigned int point=0; point<n_quadrature_points; ++point)
+                    values_comp[point] += value **shape_value_ptr++;
+                }
+              else
+                for (unsigned int point=0; point<n_quadrature_points; ++point)
+                  values[point][comp] += value **shape_value_ptr++;
+            }
+        return;
+      }
+
     // add up contributions of trial functions.  now check whether the shape
     // function is primitive or not. if it is, then set its only non-zero
     // component, otherwise loop over components
@@ -2339,12 +2371,12 @@ namespace internal
   template <int order, int spacedim>
   void
   do_function_derivatives (const double                     *dof_values_ptr,
-                           const std::vector<std::vector<Tensor<order,spacedim> > > &shape_derivatives,
+                           const dealii::Table<2,Tensor<order,spacedim> > &shape_derivatives,
                            std::vector<Tensor<order,spacedim> > &derivatives)
   {
-    const unsigned int dofs_per_cell = shape_derivatives.size();
+    const unsigned int dofs_per_cell = shape_derivatives.n_rows();
     const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                             shape_derivatives[0].size() : derivatives.size();
+                                             shape_derivatives.n_cols() : derivatives.size();
     AssertDimension(derivatives.size(), n_quadrature_points);
 
     // initialize with zero
@@ -2373,7 +2405,7 @@ namespace internal
   template <int order, int dim, int spacedim>
   void
   do_function_derivatives (const double                      *dof_values_ptr,
-                           const std::vector<std::vector<Tensor<order,spacedim> > > &shape_derivatives,
+                           const dealii::Table<2,Tensor<order,spacedim> > &shape_derivatives,
                            const FiniteElement<dim,spacedim> &fe,
                            const std::vector<unsigned int> &shape_function_to_row_table,
                            VectorSlice<std::vector<std::vector<Tensor<order,spacedim> > > > &derivatives,
@@ -2392,7 +2424,7 @@ namespace internal
       return;
 
 
-    const unsigned int n_quadrature_points = shape_derivatives[0].size();
+    const unsigned int n_quadrature_points = shape_derivatives.n_cols();
     const unsigned int n_components = fe.n_components();
 
     // Assert that we can write all components into the result vectors
@@ -2410,6 +2442,32 @@ namespace internal
           AssertDimension (derivatives[i].size(), result_components);
       }
 
+    // the same fast path for primitive elements as in do_function_values
+    if (fe.is_primitive())
+      {
+        for (unsigned int mc = 0; mc < component_multiple; ++mc)
+          for (unsigned int shape_func=0; shape_func<dofs_per_cell; ++shape_func)
+            {
+              const double value = dof_values_ptr[shape_func+mc*dofs_per_cell];
+              if (value == 0.)
+                continue;
+
+              const unsigned int comp =
+                fe.system_to_component_index(shape_func).first
+                + mc * n_components;
+              const Tensor<order,spacedim> *shape_derivative_ptr =
+                &shape_derivatives[shape_func][0];
+
+              if (quadrature_points_fastest)
+                for (unsigned int point=0; point<n_quadrature_points; ++point)
+                  derivatives[comp][point] += value **shape_derivative_ptr++;
+              else
+                for (unsigned int point=0; point<n_quadrature_points; ++point)
+                  derivatives[point][comp] += value **shape_derivative_ptr++;
+            }
+        return;
+      }
+
     // add up contributions of trial functions.  now check whether the shape
     // function is primitive or not. if it is, then set its only non-zero
     // component, otherwise loop over components
@@ -2464,12 +2522,12 @@ namespace internal
   template <int spacedim, typename Number>
   void
   do_function_laplacians (const double        *dof_values_ptr,
-                          const std::vector<std::vector<Tensor<2,spacedim> > > &shape_hessians,
+                          const dealii::Table<2,Tensor<2,spacedim> > &shape_hessians,
                           std::vector<Number> &laplacians)
   {
-    const unsigned int dofs_per_cell = shape_hessians.size();
+    const unsigned int dofs_per_cell = shape_hessians.n_rows();
     const unsigned int n_quadrature_points = dofs_per_cell > 0 ?
-                                             shape_hessians[0].size() : laplacians.size();
+                                             shape_hessians.n_cols() : laplacians.size();
     AssertDimension(laplacians.size(), n_quadrature_points);
 
     // initialize with zero
@@ -2494,7 +2552,7 @@ namespace internal
   template <int dim, int spacedim, typename VectorType>
   void
   do_function_laplacians (const double                    *dof_values_ptr,
-                          const std::vector<std::vector<Tensor<2,spacedim> > > &shape_hessians,
+                          const dealii::Table<2,Tensor<2,spacedim> > &shape_hessians,
                           const FiniteElement<dim,spacedim> &fe,
                           const std::vector<unsigned int> &shape_function_to_row_table,
                           std::vector<VectorType>         &laplacians,
@@ -2513,7 +2571,7 @@ namespace internal
       return;
 
 
-    const unsigned int n_quadrature_points = shape_hessians[0].size();
+    const unsigned int n_quadrature_points = shape_hessians.n_cols();
     const unsigned int n_components = fe.n_components();
 
     // Assert that we can write all components into the result vectors
@@ -2746,6 +2804,42 @@ void FEValuesBase<dim,spacedim>::get_function_values (
 
 
 
+template <int dim, int spacedim>
+template <typename number>
+void
+FEValuesBase<dim,spacedim>::get_function_values_from_local_dof_values (
+  const Vector<double> &local_dof_values,
+  std::vector<number>  &values) const
+{
+  Assert (this->update_flags & update_values,
+          ExcAccessToUninitializedField("update_values"));
+  AssertDimension (fe->n_components(), 1);
+  AssertDimension (local_dof_values.size(), dofs_per_cell);
+
+  internal::do_function_values (local_dof_values.begin(), this->shape_values,
+                                values);
+}
+
+
+
+template <int dim, int spacedim>
+template <typename number>
+void
+FEValuesBase<dim,spacedim>::get_function_values_from_local_dof_values (
+  const Vector<double>         &local_dof_values,
+  std::vector<Vector<number> > &values) const
+{
+  Assert (this->update_flags & update_values,
+          ExcAccessToUninitializedField("update_values"));
+  AssertDimension (local_dof_values.size(), dofs_per_cell);
+
+  VectorSlice<std::vector<Vector<number> > > val(values);
+  internal::do_function_values(local_dof_values.begin(), this->shape_values, *fe,
+                               this->shape_function_to_row_table, val);
+}
+
+
+
 template <int dim, int spacedim>
 template <class InputVector>
 void
@@ -2864,6 +2958,41 @@ void FEValuesBase<dim,spacedim>::get_function_gradients (
 
 
 
+template <int dim, int spacedim>
+void
+FEValuesBase<dim,spacedim>::get_function_gradients_from_local_dof_values (
+  const Vector<double>             &local_dof_values,
+  std::vector<Tensor<1,spacedim> > &gradients) const
+{
+  Assert (this->update_flags & update_gradients,
+          ExcAccessToUninitializedField("update_gradients"));
+  AssertDimension (fe->n_components(), 1);
+  AssertDimension (local_dof_values.size(), dofs_per_cell);
+
+  internal::do_function_derivatives(local_dof_values.begin(), this->shape_gradients,
+                                    gradients);
+}
+
+
+
+template <int dim, int spacedim>
+void
+FEValuesBase<dim,spacedim>::get_function_gradients_from_local_dof_values (
+  const Vector<double>                           &local_dof_values,
+  std::vector<std::vector<Tensor<1,spacedim> > > &gradients) const
+{
+  Assert (this->update_flags & update_gradients,
+          ExcAccessToUninitializedField("update_gradients"));
+  AssertDimension (local_dof_values.size(), dofs_per_cell);
+
+  VectorSlice<std::vector<std::vector<Tensor<1,spacedim> > > > grads(gradients);
+  internal::do_function_derivatives(local_dof_values.begin(), this->shape_gradients,
+                                    *fe, this->shape_function_to_row_table,
+                                    grads);
+}
+
+
+
 template <int dim, int spacedim>
 template <class InputVector>
 void
@@ -0,0 +1,322 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/fe/fe_poly.h>
+#include <deal.II/fe/fe_values_tensor_product.h>
+#include <deal.II/matrix_free/shape_info.templates.h>
+
+#include <algorithm>
+#include <typeinfo>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace
+{
+  // check whether the finite element is a scalar element with shape
+  // functions that are tensor products of one-dimensional polynomials
+  template <int dim>
+  bool
+  is_tensor_product_element (const FiniteElement<dim> &fe)
+  {
+    return ((fe.n_components() == 1)
+            &&
+            (dynamic_cast<const FE_Poly<TensorProductPolynomials<dim>,dim,dim>*>(&fe) != 0)
+            &&
+            (fe.dofs_per_cell == Utilities::fixed_power<dim>(fe.degree+1)));
+  }
+
+
+
+  // apply the one-dimensional operation given by shape_data to all lines
+  // in one coordinate direction of a lexicographically ordered array. the
+  // directions before this one contain n_pre entries (in the already
+  // transformed size nn), the ones after it n_post entries (in the
+  // original size mm)
+  template <bool dof_to_quad, bool add>
+  void
+  apply_1d (const double      *shape_data,
+            const unsigned int n_dofs_1d,
+            const unsigned int n_q_points_1d,
+            const unsigned int n_pre,
+            const unsigned int n_post,
+            const double      *in,
+            double            *out)
+  {
+    const unsigned int mm = dof_to_quad ? n_dofs_1d : n_q_points_1d,
+                       nn = dof_to_quad ? n_q_points_1d : n_dofs_1d;
+
+    for (unsigned int i2=0; i2<n_post; ++i2)
+      {
+        const double *in_block  = in  + i2*mm*n_pre;
+        double       *out_block = out + i2*nn*n_pre;
+        for (unsigned int col=0; col<nn; ++col)
+          {
+            double *out_col = out_block + col*n_pre;
+            if (add == false)
+              for (unsigned int i1=0; i1<n_pre; ++i1)
+                out_col[i1] = 0;
+            for (unsigned int ind=0; ind<mm; ++ind)
+              {
+                const double shape = dof_to_quad ?
+                                     shape_data[ind*n_q_points_1d+col] :
+                                     shape_data[col*n_q_points_1d+ind];
+                const double *in_ind = in_block + ind*n_pre;
+                for (unsigned int i1=0; i1<n_pre; ++i1)
+                  out_col[i1] += shape * in_ind[i1];
+              }
+          }
+      }
+  }
+}
+
+
+
+template <int dim>
+FEValuesTensorProduct<dim>::FEValuesTensorProduct (const FiniteElement<dim> &fe,
+                                                   const Quadrature<1>      &quadrature_1d)
+  :
+  dofs_per_cell (fe.dofs_per_cell),
+  n_quadrature_points (Utilities::fixed_power<dim>(quadrature_1d.size())),
+  fe (&fe, typeid(*this).name()),
+  n_dofs_1d (fe.degree+1),
+  n_q_points_1d (quadrature_1d.size()),
+  quadrature (quadrature_1d),
+  quadrature_points (n_quadrature_points),
+  JxW_values (n_quadrature_points),
+  lexicographic_values (dofs_per_cell),
+  scratch (3*Utilities::fixed_power<dim>(std::max (n_dofs_1d, n_q_points_1d)))
+{
+  AssertThrow (is_tensor_product_element (fe), ExcFENotTensorProduct());
+  shape_info.reinit (quadrature_1d, fe);
+}
+
+
+
+template <int dim>
+void
+FEValuesTensorProduct<dim>::reinit (const typename Triangulation<dim>::cell_iterator &cell)
+{
+  dof_indices.clear ();
+
+  // the columns of the Jacobian are the edges of the cell that start at
+  // vertex zero
+  const Point<dim> origin = cell->vertex(0);
+  Tensor<2,dim> jacobian;
+  for (unsigned int d=0; d<dim; ++d)
+    {
+      const Point<dim> edge = cell->vertex(1<<d) - origin;
+      for (unsigned int e=0; e<dim; ++e)
+        jacobian[e][d] = edge[e];
+    }
+
+  // the other vertices must be where the affine map puts them
+  const double tolerance = 1e-10 * cell->diameter();
+  for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+    {
+      Point<dim> unit_vertex;
+      for (unsigned int d=0; d<dim; ++d)
+        unit_vertex[d] = (v >> d) & 1;
+      const Point<dim> mapped_vertex = origin + jacobian * unit_vertex;
+      AssertThrow (cell->vertex(v).distance (mapped_vertex) <= tolerance,
+                   ExcCellNotAffine());
+    }
+
+  const double det = determinant (jacobian);
+  Assert (det > 0, ExcMessage ("The cell has negative or zero volume."));
+  present_inverse_jacobian = invert (jacobian);
+
+  for (unsigned int q=0; q<n_quadrature_points; ++q)
+    {
+      quadrature_points[q] = origin + jacobian * quadrature.point(q);
+      JxW_values[q] = det * quadrature.weight(q);
+    }
+}
+
+
+
+template <int dim>
+template <bool dof_to_quad, bool add>
+void
+FEValuesTensorProduct<dim>::apply_tensor_product (const double *const shape_data[dim],
+                                                  const double       *in,
+                                                  double             *out) const
+{
+  const unsigned int mm = dof_to_quad ? n_dofs_1d : n_q_points_1d,
+                     nn = dof_to_quad ? n_q_points_1d : n_dofs_1d;
+  const unsigned int max_size = scratch.size() / 3;
+  double *tmp[2] = { &scratch[max_size], &scratch[2*max_size] };
+
+  unsigned int n_pre = 1,
+               n_post = Utilities::fixed_power<dim>(mm) / mm;
+  const double *source = in;
+  for (unsigned int d=0; d<dim; ++d)
+    {
+      double *destination = (d == dim-1) ? out : tmp[d%2];
+      if ((d == dim-1) && (add == true))
+        apply_1d<dof_to_quad,true> (shape_data[d], n_dofs_1d, n_q_points_1d,
+                                    n_pre, n_post, source, destination);
+      else
+        apply_1d<dof_to_quad,false> (shape_data[d], n_dofs_1d, n_q_points_1d,
+                                     n_pre, n_post, source, destination);
+      source = destination;
+      n_pre *= nn;
+      n_post /= mm;
+    }
+}
+
+
+
+template <int dim>
+void
+FEValuesTensorProduct<dim>::read_local_dof_values (const Vector<double> &local_dof_values) const
+{
+  AssertDimension (local_dof_values.size(), dofs_per_cell);
+  for (unsigned int i=0; i<dofs_per_cell; ++i)
+    lexicographic_values[i] = local_dof_values(shape_info.lexicographic_numbering[i]);
+}
+
+
+
+template <int dim>
+void
+FEValuesTensorProduct<dim>::
+get_function_values_from_local_dof_values (const Vector<double> &local_dof_values,
+                                           std::vector<double>  &values) const
+{
+  AssertDimension (values.size(), n_quadrature_points);
+  read_local_dof_values (local_dof_values);
+
+  const double *shape_data[dim];
+  for (unsigned int d=0; d<dim; ++d)
+    shape_data[d] = &shape_info.shape_values_number[0];
+  apply_tensor_product<true,false> (shape_data, &lexicographic_values[0],
+                                    &values[0]);
+}
+
+
+
+template <int dim>
+void
+FEValuesTensorProduct<dim>::
+get_function_gradients_from_local_dof_values (const Vector<double>        &local_dof_values,
+                                              std::vector<Tensor<1,dim> > &gradients) const
+{
+  AssertDimension (gradients.size(), n_quadrature_points);
+  read_local_dof_values (local_dof_values);
+
+  // compute the derivatives in the directions of the reference cell one
+  // after the other, by applying the one-dimensional derivatives in one
+  // direction and the values in all others, and transform them to real
+  // space
+  double *reference_derivative = &scratch[0];
+  for (unsigned int q=0; q<n_quadrature_points; ++q)
+    gradients[q] = Tensor<1,dim>();
+  for (unsigned int d=0; d<dim; ++d)
+    {
+      const double *shape_data[dim];
+      for (unsigned int e=0; e<dim; ++e)
+        shape_data[e] = (e == d) ? &shape_info.shape_gradient_number[0] :
+                        &shape_info.shape_values_number[0];
+      apply_tensor_product<true,false> (shape_data, &lexicographic_values[0],
+                                        reference_derivative);
+      for (unsigned int q=0; q<n_quadrature_points; ++q)
+        for (unsigned int e=0; e<dim; ++e)
+          gradients[q][e] += reference_derivative[q] * present_inverse_jacobian[d][e];
+    }
+}
+
+
+
+template <int dim>
+void
+FEValuesTensorProduct<dim>::integrate (const std::vector<double>         &values,
+                                       const std::vector<Tensor<1,dim> > &gradients,
+                                       Vector<double>                    &cell_vector) const
+{
+  AssertDimension (cell_vector.size(), dofs_per_cell);
+  Assert (values.size() == 0 || values.size() == n_quadrature_points,
+          ExcDimensionMismatch (values.size(), n_quadrature_points));
+  Assert (gradients.size() == 0 || gradients.size() == n_quadrature_points,
+          ExcDimensionMismatch (gradients.size(), n_quadrature_points));
+
+  std::fill (lexicographic_values.begin(), lexicographic_values.end(), 0.);
+  double *weighted = &scratch[0];
+
+  if (values.size() > 0)
+    {
+      for (unsigned int q=0; q<n_quadrature_points; ++q)
+        weighted[q] = values[q] * JxW_values[q];
+
+      const double *shape_data[dim];
+      for (unsigned int d=0; d<dim; ++d)
+        shape_data[d] = &shape_info.shape_values_number[0];
+      apply_tensor_product<false,true> (shape_data, weighted,
+                                        &lexicographic_values[0]);
+    }
+
+  if (gradients.size() > 0)
+    for (unsigned int d=0; d<dim; ++d)
+      {
+        // test with the derivative in direction d of the reference cell,
+        // i.e., multiply the gradients by the transpose of the inverse
+        // Jacobian
+        for (unsigned int q=0; q<n_quadrature_points; ++q)
+          {
+            double sum = 0;
+            for (unsigned int e=0; e<dim; ++e)
+              sum += present_inverse_jacobian[d][e] * gradients[q][e];
+            weighted[q] = sum * JxW_values[q];
+          }
+
+        const double *shape_data[dim];
+        for (unsigned int e=0; e<dim; ++e)
+          shape_data[e] = (e == d) ? &shape_info.shape_gradient_number[0] :
+                          &shape_info.shape_values_number[0];
+        apply_tensor_product<false,true> (shape_data, weighted,
+                                          &lexicographic_values[0]);
+      }
+
+  for (unsigned int i=0; i<dofs_per_cell; ++i)
+    cell_vector(shape_info.lexicographic_numbering[i]) += lexicographic_values[i];
+}
+
+
+
+template <int dim>
+std::size_t
+FEValuesTensorProduct<dim>::memory_consumption () const
+{
+  return (sizeof(*this) +
+          shape_info.memory_consumption() +
+          MemoryConsumption::memory_consumption (quadrature) +
+          MemoryConsumption::memory_consumption (quadrature_points) +
+          MemoryConsumption::memory_consumption (JxW_values) +
+          MemoryConsumption::memory_consumption (dof_indices) +
+          MemoryConsumption::memory_consumption (lexicographic_values) +
+          MemoryConsumption::memory_consumption (scratch));
+}
+
+
+
+#include "fe_values_tensor_product.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -18,6 +18,8 @@
 #include <deal.II/grid/tria.h>
 #include <deal.II/fe/mapping.h>
 
+#include <limits>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -26,6 +28,28 @@ Mapping<dim, spacedim>::~Mapping ()
 {}
 
 
+template <int dim, int spacedim>
+void
+Mapping<dim, spacedim>::transform_points_real_to_unit_cell (
+  const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+  const std::vector<Point<spacedim> >                       &real_points,
+  std::vector<Point<dim> >                                  &unit_points) const
+{
+  unit_points.resize (real_points.size());
+  for (unsigned int i=0; i<real_points.size(); ++i)
+    try
+      {
+        unit_points[i] = transform_real_to_unit_cell (cell, real_points[i]);
+      }
+    catch (const ExcTransformationFailed &)
+      {
+        unit_points[i] = Point<dim>();
+        unit_points[i][0] = std::numeric_limits<double>::infinity();
+      }
+}
+
+
+
 // This function is deprecated and has been replaced by transform above
 template<int dim, int spacedim>
 void
@@ -834,6 +834,30 @@ MappingCartesian<dim, spacedim>::transform_real_to_unit_cell (
 }
 
 
+template<int dim, int spacedim>
+void
+MappingCartesian<dim, spacedim>::transform_points_real_to_unit_cell (
+  const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+  const std::vector<Point<spacedim> >                       &real_points,
+  std::vector<Point<dim> >                                  &unit_points) const
+{
+  if (dim != spacedim)
+    Assert(false, ExcNotImplemented());
+  const Point<dim> &start = cell->vertex(0);
+
+  // the inverse lengths of the cell in the coordinate directions. the
+  // vertex opposite to vertex 0 in direction d is vertex 2^d
+  double inverse_length[dim];
+  for (unsigned int d=0; d<dim; ++d)
+    inverse_length[d] = 1./(cell->vertex(1<<d)(d) - start(d));
+
+  unit_points.resize (real_points.size());
+  for (unsigned int q=0; q<real_points.size(); ++q)
+    for (unsigned int d=0; d<dim; ++d)
+      unit_points[q](d) = (real_points[q](d) - start(d)) * inverse_length[d];
+}
+
+
 template<int dim, int spacedim>
 Mapping<dim, spacedim> *
 MappingCartesian<dim, spacedim>::clone () const
@@ -28,6 +28,7 @@
 #include <deal.II/fe/mapping_q.h>
 #include <deal.II/fe/fe_q.h>
 
+#include <limits>
 #include <numeric>
 #include <memory>
 
@@ -1249,6 +1250,68 @@ transform_real_to_unit_cell (const typename Triangulation<dim,spacedim>::cell_it
 
 
 
+template<int dim, int spacedim>
+void
+MappingQ<dim,spacedim>::
+transform_points_real_to_unit_cell (const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+                                    const std::vector<Point<spacedim> >                       &real_points,
+                                    std::vector<Point<dim> >                                  &unit_points) const
+{
+  // first transform all points with the Q1 mapping. as in
+  // transform_real_to_unit_cell, this is all we need to do for interior
+  // cells with dim==spacedim, including the marking of points for which
+  // the transformation failed
+  MappingQ1<dim,spacedim>::transform_points_real_to_unit_cell (cell, real_points,
+      unit_points);
+
+  if (!(cell->has_boundary_lines()
+        ||
+        use_mapping_q_on_all_cells
+        ||
+        (dim!=spacedim)))
+    return;
+
+  // otherwise continue with a Newton iteration based on the full mapping
+  // for each point, but set up the data for it only once
+  Point<dim> center;
+  for (unsigned int d=0; d<dim; ++d)
+    center[d] = 0.5;
+
+  UpdateFlags update_flags = update_transformation_values|update_transformation_gradients;
+  if (spacedim>dim)
+    update_flags |= update_jacobian_grads;
+  std::auto_ptr<InternalData>
+  mdata (dynamic_cast<InternalData *> (
+           get_data(update_flags, Quadrature<dim>(center))));
+
+  mdata->use_mapping_q1_on_current_cell = false;
+
+  compute_mapping_support_points (cell, mdata->mapping_support_points);
+  if (mdata->shape_values.size() < mdata->mapping_support_points.size())
+    mdata->mapping_support_points.resize(GeometryInfo<dim>::vertices_per_cell);
+
+  for (unsigned int q=0; q<real_points.size(); ++q)
+    {
+      // start from the center of the cell if the Q1 iteration failed
+      const Point<dim> initial_p_unit
+        = GeometryInfo<dim>::project_to_unit_cell(numbers::is_finite(unit_points[q][0]) ?
+                                                  unit_points[q] :
+                                                  center);
+      try
+        {
+          unit_points[q] = this->transform_real_to_unit_cell_internal(cell, real_points[q],
+                                                                      initial_p_unit, *mdata);
+        }
+      catch (const typename Mapping<dim,spacedim>::ExcTransformationFailed &)
+        {
+          unit_points[q] = Point<dim>();
+          unit_points[q][0] = std::numeric_limits<double>::infinity();
+        }
+    }
+}
+
+
+
 template<int dim, int spacedim>
 unsigned int
 MappingQ<dim,spacedim>::get_degree() const
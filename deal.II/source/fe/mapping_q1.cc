@@ -19,6 +19,7 @@
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/qprojector.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/vectorization.h>
 #include <deal.II/lac/full_matrix.h>
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_iterator.h>
@@ -29,6 +30,7 @@
 
 #include <cmath>
 #include <algorithm>
+#include <limits>
 #include <memory>
 
 
@@ -1540,6 +1542,197 @@ namespace
 }
 
 
+namespace
+{
+  /**
+   * Evaluate the Q1 mapping given by the vertices of a cell, and its
+   * derivative, at a point given by its reference coordinates. The
+   * numbers involved are VectorizedArray objects, so this evaluates the
+   * mapping at several points at once.
+   */
+  template <int dim>
+  void
+  evaluate_q1_mapping (const std::vector<Point<dim> >                 &vertices,
+                       const Tensor<1,dim,VectorizedArray<double> >    &p_unit,
+                       Tensor<1,dim,VectorizedArray<double> >          &p_real,
+                       Tensor<2,dim,VectorizedArray<double> >          &jacobian)
+  {
+    p_real = Tensor<1,dim,VectorizedArray<double> >();
+    jacobian = Tensor<2,dim,VectorizedArray<double> >();
+
+    for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+      {
+        // the shape function of vertex v is the product of the
+        // one-dimensional functions x or 1-x in each coordinate
+        // direction, depending on the position of the vertex
+        VectorizedArray<double> factors[dim];
+        for (unsigned int d=0; d<dim; ++d)
+          factors[d] = ((v >> d) & 1) ? p_unit[d] : 1.-p_unit[d];
+
+        VectorizedArray<double> value = factors[0];
+        for (unsigned int d=1; d<dim; ++d)
+          value *= factors[d];
+
+        for (unsigned int e=0; e<dim; ++e)
+          {
+            VectorizedArray<double> derivative = make_vectorized_array (((v >> e) & 1) ? 1. : -1.);
+            for (unsigned int d=0; d<dim; ++d)
+              if (d != e)
+                derivative *= factors[d];
+
+            for (unsigned int i=0; i<dim; ++i)
+              jacobian[i][e] += derivative * vertices[v][i];
+          }
+
+        for (unsigned int i=0; i<dim; ++i)
+          p_real[i] += value * vertices[v][i];
+      }
+  }
+
+
+
+  /**
+   * Run the Newton iteration of
+   * MappingQ1::transform_real_to_unit_cell_internal() simultaneously
+   * for as many points as there are lanes in a VectorizedArray. The
+   * iteration starts from the initial guesses given in @p unit_points,
+   * and the results are written into @p unit_points for those points
+   * for which the iteration converged; for these, the corresponding
+   * entry of @p converged is set to true. Since there is no line
+   * search, the iteration is abandoned for points for which a full
+   * Newton step does not reduce the residual. This is only implemented
+   * for dim==spacedim.
+   */
+  template <int dim, int spacedim>
+  struct VectorizedNewtonIteration
+  {
+    static void
+    run (const std::vector<Point<spacedim> > &,
+         const double,
+         const std::vector<Point<spacedim> > &,
+         std::vector<Point<dim> > &,
+         std::vector<bool> &)
+    {
+      Assert (false, ExcNotImplemented());
+    }
+  };
+
+
+  template <int dim>
+  struct VectorizedNewtonIteration<dim,dim>
+  {
+    static void
+    run (const std::vector<Point<dim> > &vertices,
+         const double                    cell_diameter,
+         const std::vector<Point<dim> > &real_points,
+         std::vector<Point<dim> >       &unit_points,
+         std::vector<bool>              &converged)
+    {
+      // the same tolerances as in the scalar iteration
+      const double eps = 1.e-11;
+      const unsigned int newton_iteration_limit = 20;
+
+      const unsigned int n_lanes = VectorizedArray<double>::n_array_elements;
+      const unsigned int n_points = real_points.size();
+
+      for (unsigned int begin=0; begin<n_points; begin+=n_lanes)
+        {
+          // fill the lanes. if there are fewer points left than lanes,
+          // repeat the last point
+          unsigned int index[n_lanes];
+          bool active[n_lanes];
+          Tensor<1,dim,VectorizedArray<double> > p, p_unit;
+          for (unsigned int l=0; l<n_lanes; ++l)
+            {
+              index[l] = std::min (begin+l, n_points-1);
+              active[l] = (begin+l < n_points);
+              for (unsigned int d=0; d<dim; ++d)
+                {
+                  p[d][l] = real_points[index[l]][d];
+                  p_unit[d][l] = unit_points[index[l]][d];
+                }
+            }
+
+          Tensor<1,dim,VectorizedArray<double> > p_real;
+          Tensor<2,dim,VectorizedArray<double> > jacobian;
+          evaluate_q1_mapping (vertices, p_unit, p_real, jacobian);
+          Tensor<1,dim,VectorizedArray<double> > f = p_real - p;
+
+          // early out for points at which the initial guess is already
+          // good enough
+          unsigned int n_active = 0;
+          for (unsigned int l=0; l<n_lanes; ++l)
+            if (active[l])
+              {
+                double f_square = 0;
+                for (unsigned int d=0; d<dim; ++d)
+                  f_square += f[d][l] * f[d][l];
+                if (f_square < 1e-24 * cell_diameter * cell_diameter)
+                  {
+                    converged[index[l]] = true;
+                    active[l] = false;
+                  }
+                else
+                  ++n_active;
+              }
+
+          for (unsigned int iteration=0;
+               (iteration<newton_iteration_limit) && (n_active>0);
+               ++iteration)
+            {
+              const Tensor<2,dim,VectorizedArray<double> >
+              jacobian_inverse = invert (jacobian);
+
+              for (unsigned int i=0; i<dim; ++i)
+                for (unsigned int j=0; j<dim; ++j)
+                  p_unit[i] -= jacobian_inverse[i][j] * f[j];
+
+              evaluate_q1_mapping (vertices, p_unit, p_real, jacobian);
+              const Tensor<1,dim,VectorizedArray<double> > f_new = p_real - p;
+
+              // the residual measured in the norm induced by the
+              // transformation, see the scalar iteration
+              Tensor<1,dim,VectorizedArray<double> > f_weighted;
+              for (unsigned int i=0; i<dim; ++i)
+                for (unsigned int j=0; j<dim; ++j)
+                  f_weighted[i] += jacobian_inverse[i][j] * f_new[j];
+
+              for (unsigned int l=0; l<n_lanes; ++l)
+                if (active[l])
+                  {
+                    double f_square = 0, f_new_square = 0, f_weighted_square = 0;
+                    for (unsigned int d=0; d<dim; ++d)
+                      {
+                        f_square += f[d][l] * f[d][l];
+                        f_new_square += f_new[d][l] * f_new[d][l];
+                        f_weighted_square += f_weighted[d][l] * f_weighted[d][l];
+                      }
+
+                    // note that the comparisons are also false if the
+                    // jacobian was singular and we got NaNs
+                    if (!(f_new_square < f_square))
+                      {
+                        active[l] = false;
+                        --n_active;
+                      }
+                    else if (f_weighted_square <= eps*eps)
+                      {
+                        for (unsigned int d=0; d<dim; ++d)
+                          unit_points[index[l]][d] = p_unit[d][l];
+                        converged[index[l]] = true;
+                        active[l] = false;
+                        --n_active;
+                      }
+                  }
+
+              f = f_new;
+            }
+        }
+    }
+  };
+}
+
+
 template<int dim, int spacedim>
 Point<dim>
 MappingQ1<dim,spacedim>::
@@ -1669,6 +1862,117 @@ transform_real_to_unit_cell (const typename Triangulation<dim,spacedim>::cell_it
 
 
 
+template<int dim, int spacedim>
+void
+MappingQ1<dim,spacedim>::
+transform_points_real_to_unit_cell (const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+                                    const std::vector<Point<spacedim> >                       &real_points,
+                                    std::vector<Point<dim> >                                  &unit_points) const
+{
+  const unsigned int n_points = real_points.size();
+  unit_points.resize (n_points);
+  if (n_points == 0)
+    return;
+
+  // compute the vertices of the cell and the least squares affine
+  // approximation A x_hat + b of the cell once for all points, in the
+  // same way as transform_real_to_unit_cell_initial_guess does
+  std::vector<Point<spacedim> > vertices;
+  compute_mapping_support_points (cell, vertices);
+  Assert(vertices.size() >= GeometryInfo<dim>::vertices_per_cell,
+         ExcInternalError());
+  vertices.resize (GeometryInfo<dim>::vertices_per_cell);
+
+  FullMatrix<double> KA(GeometryInfo<dim>::vertices_per_cell, dim);
+  KA.fill( (double *)(TransformR2UInitialGuess<dim>::KA) );
+
+  FullMatrix<double> A(spacedim,dim);
+  Point<spacedim> b;
+  for (unsigned int i=0; i<spacedim; ++i)
+    for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+      {
+        for (unsigned int j=0; j<dim; ++j)
+          A(i,j) += vertices[v][i] * KA(v,j);
+        b[i] += vertices[v][i] * TransformR2UInitialGuess<dim>::Kb[v];
+      }
+
+  FullMatrix<double> A_1(dim,spacedim);
+  if (dim<spacedim)
+    A_1.left_invert(A);
+  else
+    A_1.invert(A);
+
+  for (unsigned int q=0; q<n_points; ++q)
+    {
+      const Point<spacedim> p_minus_b = real_points[q] - b;
+      for (unsigned int i=0; i<dim; ++i)
+        {
+          unit_points[q][i] = 0;
+          for (unsigned int j=0; j<spacedim; ++j)
+            unit_points[q][i] += A_1(i,j) * p_minus_b[j];
+        }
+    }
+
+  // if the affine approximation reproduces all vertices, then the cell
+  // is a parallelogram (or parallelepiped, or a line in 1d) and the
+  // initial guess is the exact answer. the tolerance is the same as the
+  // one with which transform_real_to_unit_cell_internal decides that it
+  // need not iterate
+  const double diameter = cell->diameter();
+  bool is_affine = true;
+  for (unsigned int v=0; (v<GeometryInfo<dim>::vertices_per_cell) && is_affine; ++v)
+    {
+      const Point<dim> unit_vertex = GeometryInfo<dim>::unit_cell_vertex(v);
+      Point<spacedim> difference = b - vertices[v];
+      for (unsigned int i=0; i<spacedim; ++i)
+        for (unsigned int j=0; j<dim; ++j)
+          difference[i] += A(i,j) * unit_vertex[j];
+      if (difference.square() >= 1e-24 * diameter * diameter)
+        is_affine = false;
+    }
+  if ((dim == 1) || is_affine)
+    return;
+
+  // otherwise do the Newton iteration. where possible, do so for many
+  // points at once; for the rest, and for those points for which this
+  // does not converge, use the iteration with line search
+  std::vector<bool> converged (n_points, false);
+  if (dim == spacedim)
+    VectorizedNewtonIteration<dim,spacedim>::run (vertices, diameter,
+                                                  real_points, unit_points,
+                                                  converged);
+
+  std::auto_ptr<InternalData> mdata;
+  for (unsigned int q=0; q<n_points; ++q)
+    if (converged[q] == false)
+      {
+        if (mdata.get() == 0)
+          {
+            UpdateFlags update_flags = update_transformation_values| update_transformation_gradients;
+            if (spacedim>dim)
+              update_flags |= update_jacobian_grads;
+
+            mdata.reset (dynamic_cast<InternalData *> (
+                           MappingQ1<dim,spacedim>::get_data(update_flags,
+                                                             Quadrature<dim>(unit_points[q]))));
+            mdata->mapping_support_points = vertices;
+          }
+
+        try
+          {
+            unit_points[q] = transform_real_to_unit_cell_internal(cell, real_points[q],
+                                                                  unit_points[q], *mdata);
+          }
+        catch (const typename Mapping<dim,spacedim>::ExcTransformationFailed &)
+          {
+            unit_points[q] = Point<dim>();
+            unit_points[q][0] = std::numeric_limits<double>::infinity();
+          }
+      }
+}
+
+
+
 template<int dim, int spacedim>
 Point<dim>
 MappingQ1<dim,spacedim>::
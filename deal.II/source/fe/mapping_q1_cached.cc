@@ -0,0 +1,287 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/std_cxx1x/bind.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/fe/mapping_q1_cached.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template<int dim, int spacedim>
+MappingQ1Cached<dim,spacedim>::InternalData::InternalData (const unsigned int n_shape_functions)
+  :
+  MappingQ1<dim,spacedim>::InternalData (n_shape_functions),
+  cache_index (numbers::invalid_unsigned_int)
+{}
+
+
+
+template<int dim, int spacedim>
+MappingQ1Cached<dim,spacedim>::Cache::Cache (const Quadrature<dim> &quadrature,
+                                             const UpdateFlags      update_flags)
+  :
+  quadrature (quadrature),
+  update_flags (update_flags)
+{}
+
+
+
+template<int dim, int spacedim>
+MappingQ1Cached<dim,spacedim>::MappingQ1Cached ()
+  :
+  triangulation (0)
+{}
+
+
+
+template<int dim, int spacedim>
+MappingQ1Cached<dim,spacedim>::MappingQ1Cached (const MappingQ1Cached<dim,spacedim> &mapping)
+  :
+  MappingQ1<dim,spacedim> (mapping),
+  triangulation (0)
+{}
+
+
+
+template<int dim, int spacedim>
+MappingQ1Cached<dim,spacedim>::~MappingQ1Cached ()
+{
+  tria_listener.disconnect ();
+}
+
+
+
+template<int dim, int spacedim>
+Mapping<dim,spacedim> *
+MappingQ1Cached<dim,spacedim>::clone () const
+{
+  return new MappingQ1Cached<dim,spacedim>(*this);
+}
+
+
+
+template<int dim, int spacedim>
+void
+MappingQ1Cached<dim,spacedim>::clear ()
+{
+  Threads::Mutex::ScopedLock lock (mutex);
+
+  // keep the caches themselves since InternalData objects refer to them
+  // by index, but release the memory of the data for the cells
+  for (unsigned int i=0; i<caches.size(); ++i)
+    std::vector<std::vector<CellData> >().swap (caches[i]->cells);
+}
+
+
+
+template<int dim, int spacedim>
+std::size_t
+MappingQ1Cached<dim,spacedim>::memory_consumption () const
+{
+  Threads::Mutex::ScopedLock lock (mutex);
+
+  std::size_t mem = sizeof (*this);
+  for (unsigned int i=0; i<caches.size(); ++i)
+    {
+      mem += sizeof (Cache) + caches[i]->quadrature.memory_consumption();
+      for (unsigned int level=0; level<caches[i]->cells.size(); ++level)
+        for (unsigned int index=0; index<caches[i]->cells[level].size(); ++index)
+          {
+            const CellData &cell_data = caches[i]->cells[level][index];
+            mem += (MemoryConsumption::memory_consumption (cell_data.vertices) +
+                    MemoryConsumption::memory_consumption (cell_data.quadrature_points) +
+                    MemoryConsumption::memory_consumption (cell_data.JxW_values) +
+                    MemoryConsumption::memory_consumption (cell_data.jacobians) +
+                    MemoryConsumption::memory_consumption (cell_data.jacobian_grads) +
+                    MemoryConsumption::memory_consumption (cell_data.inverse_jacobians) +
+                    MemoryConsumption::memory_consumption (cell_data.normal_vectors) +
+                    MemoryConsumption::memory_consumption (cell_data.covariant) +
+                    MemoryConsumption::memory_consumption (cell_data.contravariant) +
+                    MemoryConsumption::memory_consumption (cell_data.volume_elements));
+          }
+    }
+  return mem;
+}
+
+
+
+template<int dim, int spacedim>
+typename Mapping<dim,spacedim>::InternalDataBase *
+MappingQ1Cached<dim,spacedim>::get_data (const UpdateFlags      update_flags,
+                                         const Quadrature<dim> &quadrature) const
+{
+  InternalData *data = new InternalData(GeometryInfo<dim>::vertices_per_cell);
+  this->compute_data (update_flags, quadrature, quadrature.size(), *data);
+
+  // find the cache for this quadrature formula and these update flags,
+  // or create it
+  Threads::Mutex::ScopedLock lock (mutex);
+  for (unsigned int i=0; i<caches.size(); ++i)
+    if ((caches[i]->update_flags == data->update_each)
+        &&
+        (caches[i]->quadrature == quadrature))
+      {
+        data->cache_index = i;
+        return data;
+      }
+
+  data->cache_index = caches.size();
+  caches.push_back (std_cxx1x::shared_ptr<Cache>(new Cache (quadrature,
+                                                            data->update_each)));
+  return data;
+}
+
+
+
+template<int dim, int spacedim>
+typename MappingQ1Cached<dim,spacedim>::CellData &
+MappingQ1Cached<dim,spacedim>::
+get_cell_data (const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+               const unsigned int                                         cache_index) const
+{
+  // if this is a cell of a different triangulation than the one we
+  // stored data for, then forget about the previous triangulation
+  if (&cell->get_triangulation() != triangulation)
+    {
+      tria_listener.disconnect ();
+      for (unsigned int i=0; i<caches.size(); ++i)
+        std::vector<std::vector<CellData> >().swap (caches[i]->cells);
+
+      triangulation = &cell->get_triangulation();
+      tria_listener
+        = triangulation->signals.any_change.connect
+          (std_cxx1x::bind (&MappingQ1Cached<dim,spacedim>::clear,
+                            std_cxx1x::ref(const_cast<MappingQ1Cached<dim,spacedim>&>(*this))));
+    }
+
+  Assert (cache_index < caches.size(), ExcInternalError());
+  std::vector<std::vector<CellData> > &cells = caches[cache_index]->cells;
+  if (cells.size() <= static_cast<unsigned int>(cell->level()))
+    cells.resize (cell->level()+1);
+  if (cells[cell->level()].size() <= static_cast<unsigned int>(cell->index()))
+    cells[cell->level()].resize (triangulation->n_raw_cells(cell->level()));
+
+  return cells[cell->level()][cell->index()];
+}
+
+
+
+template<int dim, int spacedim>
+void
+MappingQ1Cached<dim,spacedim>::fill_fe_values (
+  const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+  const Quadrature<dim>                                     &q,
+  typename Mapping<dim,spacedim>::InternalDataBase          &mapping_data,
+  std::vector<Point<spacedim> >                             &quadrature_points,
+  std::vector<double>                                       &JxW_values,
+  std::vector<DerivativeForm<1,dim,spacedim> >              &jacobians,
+  std::vector<DerivativeForm<2,dim,spacedim> >              &jacobian_grads,
+  std::vector<DerivativeForm<1,spacedim,dim> >              &inverse_jacobians,
+  std::vector<Point<spacedim> >                             &normal_vectors,
+  CellSimilarity::Similarity                                &cell_similarity) const
+{
+  // ensure that the following static_cast is really correct:
+  Assert (dynamic_cast<InternalData *>(&mapping_data) != 0,
+          ExcInternalError());
+  InternalData &data = static_cast<InternalData &>(mapping_data);
+
+  const UpdateFlags update_flags(data.current_update_flags());
+
+  // see whether we have data for this cell, and whether the cell has
+  // been moved since we computed it. if the data is there, copy it
+  {
+    Threads::Mutex::ScopedLock lock (mutex);
+    const CellData &cell_data = get_cell_data (cell, data.cache_index);
+
+    bool is_valid = (cell_data.vertices.size() == GeometryInfo<dim>::vertices_per_cell);
+    for (unsigned int v=0; (v<GeometryInfo<dim>::vertices_per_cell) && is_valid; ++v)
+      if (cell_data.vertices[v] != cell->vertex(v))
+        is_valid = false;
+
+    if (is_valid)
+      {
+        if (update_flags & update_quadrature_points)
+          quadrature_points = cell_data.quadrature_points;
+        if (update_flags & (update_normal_vectors | update_JxW_values))
+          JxW_values = cell_data.JxW_values;
+        if (update_flags & update_normal_vectors)
+          normal_vectors = cell_data.normal_vectors;
+        if (update_flags & update_jacobians)
+          jacobians = cell_data.jacobians;
+        if (update_flags & update_jacobian_grads)
+          jacobian_grads = cell_data.jacobian_grads;
+        if (update_flags & update_inverse_jacobians)
+          inverse_jacobians = cell_data.inverse_jacobians;
+        if (update_flags & update_covariant_transformation)
+          data.covariant = cell_data.covariant;
+        if (update_flags & update_contravariant_transformation)
+          data.contravariant = cell_data.contravariant;
+        if (update_flags & update_volume_elements)
+          data.volume_elements = cell_data.volume_elements;
+        return;
+      }
+  }
+
+  // if not, compute the data with the function of the base class. do so
+  // without a lock, since this is the expensive part. since the data we
+  // got passed may have been overwritten from the cache, we must not let
+  // the base class make use of the similarity with the previous cell
+  CellSimilarity::Similarity no_similarity = CellSimilarity::none;
+  MappingQ1<dim,spacedim>::fill_fe_values (cell, q, mapping_data,
+                                           quadrature_points, JxW_values, jacobians,
+                                           jacobian_grads, inverse_jacobians,
+                                           normal_vectors, no_similarity);
+
+  // then store it. another thread may have done so in the meantime, in
+  // which case we simply overwrite the data with the same values
+  Threads::Mutex::ScopedLock lock (mutex);
+  CellData &cell_data = get_cell_data (cell, data.cache_index);
+
+  cell_data.vertices.resize (GeometryInfo<dim>::vertices_per_cell);
+  for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+    cell_data.vertices[v] = cell->vertex(v);
+
+  if (update_flags & update_quadrature_points)
+    cell_data.quadrature_points = quadrature_points;
+  if (update_flags & (update_normal_vectors | update_JxW_values))
+    cell_data.JxW_values = JxW_values;
+  if (update_flags & update_normal_vectors)
+    cell_data.normal_vectors = normal_vectors;
+  if (update_flags & update_jacobians)
+    cell_data.jacobians = jacobians;
+  if (update_flags & update_jacobian_grads)
+    cell_data.jacobian_grads = jacobian_grads;
+  if (update_flags & update_inverse_jacobians)
+    cell_data.inverse_jacobians = inverse_jacobians;
+  if (update_flags & update_covariant_transformation)
+    cell_data.covariant = data.covariant;
+  if (update_flags & update_contravariant_transformation)
+    cell_data.contravariant = data.contravariant;
+  if (update_flags & update_volume_elements)
+    cell_data.volume_elements = data.volume_elements;
+}
+
+
+
+// explicit instantiations
+#include "mapping_q1_cached.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
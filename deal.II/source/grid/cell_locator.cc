@@ -0,0 +1,513 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx1x/bind.h>
+#include <deal.II/grid/cell_locator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/hp/dof_handler.h>
+
+#include <algorithm>
+#include <iterator>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace
+{
+  // get the triangulation underlying a container of cells
+  template <int dim, int spacedim>
+  const Triangulation<dim,spacedim> &
+  get_tria (const Triangulation<dim,spacedim> &tria)
+  {
+    return tria;
+  }
+
+
+  template <class Container>
+  const Triangulation<Container::dimension,Container::space_dimension> &
+  get_tria (const Container &container)
+  {
+    return container.get_tria();
+  }
+
+
+  // sort the indices of cells by the centers of their bounding boxes
+  // in one coordinate direction
+  template <int spacedim>
+  class CompareBoxCenters
+  {
+  public:
+    CompareBoxCenters (const std::vector<std::pair<Point<spacedim>,Point<spacedim> > > &boxes,
+                       const unsigned int direction)
+      :
+      boxes (boxes),
+      direction (direction)
+    {}
+
+    bool operator () (const unsigned int a,
+                      const unsigned int b) const
+    {
+      return ((boxes[a].first[direction] + boxes[a].second[direction]) <
+              (boxes[b].first[direction] + boxes[b].second[direction]));
+    }
+
+  private:
+    const std::vector<std::pair<Point<spacedim>,Point<spacedim> > > &boxes;
+    const unsigned int direction;
+  };
+
+
+  // whether a point lies inside a box given by its lower and upper corner
+  template <int spacedim>
+  bool
+  box_contains (const Point<spacedim> &lower_corner,
+                const Point<spacedim> &upper_corner,
+                const Point<spacedim> &p)
+  {
+    for (unsigned int d=0; d<spacedim; ++d)
+      if ((p[d] < lower_corner[d]) || (p[d] > upper_corner[d]))
+        return false;
+    return true;
+  }
+
+
+  // the maximal number of cells stored in a leaf of the hierarchy
+  const unsigned int max_cells_per_leaf = 8;
+}
+
+
+
+template <class Container>
+const unsigned int CellLocator<Container>::dimension;
+
+template <class Container>
+const unsigned int CellLocator<Container>::space_dimension;
+
+
+
+template <class Container>
+CellLocator<Container>::
+CellLocator (const Container                            &container,
+             const Mapping<dimension,space_dimension> &mapping)
+  :
+  container (&container, typeid(*this).name()),
+  mapping (&mapping, typeid(*this).name()),
+  is_built (false)
+{
+  tria_listener
+    = get_tria(container).signals.any_change.connect
+      (std_cxx1x::bind (&CellLocator<Container>::clear, this));
+}
+
+
+
+template <class Container>
+CellLocator<Container>::
+CellLocator (const CellLocator<Container> &cell_locator)
+  :
+  Subscriptor (),
+  container (&*cell_locator.container, typeid(*this).name()),
+  mapping (&*cell_locator.mapping, typeid(*this).name()),
+  is_built (false)
+{
+  tria_listener
+    = get_tria(*container).signals.any_change.connect
+      (std_cxx1x::bind (&CellLocator<Container>::clear, this));
+}
+
+
+
+template <class Container>
+CellLocator<Container>::~CellLocator ()
+{
+  tria_listener.disconnect ();
+}
+
+
+
+template <class Container>
+const Container &
+CellLocator<Container>::get_container () const
+{
+  return *container;
+}
+
+
+
+template <class Container>
+const Mapping<CellLocator<Container>::dimension,CellLocator<Container>::space_dimension> &
+CellLocator<Container>::get_mapping () const
+{
+  return *mapping;
+}
+
+
+
+template <class Container>
+void
+CellLocator<Container>::clear ()
+{
+  Threads::Mutex::ScopedLock lock (mutex);
+
+  is_built = false;
+  std::vector<active_cell_iterator>().swap (active_cells);
+  std::vector<unsigned int>().swap (sorted_cells);
+  std::vector<std::pair<Point<space_dimension>,Point<space_dimension> > >().swap (cell_boxes);
+  std::vector<Node>().swap (nodes);
+  std::vector<std::vector<unsigned int> >().swap (vertex_to_cells);
+}
+
+
+
+template <class Container>
+void
+CellLocator<Container>::build () const
+{
+  // this function is only called with the mutex acquired
+  if (is_built)
+    return;
+
+  const Triangulation<dimension,space_dimension> &tria = get_tria(*container);
+
+  active_cells.clear ();
+  active_cells.reserve (tria.n_active_cells());
+  for (active_cell_iterator cell=container->begin_active();
+       cell!=container->end(); ++cell)
+    active_cells.push_back (cell);
+
+  // compute the bounding box of each cell from its vertices, and the
+  // cells adjacent to each vertex. enlarge the boxes by a small
+  // fraction of their size so that points on the boundary of a cell
+  // are not missed due to round-off
+  cell_boxes.resize (active_cells.size());
+  vertex_to_cells.clear ();
+  vertex_to_cells.resize (tria.n_vertices());
+  for (unsigned int c=0; c<active_cells.size(); ++c)
+    {
+      Point<space_dimension> lower_corner = active_cells[c]->vertex(0);
+      Point<space_dimension> upper_corner = active_cells[c]->vertex(0);
+      for (unsigned int v=0; v<GeometryInfo<dimension>::vertices_per_cell; ++v)
+        {
+          const Point<space_dimension> &vertex = active_cells[c]->vertex(v);
+          for (unsigned int d=0; d<space_dimension; ++d)
+            {
+              lower_corner[d] = std::min (lower_corner[d], vertex[d]);
+              upper_corner[d] = std::max (upper_corner[d], vertex[d]);
+            }
+          vertex_to_cells[active_cells[c]->vertex_index(v)].push_back (c);
+        }
+
+      const double tolerance = 1e-8 * lower_corner.distance (upper_corner);
+      for (unsigned int d=0; d<space_dimension; ++d)
+        {
+          lower_corner[d] -= tolerance;
+          upper_corner[d] += tolerance;
+        }
+      cell_boxes[c] = std::make_pair (lower_corner, upper_corner);
+    }
+
+  sorted_cells.resize (active_cells.size());
+  for (unsigned int c=0; c<active_cells.size(); ++c)
+    sorted_cells[c] = c;
+
+  nodes.clear ();
+  if (active_cells.size() > 0)
+    {
+      nodes.reserve (2*active_cells.size()/max_cells_per_leaf + 1);
+      build_node (0, active_cells.size());
+    }
+
+  is_built = true;
+}
+
+
+
+template <class Container>
+unsigned int
+CellLocator<Container>::build_node (const unsigned int begin,
+                                    const unsigned int end) const
+{
+  Node node;
+  node.lower_corner = cell_boxes[sorted_cells[begin]].first;
+  node.upper_corner = cell_boxes[sorted_cells[begin]].second;
+  for (unsigned int i=begin+1; i<end; ++i)
+    for (unsigned int d=0; d<space_dimension; ++d)
+      {
+        node.lower_corner[d] = std::min (node.lower_corner[d],
+                                         cell_boxes[sorted_cells[i]].first[d]);
+        node.upper_corner[d] = std::max (node.upper_corner[d],
+                                         cell_boxes[sorted_cells[i]].second[d]);
+      }
+  node.begin = begin;
+  node.end   = end;
+  node.children[0] = node.children[1] = numbers::invalid_unsigned_int;
+
+  const unsigned int index = nodes.size();
+  nodes.push_back (node);
+
+  if (end - begin > max_cells_per_leaf)
+    {
+      // split the cells at the median of their centers along the
+      // direction in which the box of this node is largest
+      unsigned int direction = 0;
+      for (unsigned int d=1; d<space_dimension; ++d)
+        if (node.upper_corner[d] - node.lower_corner[d] >
+            node.upper_corner[direction] - node.lower_corner[direction])
+          direction = d;
+
+      const unsigned int middle = begin + (end - begin) / 2;
+      std::nth_element (sorted_cells.begin() + begin,
+                        sorted_cells.begin() + middle,
+                        sorted_cells.begin() + end,
+                        CompareBoxCenters<space_dimension> (cell_boxes, direction));
+
+      const unsigned int left_child  = build_node (begin, middle);
+      const unsigned int right_child = build_node (middle, end);
+      nodes[index].children[0] = left_child;
+      nodes[index].children[1] = right_child;
+    }
+
+  return index;
+}
+
+
+
+template <class Container>
+void
+CellLocator<Container>::
+check_cells (const std::vector<unsigned int>                  &cell_indices,
+             const Point<space_dimension>                     &p,
+             std::pair<active_cell_iterator, Point<dimension> > &best_cell,
+             double                                           &best_distance,
+             int                                              &best_level) const
+{
+  for (unsigned int i=0; i<cell_indices.size(); ++i)
+    {
+      const active_cell_iterator &cell = active_cells[cell_indices[i]];
+      try
+        {
+          const Point<dimension> p_cell = mapping->transform_real_to_unit_cell(cell, p);
+
+          // use the same criterion as
+          // GridTools::find_active_cell_around_point: accept points
+          // that lie at most a small distance outside the unit cell,
+          // and among several cells prefer the more refined one
+          const double dist = GeometryInfo<dimension>::distance_to_unit_cell(p_cell);
+          if (dist < best_distance ||
+              (dist == best_distance && cell->level() > best_level))
+            {
+              best_distance = dist;
+              best_level    = cell->level();
+              best_cell     = std::make_pair (cell, p_cell);
+            }
+        }
+      catch (typename Mapping<dimension,space_dimension>::ExcTransformationFailed &)
+        {
+          // the point lies outside this cell, so ignore it
+        }
+    }
+}
+
+
+
+template <class Container>
+std::pair<typename CellLocator<Container>::active_cell_iterator, Point<CellLocator<Container>::dimension> >
+CellLocator<Container>::find_cell (const Point<space_dimension> &p) const
+{
+  double best_distance = 1e-10;
+  int    best_level    = -1;
+  std::pair<active_cell_iterator, Point<dimension> >
+  best_cell (container->end(), Point<dimension>());
+
+  if (nodes.size() == 0)
+    return best_cell;
+
+  // collect all cells whose bounding box contains the point
+  std::vector<unsigned int> candidates;
+  std::vector<unsigned int> nodes_to_visit (1, 0U);
+  while (nodes_to_visit.size() > 0)
+    {
+      const Node &node = nodes[nodes_to_visit.back()];
+      nodes_to_visit.pop_back ();
+
+      if (box_contains (node.lower_corner, node.upper_corner, p) == false)
+        continue;
+
+      if (node.children[0] != numbers::invalid_unsigned_int)
+        {
+          nodes_to_visit.push_back (node.children[0]);
+          nodes_to_visit.push_back (node.children[1]);
+        }
+      else
+        for (unsigned int i=node.begin; i<node.end; ++i)
+          if (box_contains (cell_boxes[sorted_cells[i]].first,
+                            cell_boxes[sorted_cells[i]].second,
+                            p))
+            candidates.push_back (sorted_cells[i]);
+    }
+
+  // look at the candidates in the order in which the container
+  // enumerates cells, as GridTools::find_active_cell_around_point does
+  std::sort (candidates.begin(), candidates.end());
+  check_cells (candidates, p, best_cell, best_distance, best_level);
+
+  // if none of the candidates contains the point, it may still lie in
+  // one of their neighbors if the mapping curves cells beyond their
+  // bounding boxes
+  if ((best_level == -1) && (candidates.size() > 0))
+    {
+      std::vector<unsigned int> neighbors;
+      for (unsigned int i=0; i<candidates.size(); ++i)
+        for (unsigned int v=0; v<GeometryInfo<dimension>::vertices_per_cell; ++v)
+          {
+            const std::vector<unsigned int> &adjacent_cells
+              = vertex_to_cells[active_cells[candidates[i]]->vertex_index(v)];
+            neighbors.insert (neighbors.end(),
+                              adjacent_cells.begin(), adjacent_cells.end());
+          }
+      std::sort (neighbors.begin(), neighbors.end());
+      neighbors.erase (std::unique (neighbors.begin(), neighbors.end()),
+                       neighbors.end());
+
+      std::vector<unsigned int> new_neighbors;
+      std::set_difference (neighbors.begin(), neighbors.end(),
+                           candidates.begin(), candidates.end(),
+                           std::back_inserter (new_neighbors));
+      check_cells (new_neighbors, p, best_cell, best_distance, best_level);
+    }
+
+  return best_cell;
+}
+
+
+
+template <class Container>
+std::pair<typename CellLocator<Container>::active_cell_iterator, Point<CellLocator<Container>::dimension> >
+CellLocator<Container>::find_active_cell_around_point (const Point<space_dimension> &p) const
+{
+  {
+    Threads::Mutex::ScopedLock lock (mutex);
+    build ();
+  }
+
+  const std::pair<active_cell_iterator, Point<dimension> >
+  cell_and_point = find_cell (p);
+  if (cell_and_point.first != container->end())
+    return cell_and_point;
+  else
+    // fall back to the exhaustive search. this throws an exception if
+    // the point can not be found
+    return GridTools::find_active_cell_around_point (*mapping, *container, p);
+}
+
+
+
+template <class Container>
+void
+CellLocator<Container>::
+find_cells (const unsigned int                                begin,
+            const unsigned int                                end,
+            const std::vector<Point<space_dimension> >       &points,
+            std::vector<std::pair<active_cell_iterator, Point<dimension> > > &cells) const
+{
+  for (unsigned int i=begin; i<end; ++i)
+    {
+      cells[i] = find_cell (points[i]);
+      if (cells[i].first == container->end())
+        try
+          {
+            cells[i] = GridTools::find_active_cell_around_point (*mapping, *container,
+                                                                 points[i]);
+          }
+        catch (GridTools::ExcPointNotFound<space_dimension> &)
+          {
+            // leave the end iterator in place
+          }
+    }
+}
+
+
+
+template <class Container>
+void
+CellLocator<Container>::
+find_active_cells_around_points (const std::vector<Point<space_dimension> > &points,
+                                 std::vector<std::pair<active_cell_iterator, Point<dimension> > > &cells) const
+{
+  {
+    Threads::Mutex::ScopedLock lock (mutex);
+    build ();
+  }
+
+  cells.resize (points.size());
+  parallel::apply_to_subranges (0U, points.size(),
+                                std_cxx1x::bind (&CellLocator<Container>::find_cells,
+                                                 this,
+                                                 std_cxx1x::_1, std_cxx1x::_2,
+                                                 std_cxx1x::cref(points),
+                                                 std_cxx1x::ref(cells)),
+                                32);
+}
+
+
+
+template <class Container>
+std::vector<typename CellLocator<Container>::active_cell_iterator>
+CellLocator<Container>::cells_adjacent_to_vertex (const unsigned int vertex) const
+{
+  {
+    Threads::Mutex::ScopedLock lock (mutex);
+    build ();
+  }
+
+  Assert (vertex < vertex_to_cells.size(),
+          ExcIndexRange (vertex, 0, vertex_to_cells.size()));
+
+  std::vector<active_cell_iterator> cells;
+  for (unsigned int i=0; i<vertex_to_cells[vertex].size(); ++i)
+    cells.push_back (active_cells[vertex_to_cells[vertex][i]]);
+  return cells;
+}
+
+
+
+template <class Container>
+std::size_t
+CellLocator<Container>::memory_consumption () const
+{
+  return (MemoryConsumption::memory_consumption (container) +
+          MemoryConsumption::memory_consumption (mapping) +
+          active_cells.capacity() * sizeof(active_cell_iterator) +
+          MemoryConsumption::memory_consumption (sorted_cells) +
+          cell_boxes.capacity() * sizeof(cell_boxes[0]) +
+          nodes.capacity() * sizeof(Node) +
+          MemoryConsumption::memory_consumption (vertex_to_cells));
+}
+
+
+// explicit instantiations
+#include "cell_locator.inst"
+
+DEAL_II_NAMESPACE_CLOSE
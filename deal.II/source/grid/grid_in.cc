@@ -18,6 +18,8 @@
 #include <deal.II/base/path_search.h>
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/std_cxx1x/bind.h>
 
 #include <deal.II/grid/grid_in.h>
 #include <deal.II/grid/tria.h>
@@ -27,8 +29,11 @@
 #include <map>
 #include <algorithm>
 #include <fstream>
+#include <sstream>
 #include <functional>
 #include <cctype>
+#include <cstdlib>
+#include <cstring>
 
 
 #ifdef DEAL_II_WITH_NETCDF
@@ -557,192 +562,747 @@ void GridIn<dim, spacedim>::read_unv(std::istream &in)
 
 
 
-template <int dim, int spacedim>
-void GridIn<dim, spacedim>::read_ucd (std::istream &in)
+namespace
 {
-  Assert (tria != 0, ExcNoTriangulationSelected());
-  AssertThrow (in, ExcIO());
-
-  // skip comments at start of file
-  skip_comment_lines (in, '#');
-
+  /**
+   * A small scanner for whitespace separated words and numbers in a
+   * zero-terminated text buffer. In contrast to reading through
+   * <tt>operator&gt;&gt;</tt> from a stream, it does not go through the
+   * locale machinery of the C++ standard library, and it converts
+   * floating point numbers with up to 15 significant digits using only
+   * a single multiplication or division, which is exact. Longer numbers
+   * are handed over to std::strtod.
+   *
+   * Rather than throwing exceptions, the scanner sets a flag if it
+   * could not read what was asked for, so that it can be used on worker
+   * threads.
+   */
+  class TextScanner
+  {
+  public:
+    TextScanner (const char *position)
+      :
+      position (position),
+      error (false)
+    {}
+
+    void skip_whitespace ()
+    {
+      while ((*position == ' ') || (*position == '\t') ||
+             (*position == '\n') || (*position == '\r'))
+        ++position;
+    }
 
-  unsigned int n_vertices;
-  unsigned int n_cells;
-  int dummy;
+    void skip_line ()
+    {
+      while ((*position != '\n') && (*position != '\0'))
+        ++position;
+    }
 
-  in >> n_vertices
-     >> n_cells
-     >> dummy         // number of data vectors
-     >> dummy         // cell data
-     >> dummy;        // model data
-  AssertThrow (in, ExcIO());
+    std::string get_word ()
+    {
+      skip_whitespace ();
+      const char *begin = position;
+      while ((*position != ' ') && (*position != '\t') &&
+             (*position != '\n') && (*position != '\r') &&
+             (*position != '\0'))
+        ++position;
+      if (position == begin)
+        error = true;
+      return std::string (begin, position);
+    }
 
-  // set up array of vertices
-  std::vector<Point<spacedim> >     vertices (n_vertices);
-  // set up mapping between numbering
-  // in ucd-file (key) and in the
-  // vertices vector
-  std::map<int,int> vertex_indices;
+    long get_integer ()
+    {
+      skip_whitespace ();
+      const char *p = position;
+      const bool negative = (*p == '-');
+      if ((*p == '-') || (*p == '+'))
+        ++p;
+      if ((*p < '0') || (*p > '9'))
+        {
+          error = true;
+          return 0;
+        }
+      long value = 0;
+      while ((*p >= '0') && (*p <= '9'))
+        value = 10*value + (*p++ - '0');
+      position = p;
+      return (negative ? -value : value);
+    }
 
-  for (unsigned int vertex=0; vertex<n_vertices; ++vertex)
+    double get_double ()
     {
-      int vertex_number;
-      double x[3];
+      static const double powers_of_ten[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                              1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                              1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                              1e18, 1e19, 1e20, 1e21, 1e22
+                                            };
+      skip_whitespace ();
+      const char *p = position;
+      const bool negative = (*p == '-');
+      if ((*p == '-') || (*p == '+'))
+        ++p;
+
+      // collect the significant digits into an integer and keep track
+      // of the decimal exponent
+      unsigned long long mantissa = 0;
+      unsigned int n_significant_digits = 0;
+      unsigned int n_digits = 0;
+      int exponent = 0;
+      for (; (*p >= '0') && (*p <= '9'); ++p, ++n_digits)
+        if ((mantissa != 0) || (*p != '0'))
+          {
+            mantissa = 10*mantissa + (*p - '0');
+            ++n_significant_digits;
+          }
+      if (*p == '.')
+        {
+          for (++p; (*p >= '0') && (*p <= '9'); ++p, ++n_digits)
+            {
+              if ((mantissa != 0) || (*p != '0'))
+                {
+                  mantissa = 10*mantissa + (*p - '0');
+                  ++n_significant_digits;
+                }
+              --exponent;
+            }
+        }
 
-      // read vertex
-      AssertThrow (in, ExcIO());
-      in >> vertex_number
-         >> x[0] >> x[1] >> x[2];
+      if ((n_digits > 0) && ((*p == 'e') || (*p == 'E')))
+        {
+          ++p;
+          const bool negative_exponent = (*p == '-');
+          if ((*p == '-') || (*p == '+'))
+            ++p;
+          int explicit_exponent = 0;
+          for (; (*p >= '0') && (*p <= '9'); ++p)
+            if (explicit_exponent < 10000)
+              explicit_exponent = 10*explicit_exponent + (*p - '0');
+          exponent += (negative_exponent ? -explicit_exponent : explicit_exponent);
+        }
 
-      // store vertex
-      for (unsigned int d=0; d<spacedim; ++d)
-        vertices[vertex](d) = x[d];
-      // store mapping; note that
-      // vertices_indices[i] is automatically
-      // created upon first usage
-      vertex_indices[vertex_number] = vertex;
-    };
+      // if both the mantissa and the power of ten are exactly
+      // representable as doubles, then the result of one
+      // multiplication or division is the correctly rounded value.
+      // leave everything else to the C library
+      if ((n_digits > 0) &&
+          (n_significant_digits <= 15) &&
+          (exponent >= -22) && (exponent <= 22))
+        {
+          double value = static_cast<double>(mantissa);
+          if (exponent < 0)
+            value /= powers_of_ten[-exponent];
+          else
+            value *= powers_of_ten[exponent];
+          position = p;
+          return (negative ? -value : value);
+        }
+      else
+        {
+          char *end;
+          const double value = std::strtod (position, &end);
+          if (end == position)
+            error = true;
+          position = end;
+          return value;
+        }
+    }
 
-  // set up array of cells
-  std::vector<CellData<dim> > cells;
-  SubCellData                 subcelldata;
+    const char *position;
+    bool        error;
+  };
+
+
+
+  /**
+   * Starting at the beginning of the line following @p begin, assume
+   * that each of the next @p n_records lines contains exactly one
+   * record and store the positions at which the records with numbers 0,
+   * @p records_per_chunk, 2*@p records_per_chunk, ... start. Return
+   * the end of the last of these lines, or zero if the text does not
+   * have this structure because it has empty lines or too few lines.
+   */
+  const char *
+  find_chunk_starts (const char               *begin,
+                     const unsigned int        n_records,
+                     const unsigned int        records_per_chunk,
+                     std::vector<const char *> &chunk_starts)
+  {
+    chunk_starts.clear ();
+
+    const char *line = std::strchr (begin, '\n');
+    if (line == 0)
+      return 0;
+    ++line;
+
+    for (unsigned int record=0; record<n_records; ++record)
+      {
+        if (record % records_per_chunk == 0)
+          chunk_starts.push_back (line);
+
+        bool empty = true;
+        const char *p = line;
+        for (; (*p != '\n') && (*p != '\0'); ++p)
+          if ((*p != ' ') && (*p != '\t') && (*p != '\r'))
+            empty = false;
+        if (empty)
+          return 0;
+
+        line = (*p == '\n' ? p+1 : p);
+      }
+    return line;
+  }
 
-  for (unsigned int cell=0; cell<n_cells; ++cell)
-    {
-      // note that since in the input
-      // file we found the number of
-      // cells at the top, there
-      // should still be input here,
-      // so check this:
-      AssertThrow (in, ExcIO());
 
-      std::string cell_type;
 
-      // we use an unsigned int because we
-      // fill this variable through an read-in process
-      unsigned int material_id;
+  /**
+   * Number of nodes of the Gmsh element types we may encounter in a
+   * mesh file, or zero for all others.
+   */
+  unsigned int
+  gmsh_nodes_per_element (const int element_type)
+  {
+    switch (element_type)
+      {
+      case 1:
+        return 2;   // line
+      case 2:
+        return 3;   // triangle
+      case 3:
+        return 4;   // quadrilateral
+      case 4:
+        return 4;   // tetrahedron
+      case 5:
+        return 8;   // hexahedron
+      case 15:
+        return 1;   // point
+      default:
+        return 0;
+      }
+  }
+
+
+
+  /**
+   * The information GridIn::read_msh and GridIn::read_ucd extract from
+   * one element of the input file. The element type uses the Gmsh
+   * numbering also for UCD files, i.e. 1 for lines, 3 for
+   * quadrilaterals and 5 for hexahedra; @p position points to the
+   * element type in the text so that it can be shown in error
+   * messages.
+   */
+  struct ElementRecord
+  {
+    int          type;
+    unsigned int material_id;
+    unsigned int n_nodes;
+    int          nodes[8];
+    const char  *position;
+  };
+
+
+
+  /**
+   * Read the vertex numbers and coordinates of @p vertices.size()
+   * vertices, each given as a number followed by three coordinates.
+   * The text is split into chunks starting at the positions given in
+   * @p chunk_starts; this function reads the chunks in the half-open
+   * range [begin_chunk,end_chunk) and can thus be run on several
+   * threads for disjoint ranges of chunks. For each chunk, the position
+   * after its last record is stored in @p chunk_ends, or zero if the
+   * text could not be read.
+   */
+  template <int spacedim>
+  void
+  read_vertex_chunks (const unsigned int               begin_chunk,
+                      const unsigned int               end_chunk,
+                      const std::vector<const char *> &chunk_starts,
+                      const unsigned int               records_per_chunk,
+                      std::vector<const char *>       &chunk_ends,
+                      std::vector<Point<spacedim> >   &vertices,
+                      std::vector<int>                &vertex_numbers)
+  {
+    for (unsigned int chunk=begin_chunk; chunk<end_chunk; ++chunk)
+      {
+        TextScanner scanner (chunk_starts[chunk]);
+        const unsigned int end = std::min<std::size_t> (vertices.size(),
+                                                        (chunk+1)*records_per_chunk);
+        for (unsigned int v=chunk*records_per_chunk; v<end; ++v)
+          {
+            vertex_numbers[v] = scanner.get_integer ();
+            for (unsigned int d=0; d<3; ++d)
+              {
+                const double x = scanner.get_double ();
+                if (d < spacedim)
+                  vertices[v][d] = x;
+              }
+          }
+        chunk_ends[chunk] = (scanner.error ? 0 : scanner.position);
+      }
+  }
+
+
+
+  /**
+   * Like read_vertex_chunks(), but for the elements of a Gmsh file in
+   * either version 1 or version 2 of the format.
+   */
+  void
+  read_msh_element_chunks (const unsigned int               begin_chunk,
+                           const unsigned int               end_chunk,
+                           const std::vector<const char *> &chunk_starts,
+                           const unsigned int               records_per_chunk,
+                           std::vector<const char *>       &chunk_ends,
+                           const unsigned int               gmsh_file_format,
+                           std::vector<ElementRecord>      &elements)
+  {
+    for (unsigned int chunk=begin_chunk; chunk<end_chunk; ++chunk)
+      {
+        TextScanner scanner (chunk_starts[chunk]);
+        const unsigned int end = std::min<std::size_t> (elements.size(),
+                                                        (chunk+1)*records_per_chunk);
+        for (unsigned int e=chunk*records_per_chunk; e<end; ++e)
+          {
+            /*
+              For file format version 1, the format of each cell is as follows:
+                elm-number elm-type reg-phys reg-elem number-of-nodes node-number-list
+
+              However, for version 2, the format reads like this:
+                elm-number elm-type number-of-tags < tag > ... node-number-list
+
+              In the following, we will ignore the element number (we simply enumerate
+              them in the order in which we read them, and we will take reg-phys
+              (version 1) or the first tag (version 2, if any tag is given at all) as
+              material id.
+            */
+            ElementRecord &element = elements[e];
+            scanner.get_integer ();                     // ELM-NUMBER
+            element.position = scanner.position;
+            element.type     = scanner.get_integer ();  // ELM-TYPE
+
+            if (gmsh_file_format == 1)
+              {
+                element.material_id = scanner.get_integer ();   // REG-PHYS
+                scanner.get_integer ();                         // REG-ELM
+                element.n_nodes     = scanner.get_integer ();
+              }
+            else
+              {
+                // read the tags; ignore all but the first one
+                const unsigned int n_tags = scanner.get_integer ();
+                element.material_id = (n_tags > 0 ? scanner.get_integer () : 0);
+                for (unsigned int i=1; i<n_tags; ++i)
+                  scanner.get_integer ();
+                element.n_nodes = gmsh_nodes_per_element (element.type);
+
+                // we don't know how many nodes elements of other types
+                // have. skip the rest of the line; elements of such
+                // types are rejected later anyway
+                if (element.n_nodes == 0)
+                  {
+                    scanner.skip_line ();
+                    continue;
+                  }
+              }
+
+            for (unsigned int i=0; i<element.n_nodes; ++i)
+              {
+                const int node = scanner.get_integer ();
+                if (i < 8)
+                  element.nodes[i] = node;
+              }
+          }
+        chunk_ends[chunk] = (scanner.error ? 0 : scanner.position);
+      }
+  }
+
+
+
+  /**
+   * Like read_vertex_chunks(), but for the cells of a UCD file.
+   */
+  void
+  read_ucd_element_chunks (const unsigned int               begin_chunk,
+                           const unsigned int               end_chunk,
+                           const std::vector<const char *> &chunk_starts,
+                           const unsigned int               records_per_chunk,
+                           std::vector<const char *>       &chunk_ends,
+                           std::vector<ElementRecord>      &elements)
+  {
+    for (unsigned int chunk=begin_chunk; chunk<end_chunk; ++chunk)
+      {
+        TextScanner scanner (chunk_starts[chunk]);
+        const unsigned int end = std::min<std::size_t> (elements.size(),
+                                                        (chunk+1)*records_per_chunk);
+        for (unsigned int e=chunk*records_per_chunk; e<end; ++e)
+          {
+            ElementRecord &element = elements[e];
+            scanner.get_integer ();   // cell number
+            element.material_id = scanner.get_integer ();
+            scanner.skip_whitespace ();
+            element.position = scanner.position;
+
+            const std::string cell_type = scanner.get_word ();
+            if (cell_type == "line")
+              element.type = 1;
+            else if (cell_type == "quad")
+              element.type = 3;
+            else if (cell_type == "hex")
+              element.type = 5;
+            else
+              {
+                // unknown cell types are rejected later
+                element.type = 0;
+                scanner.skip_line ();
+                continue;
+              }
+
+            element.n_nodes = gmsh_nodes_per_element (element.type);
+            for (unsigned int i=0; i<element.n_nodes; ++i)
+              element.nodes[i] = scanner.get_integer ();
+          }
+        chunk_ends[chunk] = (scanner.error ? 0 : scanner.position);
+      }
+  }
+
+
+
+  /**
+   * Read @p n_records records from the text starting at @p begin with
+   * the given function, which takes the same first five arguments as
+   * read_vertex_chunks(). If the text has one record per line, split
+   * it into chunks and read them in parallel; otherwise, or if it turns
+   * out that the chunks did not end where the next one begins, read
+   * everything in one piece on the current thread. Return the position
+   * after the last record.
+   */
+  template <typename ChunkReader>
+  const char *
+  read_records (const char        *begin,
+                const unsigned int n_records,
+                const ChunkReader &read_chunks)
+  {
+    const unsigned int records_per_chunk = 4096;
+
+    std::vector<const char *> chunk_starts;
+    if ((n_records > 0) &&
+        (find_chunk_starts (begin, n_records, records_per_chunk, chunk_starts) != 0))
+      {
+        std::vector<const char *> chunk_ends (chunk_starts.size());
+        parallel::apply_to_subranges (0U, chunk_starts.size(),
+                                      std_cxx1x::bind (read_chunks,
+                                                       std_cxx1x::_1,
+                                                       std_cxx1x::_2,
+                                                       std_cxx1x::cref(chunk_starts),
+                                                       records_per_chunk,
+                                                       std_cxx1x::ref(chunk_ends)),
+                                      1);
+
+        // each chunk needs to have ended on the line before the next
+        // one starts. if that is not so, the records were not one per
+        // line after all
+        bool consistent = true;
+        for (unsigned int chunk=0; chunk<chunk_ends.size(); ++chunk)
+          if (chunk_ends[chunk] == 0)
+            consistent = false;
+          else
+            {
+              TextScanner end_of_chunk (chunk_ends[chunk]);
+              end_of_chunk.skip_whitespace ();
+              if (chunk+1 < chunk_starts.size())
+                {
+                  TextScanner next_chunk (chunk_starts[chunk+1]);
+                  next_chunk.skip_whitespace ();
+                  if (end_of_chunk.position != next_chunk.position)
+                    consistent = false;
+                }
+            }
 
-      in >> dummy          // cell number
-         >> material_id;
-      in >> cell_type;
+        if (consistent)
+          return chunk_ends.back();
+      }
 
-      if (((cell_type == "line") && (dim == 1)) ||
-          ((cell_type == "quad") && (dim == 2)) ||
-          ((cell_type == "hex" ) && (dim == 3)))
-        // found a cell
+    // read the records in one piece
+    chunk_starts.assign (1, begin);
+    std::vector<const char *> chunk_ends (1);
+    read_chunks (0, 1, chunk_starts, std::max (n_records, 1U), chunk_ends);
+    AssertThrow (chunk_ends[0] != 0, ExcIO());
+    return chunk_ends[0];
+  }
+
+
+
+  /**
+   * A map from the vertex numbers used in an input file to the
+   * consecutive numbering of vertices we use internally. Most mesh
+   * generators number vertices consecutively or nearly so, in which
+   * case we store the map in an array; otherwise we fall back to a
+   * std::map.
+   */
+  class VertexNumbering
+  {
+  public:
+    VertexNumbering (const std::vector<int> &vertex_numbers)
+    {
+      if (vertex_numbers.size() > 0)
         {
-          // allocate and read indices
-          cells.push_back (CellData<dim>());
-          for (unsigned int i=0; i<GeometryInfo<dim>::vertices_per_cell; ++i)
-            in >> cells.back().vertices[i];
-
-          // to make sure that the cast wont fail
-          Assert(material_id<= std::numeric_limits<types::material_id>::max(),
-                 ExcIndexRange(material_id,0,std::numeric_limits<types::material_id>::max()));
-          // we use only material_ids in the range from 0 to numbers::invalid_material_id-1
-          Assert(material_id < numbers::invalid_material_id,
-                 ExcIndexRange(material_id,0,numbers::invalid_material_id));
-
-          cells.back().material_id = static_cast<types::material_id>(material_id);
-
-          // transform from ucd to
-          // consecutive numbering
-          for (unsigned int i=0; i<GeometryInfo<dim>::vertices_per_cell; ++i)
-            if (vertex_indices.find (cells.back().vertices[i]) != vertex_indices.end())
-              // vertex with this index exists
-              cells.back().vertices[i] = vertex_indices[cells.back().vertices[i]];
-            else
-              {
-                // no such vertex index
-                AssertThrow (false, ExcInvalidVertexIndex(cell, cells.back().vertices[i]));
-                cells.back().vertices[i] = numbers::invalid_unsigned_int;
-              };
+          const int min_number = *std::min_element (vertex_numbers.begin(),
+                                                     vertex_numbers.end());
+          const int max_number = *std::max_element (vertex_numbers.begin(),
+                                                     vertex_numbers.end());
+          if ((min_number >= 0) &&
+              (static_cast<std::size_t>(max_number) < 2*vertex_numbers.size()+1000))
+            {
+              dense_indices.resize (max_number+1, numbers::invalid_unsigned_int);
+              for (unsigned int v=0; v<vertex_numbers.size(); ++v)
+                dense_indices[vertex_numbers[v]] = v;
+              return;
+            }
         }
-      else if ((cell_type == "line") && ((dim == 2) || (dim == 3)))
-        // boundary info
+
+      for (unsigned int v=0; v<vertex_numbers.size(); ++v)
+        sparse_indices[vertex_numbers[v]] = v;
+    }
+
+    /**
+     * Return the internal index of the vertex with the given number in
+     * the input file, or numbers::invalid_unsigned_int if there is no
+     * such vertex.
+     */
+    unsigned int index (const int number) const
+    {
+      if (dense_indices.size() > 0)
+        return ((number >= 0) &&
+                (static_cast<std::size_t>(number) < dense_indices.size()) ?
+                dense_indices[number] :
+                numbers::invalid_unsigned_int);
+      else
         {
-          subcelldata.boundary_lines.push_back (CellData<1>());
-          in >> subcelldata.boundary_lines.back().vertices[0]
-             >> subcelldata.boundary_lines.back().vertices[1];
-
-          // to make sure that the cast wont fail
-          Assert(material_id<= std::numeric_limits<types::boundary_id>::max(),
-                 ExcIndexRange(material_id,0,std::numeric_limits<types::boundary_id>::max()));
-          // we use only boundary_ids in the range from 0 to numbers::internal_face_boundary_id-1
-          Assert(material_id < numbers::internal_face_boundary_id,
-                 ExcIndexRange(material_id,0,numbers::internal_face_boundary_id));
-
-          subcelldata.boundary_lines.back().boundary_id
-            = static_cast<types::boundary_id>(material_id);
-
-          // transform from ucd to
-          // consecutive numbering
-          for (unsigned int i=0; i<2; ++i)
-            if (vertex_indices.find (subcelldata.boundary_lines.back().vertices[i]) !=
-                vertex_indices.end())
-              // vertex with this index exists
-              subcelldata.boundary_lines.back().vertices[i]
-                = vertex_indices[subcelldata.boundary_lines.back().vertices[i]];
-            else
+          const std::map<int,unsigned int>::const_iterator
+          p = sparse_indices.find (number);
+          return (p != sparse_indices.end() ? p->second : numbers::invalid_unsigned_int);
+        }
+    }
+
+  private:
+    std::vector<unsigned int>   dense_indices;
+    std::map<int,unsigned int>  sparse_indices;
+  };
+
+
+
+  /**
+   * Copy @p n values of type T from their binary representation
+   * starting at @p position into @p values, and return the position
+   * after them. @p end is the end of the buffer.
+   */
+  template <typename T>
+  const char *
+  get_binary_values (const char        *position,
+                     const char        *end,
+                     T                 *values,
+                     const unsigned int n)
+  {
+    AssertThrow (static_cast<std::size_t>(end - position) >= n*sizeof(T),
+                 ExcIO());
+    std::memcpy (values, position, n*sizeof(T));
+    return position + n*sizeof(T);
+  }
+
+
+
+  /**
+   * Read everything that is left in the given stream into a string.
+   */
+  std::string
+  read_remaining_stream (std::istream &in)
+  {
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    return buffer.str();
+  }
+
+
+
+  /**
+   * Turn the elements read from a Gmsh or UCD file into cells and
+   * boundary information, using @p vertex_numbering to translate from
+   * the vertex numbers in the file to the indices into the array of
+   * vertices.
+   */
+  template <int dim, int spacedim>
+  void
+  create_cell_data (const std::vector<ElementRecord> &elements,
+                    const VertexNumbering            &vertex_numbering,
+                    const bool                        gmsh_format,
+                    std::vector<CellData<dim> >      &cells,
+                    SubCellData                      &subcelldata)
+  {
+    typedef GridIn<dim,spacedim> GridInType;
+
+    for (unsigned int cell=0; cell<elements.size(); ++cell)
+      {
+        const ElementRecord &element     = elements[cell];
+        const unsigned int   material_id = element.material_id;
+
+        if (((element.type == 1) && (dim == 1)) ||
+            ((element.type == 3) && (dim == 2)) ||
+            ((element.type == 5) && (dim == 3)))
+          // found a cell
+          {
+            AssertThrow (element.n_nodes == GeometryInfo<dim>::vertices_per_cell,
+                         ExcMessage ("Number of nodes does not coincide with the "
+                                     "number required for this object"));
+
+            cells.push_back (CellData<dim>());
+
+            // to make sure that the cast wont fail
+            Assert(material_id<= std::numeric_limits<types::material_id>::max(),
+                   ExcIndexRange(material_id,0,std::numeric_limits<types::material_id>::max()));
+            // we use only material_ids in the range from 0 to numbers::invalid_material_id-1
+            Assert(material_id < numbers::invalid_material_id,
+                   ExcIndexRange(material_id,0,numbers::invalid_material_id));
+
+            cells.back().material_id = static_cast<types::material_id>(material_id);
+
+            // transform from the numbering in the file to consecutive
+            // numbering
+            for (unsigned int i=0; i<GeometryInfo<dim>::vertices_per_cell; ++i)
+              {
+                cells.back().vertices[i] = vertex_numbering.index (element.nodes[i]);
+                AssertThrow (cells.back().vertices[i] != numbers::invalid_unsigned_int,
+                             typename GridInType::ExcInvalidVertexIndex(cell, element.nodes[i]));
+              }
+          }
+        else if ((element.type == 1) && ((dim == 2) || (dim == 3)))
+          // boundary info
+          {
+            subcelldata.boundary_lines.push_back (CellData<1>());
+
+            // to make sure that the cast wont fail
+            Assert(material_id<= std::numeric_limits<types::boundary_id>::max(),
+                   ExcIndexRange(material_id,0,std::numeric_limits<types::boundary_id>::max()));
+            // we use only boundary_ids in the range from 0 to numbers::internal_face_boundary_id-1
+            Assert(material_id < numbers::internal_face_boundary_id,
+                   ExcIndexRange(material_id,0,numbers::internal_face_boundary_id));
+
+            subcelldata.boundary_lines.back().boundary_id
+              = static_cast<types::boundary_id>(material_id);
+
+            for (unsigned int i=0; i<2; ++i)
               {
-                // no such vertex index
-                AssertThrow (false,
-                             ExcInvalidVertexIndex(cell,
-                                                   subcelldata.boundary_lines.back().vertices[i]));
                 subcelldata.boundary_lines.back().vertices[i]
-                  = numbers::invalid_unsigned_int;
-              };
-        }
-      else if ((cell_type == "quad") && (dim == 3))
-        // boundary info
-        {
-          subcelldata.boundary_quads.push_back (CellData<2>());
-          in >> subcelldata.boundary_quads.back().vertices[0]
-             >> subcelldata.boundary_quads.back().vertices[1]
-             >> subcelldata.boundary_quads.back().vertices[2]
-             >> subcelldata.boundary_quads.back().vertices[3];
-
-          // to make sure that the cast wont fail
-          Assert(material_id<= std::numeric_limits<types::boundary_id>::max(),
-                 ExcIndexRange(material_id,0,std::numeric_limits<types::boundary_id>::max()));
-          // we use only boundary_ids in the range from 0 to numbers::internal_face_boundary_id-1
-          Assert(material_id < numbers::internal_face_boundary_id,
-                 ExcIndexRange(material_id,0,numbers::internal_face_boundary_id));
-
-          subcelldata.boundary_quads.back().boundary_id
-            = static_cast<types::boundary_id>(material_id);
-
-          // transform from ucd to
-          // consecutive numbering
-          for (unsigned int i=0; i<4; ++i)
-            if (vertex_indices.find (subcelldata.boundary_quads.back().vertices[i]) !=
-                vertex_indices.end())
-              // vertex with this index exists
-              subcelldata.boundary_quads.back().vertices[i]
-                = vertex_indices[subcelldata.boundary_quads.back().vertices[i]];
-            else
+                  = vertex_numbering.index (element.nodes[i]);
+                AssertThrow (subcelldata.boundary_lines.back().vertices[i] !=
+                             numbers::invalid_unsigned_int,
+                             typename GridInType::ExcInvalidVertexIndex(cell, element.nodes[i]));
+              }
+          }
+        else if ((element.type == 3) && (dim == 3))
+          // boundary info
+          {
+            subcelldata.boundary_quads.push_back (CellData<2>());
+
+            // to make sure that the cast wont fail
+            Assert(material_id<= std::numeric_limits<types::boundary_id>::max(),
+                   ExcIndexRange(material_id,0,std::numeric_limits<types::boundary_id>::max()));
+            // we use only boundary_ids in the range from 0 to numbers::internal_face_boundary_id-1
+            Assert(material_id < numbers::internal_face_boundary_id,
+                   ExcIndexRange(material_id,0,numbers::internal_face_boundary_id));
+
+            subcelldata.boundary_quads.back().boundary_id
+              = static_cast<types::boundary_id>(material_id);
+
+            for (unsigned int i=0; i<4; ++i)
               {
-                // no such vertex index
-                Assert (false,
-                        ExcInvalidVertexIndex(cell,
-                                              subcelldata.boundary_quads.back().vertices[i]));
-                subcelldata.boundary_quads.back().vertices[i] =
-                  numbers::invalid_unsigned_int;
-              };
+                subcelldata.boundary_quads.back().vertices[i]
+                  = vertex_numbering.index (element.nodes[i]);
+                AssertThrow (subcelldata.boundary_quads.back().vertices[i] !=
+                             numbers::invalid_unsigned_int,
+                             typename GridInType::ExcInvalidVertexIndex(cell, element.nodes[i]));
+              }
+          }
+        else if (gmsh_format && (element.type == 15))
+          // ignore vertices
+          ;
+        else if (gmsh_format)
+          // cannot read this, so throw an exception. treat triangles
+          // and tetrahedra specially since this deserves a more
+          // explicit error message
+          {
+            AssertThrow (element.type != 2,
+                         ExcMessage("Found triangles while reading a file "
+                                    "in gmsh format. deal.II does not "
+                                    "support triangles"));
+            AssertThrow (element.type != 11,
+                         ExcMessage("Found tetrahedra while reading a file "
+                                    "in gmsh format. deal.II does not "
+                                    "support tetrahedra"));
+
+            AssertThrow (false,
+                         typename GridInType::ExcGmshUnsupportedGeometry(element.type));
+          }
+        else
+          // cannot read this
+          AssertThrow (false,
+                       typename GridInType::ExcUnknownIdentifier(TextScanner(element.position).get_word()));
+      }
+  }
+}
 
-        }
-      else
-        // cannot read this
-        AssertThrow (false, ExcUnknownIdentifier(cell_type));
-    };
 
 
+template <int dim, int spacedim>
+void GridIn<dim, spacedim>::read_ucd (std::istream &in)
+{
+  Assert (tria != 0, ExcNoTriangulationSelected());
+  AssertThrow (in, ExcIO());
+
+  // skip comments at start of file
+  skip_comment_lines (in, '#');
+
+  // read the rest of the file into memory and parse it from there
+  const std::string text = read_remaining_stream (in);
+  TextScanner       scanner (text.c_str());
+
+  const unsigned int n_vertices = scanner.get_integer ();
+  const unsigned int n_cells    = scanner.get_integer ();
+  scanner.get_integer ();   // number of data vectors
+  scanner.get_integer ();   // cell data
+  scanner.get_integer ();   // model data
+  AssertThrow (scanner.error == false, ExcIO());
+
+  // set up array of vertices, along with the numbers they have in the
+  // ucd-file
+  std::vector<Point<spacedim> > vertices (n_vertices);
+  std::vector<int>              vertex_numbers (n_vertices);
+  scanner.position
+    = read_records (scanner.position, n_vertices,
+                    std_cxx1x::bind (&read_vertex_chunks<spacedim>,
+                                     std_cxx1x::_1, std_cxx1x::_2,
+                                     std_cxx1x::_3, std_cxx1x::_4,
+                                     std_cxx1x::_5,
+                                     std_cxx1x::ref(vertices),
+                                     std_cxx1x::ref(vertex_numbers)));
+
+  // then read the cells and boundary information
+  std::vector<ElementRecord> elements (n_cells);
+  read_records (scanner.position, n_cells,
+                std_cxx1x::bind (&read_ucd_element_chunks,
+                                 std_cxx1x::_1, std_cxx1x::_2,
+                                 std_cxx1x::_3, std_cxx1x::_4,
+                                 std_cxx1x::_5,
+                                 std_cxx1x::ref(elements)));
+
+  std::vector<CellData<dim> > cells;
+  SubCellData                 subcelldata;
+  create_cell_data<dim,spacedim> (elements, VertexNumbering (vertex_numbers),
+                                  false, cells, subcelldata);
+
   // check that no forbidden arrays are used
   Assert (subcelldata.check_consistency(dim), ExcInternalError());
 
-  AssertThrow (in, ExcIO());
-
   // do some clean-up on vertices...
   GridTools::delete_unused_vertices (vertices, cells, subcelldata);
   // ... and cells
@@ -1085,15 +1645,16 @@ void GridIn<dim, spacedim>::read_msh (std::istream &in)
   Assert (tria != 0, ExcNoTriangulationSelected());
   AssertThrow (in, ExcIO());
 
-  unsigned int n_vertices;
-  unsigned int n_cells;
-  unsigned int dummy;
-  std::string line;
+  // read the whole file into memory and parse it from there
+  const std::string  text = read_remaining_stream (in);
+  const char *const  end_of_text = text.c_str() + text.size();
+  TextScanner        scanner (text.c_str());
 
-  in >> line;
+  std::string line = scanner.get_word ();
 
   // first determine file format
   unsigned int gmsh_file_format = 0;
+  bool         binary = false;
   if (line == "$NOD")
     gmsh_file_format = 1;
   else if (line == "$MeshFormat")
@@ -1106,36 +1667,49 @@ void GridIn<dim, spacedim>::read_msh (std::istream &in)
   // rest of the header
   if (gmsh_file_format == 2)
     {
-      double version;
-      unsigned int file_type, data_size;
-
-      in >> version >> file_type >> data_size;
+      const double       version   = scanner.get_double ();
+      const unsigned int file_type = scanner.get_integer ();
+      const unsigned int data_size = scanner.get_integer ();
 
       Assert ( (version >= 2.0) &&
                (version <= 2.2), ExcNotImplemented());
-      Assert (file_type == 0, ExcNotImplemented());
+      Assert ((file_type == 0) || (file_type == 1), ExcNotImplemented());
       Assert (data_size == sizeof(double), ExcNotImplemented());
 
+      // binary files have the integer 1 written in binary on the
+      // following line, from which one can infer the byte order
+      binary = (file_type == 1);
+      if (binary)
+        {
+          int one = 0;
+          scanner.skip_line ();
+          scanner.position = get_binary_values (scanner.position+1, end_of_text,
+                                                &one, 1);
+          AssertThrow (one == 1,
+                       ExcMessage ("This binary Gmsh file has been written on a machine "
+                                   "with a different byte order."));
+        }
+
       // read the end of the header
       // and the first line of the
       // nodes description to synch
       // ourselves with the format 1
       // handling above
-      in >> line;
+      line = scanner.get_word ();
       AssertThrow (line == "$EndMeshFormat",
                    ExcInvalidGMSHInput(line));
 
-      in >> line;
+      line = scanner.get_word ();
       // if the next block is of kind
       // $PhysicalNames, ignore it
       if (line == "$PhysicalNames")
         {
           do
             {
-              in >> line;
+              line = scanner.get_word ();
             }
-          while (line != "$EndPhysicalNames");
-          in >> line;
+          while ((line != "$EndPhysicalNames") && (scanner.error == false));
+          line = scanner.get_word ();
         }
 
       // but the next thing should,
@@ -1145,286 +1719,116 @@ void GridIn<dim, spacedim>::read_msh (std::istream &in)
                    ExcInvalidGMSHInput(line));
     }
 
-  // now read the nodes list
-  in >> n_vertices;
-  std::vector<Point<spacedim> >     vertices (n_vertices);
-  // set up mapping between numbering
-  // in msh-file (nod) and in the
-  // vertices vector
-  std::map<int,int> vertex_indices;
+  // now read the nodes list, along with the numbers the nodes have in
+  // the msh-file
+  const unsigned int n_vertices = scanner.get_integer ();
+  AssertThrow (scanner.error == false, ExcIO());
+  std::vector<Point<spacedim> > vertices (n_vertices);
+  std::vector<int>              vertex_numbers (n_vertices);
 
-  for (unsigned int vertex=0; vertex<n_vertices; ++vertex)
+  if (binary)
     {
-      int vertex_number;
-      double x[3];
-
-      // read vertex
-      in >> vertex_number
-         >> x[0] >> x[1] >> x[2];
-
-      for (unsigned int d=0; d<spacedim; ++d)
-        vertices[vertex](d) = x[d];
-      // store mapping
-      vertex_indices[vertex_number] = vertex;
+      scanner.skip_line ();
+      ++scanner.position;
+      for (unsigned int vertex=0; vertex<n_vertices; ++vertex)
+        {
+          double x[3];
+          scanner.position = get_binary_values (scanner.position, end_of_text,
+                                                &vertex_numbers[vertex], 1);
+          scanner.position = get_binary_values (scanner.position, end_of_text,
+                                                &x[0], 3);
+          for (unsigned int d=0; d<spacedim; ++d)
+            vertices[vertex](d) = x[d];
+        }
     }
+  else
+    scanner.position
+      = read_records (scanner.position, n_vertices,
+                      std_cxx1x::bind (&read_vertex_chunks<spacedim>,
+                                       std_cxx1x::_1, std_cxx1x::_2,
+                                       std_cxx1x::_3, std_cxx1x::_4,
+                                       std_cxx1x::_5,
+                                       std_cxx1x::ref(vertices),
+                                       std_cxx1x::ref(vertex_numbers)));
 
   // Assert we reached the end of the block
-  in >> line;
+  line = scanner.get_word ();
   static const std::string end_nodes_marker[] = {"$ENDNOD", "$EndNodes" };
   AssertThrow (line==end_nodes_marker[gmsh_file_format-1],
                ExcInvalidGMSHInput(line));
 
   // Now read in next bit
-  in >> line;
+  line = scanner.get_word ();
   static const std::string begin_elements_marker[] = {"$ELM", "$Elements" };
   AssertThrow (line==begin_elements_marker[gmsh_file_format-1],
                ExcInvalidGMSHInput(line));
 
-  in >> n_cells;
+  const unsigned int n_cells = scanner.get_integer ();
+  AssertThrow (scanner.error == false, ExcIO());
+  std::vector<ElementRecord> elements (n_cells);
 
-  // set up array of cells
-  std::vector<CellData<dim> > cells;
-  SubCellData                 subcelldata;
-
-  for (unsigned int cell=0; cell<n_cells; ++cell)
+  if (binary)
     {
-      // note that since in the input
-      // file we found the number of
-      // cells at the top, there
-      // should still be input here,
-      // so check this:
-      AssertThrow (in, ExcIO());
-
-      unsigned int cell_type;
-      unsigned int material_id;
-      unsigned int nod_num;
-
-      /*
-        For file format version 1, the format of each cell is as follows:
-          elm-number elm-type reg-phys reg-elem number-of-nodes node-number-list
-
-        However, for version 2, the format reads like this:
-          elm-number elm-type number-of-tags < tag > ... node-number-list
-
-        In the following, we will ignore the element number (we simply enumerate
-        them in the order in which we read them, and we will take reg-phys
-        (version 1) or the first tag (version 2, if any tag is given at all) as
-        material id.
-      */
-
-      in >> dummy          // ELM-NUMBER
-         >> cell_type;     // ELM-TYPE
-
-      switch (gmsh_file_format)
-        {
-        case 1:
-        {
-          in >> material_id  // REG-PHYS
-             >> dummy        // reg_elm
-             >> nod_num;
-          break;
-        }
-
-        case 2:
+      // in binary files, elements come in blocks of elements of the
+      // same type and with the same number of tags, each block
+      // preceded by a header containing the element type, the number
+      // of elements and the number of tags
+      scanner.skip_line ();
+      ++scanner.position;
+      for (unsigned int cell=0; cell<n_cells; )
         {
-          // read the tags; ignore
-          // all but the first one
-          unsigned int n_tags;
-          in >> n_tags;
-          if (n_tags > 0)
-            in >> material_id;
-          else
-            material_id = 0;
-
-          for (unsigned int i=1; i<n_tags; ++i)
-            in >> dummy;
-
-          nod_num = GeometryInfo<dim>::vertices_per_cell;
-
-          break;
-        }
-
-        default:
-          AssertThrow (false, ExcNotImplemented());
-        }
-
-
-      /*       `ELM-TYPE'
-               defines the geometrical type of the N-th element:
-               `1'
-               Line (2 nodes, 1 edge).
-
-               `3'
-               Quadrangle (4 nodes, 4 edges).
-
-               `5'
-               Hexahedron (8 nodes, 12 edges, 6 faces).
-
-               `15'
-               Point (1 node).
-      */
-
-      if (((cell_type == 1) && (dim == 1)) ||
-          ((cell_type == 3) && (dim == 2)) ||
-          ((cell_type == 5) && (dim == 3)))
-        // found a cell
-        {
-          AssertThrow (nod_num == GeometryInfo<dim>::vertices_per_cell,
-                       ExcMessage ("Number of nodes does not coincide with the "
-                                   "number required for this object"));
-
-          // allocate and read indices
-          cells.push_back (CellData<dim>());
-          for (unsigned int i=0; i<GeometryInfo<dim>::vertices_per_cell; ++i)
-            in >> cells.back().vertices[i];
-
-          // to make sure that the cast wont fail
-          Assert(material_id<= std::numeric_limits<types::material_id>::max(),
-                 ExcIndexRange(material_id,0,std::numeric_limits<types::material_id>::max()));
-          // we use only material_ids in the range from 0 to numbers::invalid_material_id-1
-          Assert(material_id < numbers::invalid_material_id,
-                 ExcIndexRange(material_id,0,numbers::invalid_material_id));
-
-          cells.back().material_id = static_cast<types::material_id>(material_id);
-
-          // transform from ucd to
-          // consecutive numbering
-          for (unsigned int i=0; i<GeometryInfo<dim>::vertices_per_cell; ++i)
+          int header[3];
+          scanner.position = get_binary_values (scanner.position, end_of_text,
+                                                &header[0], 3);
+          const int          cell_type  = header[0];
+          const unsigned int n_elements = header[1];
+          const unsigned int n_tags     = header[2];
+          const unsigned int n_nodes    = gmsh_nodes_per_element (cell_type);
+          AssertThrow (n_nodes != 0, ExcGmshUnsupportedGeometry(cell_type));
+          AssertThrow (cell + n_elements <= n_cells,
+                       ExcMessage ("The number of elements in the element blocks "
+                                   "of this binary Gmsh file exceeds the number "
+                                   "of elements given before."));
+
+          std::vector<int> data (1 + n_tags + n_nodes);
+          for (unsigned int e=0; e<n_elements; ++e, ++cell)
             {
-              AssertThrow (vertex_indices.find (cells.back().vertices[i]) !=
-                           vertex_indices.end(),
-                           ExcInvalidVertexIndex(cell, cells.back().vertices[i]));
-
-              // vertex with this index exists
-              cells.back().vertices[i] = vertex_indices[cells.back().vertices[i]];
+              scanner.position = get_binary_values (scanner.position, end_of_text,
+                                                    &data[0], data.size());
+              elements[cell].type        = cell_type;
+              elements[cell].material_id = (n_tags > 0 ? data[1] : 0);
+              elements[cell].n_nodes     = n_nodes;
+              elements[cell].position    = 0;
+              for (unsigned int i=0; i<n_nodes; ++i)
+                elements[cell].nodes[i] = data[1+n_tags+i];
             }
         }
-      else if ((cell_type == 1) && ((dim == 2) || (dim == 3)))
-        // boundary info
-        {
-          subcelldata.boundary_lines.push_back (CellData<1>());
-          in >> subcelldata.boundary_lines.back().vertices[0]
-             >> subcelldata.boundary_lines.back().vertices[1];
-
-          // to make sure that the cast wont fail
-          Assert(material_id<= std::numeric_limits<types::boundary_id>::max(),
-                 ExcIndexRange(material_id,0,std::numeric_limits<types::boundary_id>::max()));
-          // we use only boundary_ids in the range from 0 to numbers::internal_face_boundary_id-1
-          Assert(material_id < numbers::internal_face_boundary_id,
-                 ExcIndexRange(material_id,0,numbers::internal_face_boundary_id));
-
-          subcelldata.boundary_lines.back().boundary_id
-            = static_cast<types::boundary_id>(material_id);
-
-          // transform from ucd to
-          // consecutive numbering
-          for (unsigned int i=0; i<2; ++i)
-            if (vertex_indices.find (subcelldata.boundary_lines.back().vertices[i]) !=
-                vertex_indices.end())
-              // vertex with this index exists
-              subcelldata.boundary_lines.back().vertices[i]
-                = vertex_indices[subcelldata.boundary_lines.back().vertices[i]];
-            else
-              {
-                // no such vertex index
-                AssertThrow (false,
-                             ExcInvalidVertexIndex(cell,
-                                                   subcelldata.boundary_lines.back().vertices[i]));
-                subcelldata.boundary_lines.back().vertices[i] =
-                  numbers::invalid_unsigned_int;
-              };
-        }
-      else if ((cell_type == 3) && (dim == 3))
-        // boundary info
-        {
-          subcelldata.boundary_quads.push_back (CellData<2>());
-          in >> subcelldata.boundary_quads.back().vertices[0]
-             >> subcelldata.boundary_quads.back().vertices[1]
-             >> subcelldata.boundary_quads.back().vertices[2]
-             >> subcelldata.boundary_quads.back().vertices[3];
-
-          // to make sure that the cast wont fail
-          Assert(material_id<= std::numeric_limits<types::boundary_id>::max(),
-                 ExcIndexRange(material_id,0,std::numeric_limits<types::boundary_id>::max()));
-          // we use only boundary_ids in the range from 0 to numbers::internal_face_boundary_id-1
-          Assert(material_id < numbers::internal_face_boundary_id,
-                 ExcIndexRange(material_id,0,numbers::internal_face_boundary_id));
-
-          subcelldata.boundary_quads.back().boundary_id
-            = static_cast<types::boundary_id>(material_id);
-
-          // transform from gmsh to
-          // consecutive numbering
-          for (unsigned int i=0; i<4; ++i)
-            if (vertex_indices.find (subcelldata.boundary_quads.back().vertices[i]) !=
-                vertex_indices.end())
-              // vertex with this index exists
-              subcelldata.boundary_quads.back().vertices[i]
-                = vertex_indices[subcelldata.boundary_quads.back().vertices[i]];
-            else
-              {
-                // no such vertex index
-                Assert (false,
-                        ExcInvalidVertexIndex(cell,
-                                              subcelldata.boundary_quads.back().vertices[i]));
-                subcelldata.boundary_quads.back().vertices[i] =
-                  numbers::invalid_unsigned_int;
-              };
-
-        }
-      else if (cell_type == 15)
-        {
-          // Ignore vertices
-          // but read the
-          // number of nodes
-          // given
-          switch (gmsh_file_format)
-            {
-            case 1:
-            {
-              for (unsigned int i=0; i<nod_num; ++i)
-                in >> dummy;
-              break;
-            }
-            case 2:
-            {
-              in >> dummy;
-              break;
-            }
-            }
-        }
-      else
-        // cannot read this, so throw
-        // an exception. treat
-        // triangles and tetrahedra
-        // specially since this
-        // deserves a more explicit
-        // error message
-        {
-          AssertThrow (cell_type != 2,
-                       ExcMessage("Found triangles while reading a file "
-                                  "in gmsh format. deal.II does not "
-                                  "support triangles"));
-          AssertThrow (cell_type != 11,
-                       ExcMessage("Found tetrahedra while reading a file "
-                                  "in gmsh format. deal.II does not "
-                                  "support tetrahedra"));
-
-          AssertThrow (false, ExcGmshUnsupportedGeometry(cell_type));
-        }
-    };
+    }
+  else
+    scanner.position
+      = read_records (scanner.position, n_cells,
+                      std_cxx1x::bind (&read_msh_element_chunks,
+                                       std_cxx1x::_1, std_cxx1x::_2,
+                                       std_cxx1x::_3, std_cxx1x::_4,
+                                       std_cxx1x::_5,
+                                       gmsh_file_format,
+                                       std_cxx1x::ref(elements)));
 
   // Assert we reached the end of the block
-  in >> line;
+  line = scanner.get_word ();
   static const std::string end_elements_marker[] = {"$ENDELM", "$EndElements" };
   AssertThrow (line==end_elements_marker[gmsh_file_format-1],
                ExcInvalidGMSHInput(line));
 
+  // set up array of cells
+  std::vector<CellData<dim> > cells;
+  SubCellData                 subcelldata;
+  create_cell_data<dim,spacedim> (elements, VertexNumbering (vertex_numbers),
+                                  true, cells, subcelldata);
+
   // check that no forbidden arrays are used
   Assert (subcelldata.check_consistency(dim), ExcInternalError());
 
-  AssertThrow (in, ExcIO());
-
   // check that we actually read some
   // cells.
   AssertThrow(cells.size() > 0, ExcGmshNoCellInformation());
@@ -2378,6 +2782,273 @@ void GridIn<dim, spacedim>::read_tecplot(std::istream &)
 }
 
 
+namespace
+{
+  /**
+   * Read an array that has been written by GridOut::write_binary(),
+   * i.e. its size followed by its elements as raw bytes.
+   */
+  template <typename T>
+  void
+  read_binary_block (std::istream   &in,
+                     std::vector<T> &data)
+  {
+    unsigned long long size = 0;
+    in.read (reinterpret_cast<char *>(&size), sizeof(size));
+    AssertThrow (in, ExcIO());
+
+    data.resize (size);
+    if (size > 0)
+      in.read (reinterpret_cast<char *>(&data[0]), size * sizeof(T));
+    AssertThrow (in, ExcIO());
+  }
+
+
+
+  /**
+   * Step over the entries of @p refinement_cases that describe the cell
+   * at the given position and all of its descendants, and return the
+   * number of levels this subtree has.
+   */
+  template <int dim>
+  unsigned int
+  skip_cells_depth_first (const std::vector<unsigned char> &refinement_cases,
+                          unsigned int                     &position)
+  {
+    AssertThrow (position < refinement_cases.size(),
+                 ExcMessage ("The refinement information in the input "
+                             "is incomplete."));
+    const RefinementCase<dim> ref_case (refinement_cases[position]);
+    ++position;
+
+    unsigned int n_levels = 0;
+    for (unsigned int c=0; c<GeometryInfo<dim>::n_children(ref_case); ++c)
+      n_levels = std::max (n_levels,
+                           skip_cells_depth_first<dim> (refinement_cases, position));
+    return n_levels + 1;
+  }
+
+
+
+  /**
+   * Walk over @p cell and all of its descendants in depth-first order
+   * and set the refinement flag on those active cells that have been
+   * refined in the triangulation described by @p refinement_cases.
+   */
+  template <int dim, int spacedim>
+  void
+  flag_cells_depth_first (const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+                          const std::vector<unsigned char>                          &refinement_cases,
+                          unsigned int                                              &position)
+  {
+    const RefinementCase<dim> ref_case (refinement_cases[position]);
+
+    if (cell->has_children())
+      {
+        ++position;
+        for (unsigned int c=0; c<cell->n_children(); ++c)
+          flag_cells_depth_first<dim,spacedim> (cell->child(c),
+                                                refinement_cases, position);
+      }
+    else
+      {
+        if (ref_case != RefinementCase<dim>::no_refinement)
+          cell->set_refine_flag (ref_case);
+        skip_cells_depth_first<dim> (refinement_cases, position);
+      }
+  }
+
+
+
+  /**
+   * Same as the function in grid_out.cc: append the (level,index)
+   * pairs of @p cell and all of its descendants to @p cells, in
+   * depth-first order.
+   */
+  template <int dim, int spacedim>
+  void
+  collect_cells_depth_first (const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+                             std::vector<std::pair<unsigned int,unsigned int> >        &cells)
+  {
+    cells.push_back (std::make_pair (static_cast<unsigned int>(cell->level()),
+                                     static_cast<unsigned int>(cell->index())));
+    if (cell->has_children())
+      for (unsigned int c=0; c<cell->n_children(); ++c)
+        collect_cells_depth_first<dim,spacedim> (cell->child(c), cells);
+  }
+}
+
+
+
+template <int dim, int spacedim>
+void GridIn<dim, spacedim>::read_binary (std::istream &in)
+{
+  Assert (tria != 0, ExcNoTriangulationSelected());
+  AssertThrow (in, ExcIO());
+
+  typedef typename Triangulation<dim,spacedim>::cell_iterator cell_iterator;
+
+  // (i) check the header. it needs to match the one written in
+  // GridOut::write_binary
+  std::string header;
+  std::getline (in, header);
+  {
+    std::istringstream header_stream (header);
+    std::string  name[3];
+    unsigned int version = 0, file_dim = 0, file_spacedim = 0;
+    header_stream >> name[0] >> name[1] >> name[2]
+                  >> version >> file_dim >> file_spacedim;
+    AssertThrow (header_stream &&
+                 (name[0] == "deal.II") &&
+                 (name[1] == "binary") &&
+                 (name[2] == "mesh"),
+                 ExcInvalidBinaryMeshInput ("unknown header <" + header + ">"));
+    AssertThrow (version == 1,
+                 ExcInvalidBinaryMeshInput ("unsupported format version " +
+                                            Utilities::int_to_string (version)));
+    AssertThrow ((file_dim == dim) && (file_spacedim == spacedim),
+                 ExcInvalidBinaryMeshInput ("the file contains a mesh of dimensions <" +
+                                            Utilities::int_to_string (file_dim) + "," +
+                                            Utilities::int_to_string (file_spacedim) +
+                                            ">, which does not match the triangulation"));
+  }
+
+  unsigned int byte_order_marker = 0;
+  unsigned int sizes[3] = { 0, 0, 0 };
+  in.read (reinterpret_cast<char *>(&byte_order_marker), sizeof(byte_order_marker));
+  in.read (reinterpret_cast<char *>(&sizes[0]), sizeof(sizes));
+  AssertThrow (in, ExcIO());
+  AssertThrow ((byte_order_marker == 0x01020304) &&
+               (sizes[0] == sizeof(double)) &&
+               (sizes[1] == sizeof(types::material_id)) &&
+               (sizes[2] == sizeof(types::boundary_id)),
+               ExcInvalidBinaryMeshInput ("the file was written on a machine with "
+                                          "a different binary representation of numbers"));
+
+  // (ii) read the coarse mesh and create it. it has been written by
+  // the Triangulation class in the first place, so there is no need to
+  // check for unused vertices or reorder cells
+  std::vector<double> coordinates;
+  read_binary_block (in, coordinates);
+  AssertThrow (coordinates.size() % spacedim == 0,
+               ExcInvalidBinaryMeshInput ("invalid number of vertex coordinates"));
+  std::vector<Point<spacedim> > vertices (coordinates.size() / spacedim);
+  for (unsigned int v=0; v<vertices.size(); ++v)
+    for (unsigned int d=0; d<spacedim; ++d)
+      vertices[v][d] = coordinates[v*spacedim+d];
+
+  std::vector<unsigned int> cell_vertices;
+  read_binary_block (in, cell_vertices);
+  AssertThrow (cell_vertices.size() % GeometryInfo<dim>::vertices_per_cell == 0,
+               ExcInvalidBinaryMeshInput ("invalid number of cell vertex indices"));
+  std::vector<CellData<dim> > cells (cell_vertices.size() /
+                                     GeometryInfo<dim>::vertices_per_cell);
+  for (unsigned int c=0, i=0; c<cells.size(); ++c)
+    for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v, ++i)
+      {
+        AssertThrow (cell_vertices[i] < vertices.size(),
+                     ExcInvalidVertexIndex (c, cell_vertices[i]));
+        cells[c].vertices[v] = cell_vertices[i];
+      }
+
+  tria->create_triangulation (vertices, cells, SubCellData());
+
+  // (iii) re-create the refinement hierarchy. we do this level by
+  // level: in each sweep, walk over the cells we already have and flag
+  // all those active cells that have children in the file
+  std::vector<unsigned char> refinement_cases;
+  read_binary_block (in, refinement_cases);
+
+  unsigned int n_levels = 0;
+  unsigned int position = 0;
+  for (unsigned int c=0; c<cells.size(); ++c)
+    n_levels = std::max (n_levels,
+                         skip_cells_depth_first<dim> (refinement_cases, position));
+  AssertThrow (position == refinement_cases.size(),
+               ExcInvalidBinaryMeshInput ("invalid number of refinement cases"));
+
+  for (unsigned int level=1; level<n_levels; ++level)
+    {
+      position = 0;
+      for (cell_iterator cell=tria->begin(0); cell!=tria->end(0); ++cell)
+        flag_cells_depth_first<dim,spacedim> (cell, refinement_cases, position);
+      tria->execute_coarsening_and_refinement ();
+    }
+
+  // (iv) with all cells in place, enumerate them in the same order as
+  // the writer did, and verify that we did indeed get the same
+  // hierarchy
+  std::vector<std::pair<unsigned int,unsigned int> > all_cells;
+  all_cells.reserve (refinement_cases.size());
+  for (cell_iterator cell=tria->begin(0); cell!=tria->end(0); ++cell)
+    collect_cells_depth_first<dim,spacedim> (cell, all_cells);
+  AssertThrow (all_cells.size() == refinement_cases.size(),
+               ExcInvalidBinaryMeshInput ("re-creating the refinement hierarchy "
+                                          "did not lead to the original mesh. Is the "
+                                          "mesh smoothing of the triangulation "
+                                          "different from the one used originally?"));
+
+  std::vector<types::material_id> material_ids;
+  std::vector<types::boundary_id> boundary_ids;
+  read_binary_block (in, material_ids);
+  read_binary_block (in, boundary_ids);
+  AssertThrow (material_ids.size() == all_cells.size(),
+               ExcInvalidBinaryMeshInput ("invalid number of material ids"));
+
+  unsigned int boundary_position = 0;
+  for (unsigned int i=0; i<all_cells.size(); ++i)
+    {
+      const cell_iterator cell (&*tria, all_cells[i].first, all_cells[i].second);
+      AssertThrow (static_cast<unsigned char>(cell->refinement_case()) ==
+                   refinement_cases[i],
+                   ExcInvalidBinaryMeshInput ("re-creating the refinement hierarchy "
+                                              "did not lead to the original mesh. Is the "
+                                              "mesh smoothing of the triangulation "
+                                              "different from the one used originally?"));
+      cell->set_material_id (material_ids[i]);
+
+      for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell->at_boundary(f))
+          {
+            AssertThrow (boundary_position < boundary_ids.size(),
+                         ExcInvalidBinaryMeshInput ("too few boundary indicators"));
+            cell->face(f)->set_boundary_indicator (boundary_ids[boundary_position++]);
+          }
+      if (dim == 3)
+        for (unsigned int l=0; l<GeometryInfo<dim>::lines_per_cell; ++l)
+          if (cell->line(l)->at_boundary())
+            {
+              AssertThrow (boundary_position < boundary_ids.size(),
+                           ExcInvalidBinaryMeshInput ("too few boundary indicators"));
+              cell->line(l)->set_boundary_indicator (boundary_ids[boundary_position++]);
+            }
+    }
+  AssertThrow (boundary_position == boundary_ids.size(),
+               ExcInvalidBinaryMeshInput ("too many boundary indicators"));
+
+  // (v) finally move all vertices to the locations stored in the file,
+  // visiting them in the same order as the writer did
+  read_binary_block (in, coordinates);
+  AssertThrow (coordinates.size() == tria->n_used_vertices() * spacedim,
+               ExcInvalidBinaryMeshInput ("invalid number of vertex coordinates"));
+
+  std::vector<bool> vertex_visited (tria->n_vertices(), false);
+  unsigned int      vertex_position = 0;
+  for (unsigned int i=0; i<all_cells.size(); ++i)
+    {
+      const cell_iterator cell (&*tria, all_cells[i].first, all_cells[i].second);
+      if (cell->has_children() == false)
+        for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+          if (vertex_visited[cell->vertex_index(v)] == false)
+            {
+              vertex_visited[cell->vertex_index(v)] = true;
+              for (unsigned int d=0; d<spacedim; ++d)
+                cell->vertex(v)[d] = coordinates[vertex_position++];
+            }
+    }
+}
+
+
 template <int dim, int spacedim>
 void GridIn<dim, spacedim>::skip_empty_lines (std::istream &in)
 {
@@ -2597,8 +3268,6 @@ void GridIn<dim, spacedim>::read (const std::string &filename,
   else
     name = search.find(filename, default_suffix(format));
 
-  std::ifstream in(name.c_str());
-
   if (format == Default)
     {
       const std::string::size_type slashpos = name.find_last_of('/');
@@ -2610,6 +3279,15 @@ void GridIn<dim, spacedim>::read (const std::string &filename,
           format = parse_format(ext);
         }
     }
+
+  // Gmsh files may be binary as well. the parser for the ASCII
+  // variant of that format treats carriage returns as whitespace, so
+  // we can open them in binary mode in either case
+  std::ifstream in(name.c_str(),
+                   ((format == binary) || (format == msh) ?
+                    std::ios::in | std::ios::binary :
+                    std::ios::in));
+
   if (format == netcdf)
     read_netcdf(filename);
   else
@@ -2660,6 +3338,10 @@ void GridIn<dim, spacedim>::read (std::istream &in,
       read_tecplot (in);
       return;
 
+    case binary:
+      read_binary (in);
+      return;
+
     case Default:
       break;
     }
@@ -2690,6 +3372,8 @@ GridIn<dim, spacedim>::default_suffix (const Format format)
       return ".nc";
     case tecplot:
       return ".dat";
+    case binary:
+      return ".bin";
     default:
       Assert (false, ExcNotImplemented());
       return ".unknown_format";
@@ -2735,6 +3419,12 @@ GridIn<dim, spacedim>::parse_format (const std::string &format_name)
   if (format_name == "dat")
     return tecplot;
 
+  if (format_name == "binary")
+    return binary;
+
+  if (format_name == "bin")
+    return binary;
+
   if (format_name == "plt")
     // Actually, this is the extension for the
     // tecplot binary format, which we do not
@@ -2757,7 +3447,7 @@ GridIn<dim, spacedim>::parse_format (const std::string &format_name)
 template <int dim, int spacedim>
 std::string GridIn<dim, spacedim>::get_format_names ()
 {
-  return "dbmesh|msh|unv|vtk|ucd|xda|netcdf|tecplot";
+  return "dbmesh|msh|unv|vtk|ucd|xda|netcdf|tecplot|binary";
 }
 
 
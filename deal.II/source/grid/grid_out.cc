@@ -491,6 +491,8 @@ GridOut::default_suffix (const OutputFormat output_format)
       return ".svg";
     case mathgl:
       return ".mathgl";
+    case binary:
+      return ".bin";
     default:
       Assert (false, ExcNotImplemented());
       return "";
@@ -537,6 +539,9 @@ GridOut::parse_output_format (const std::string &format_name)
   if (format_name == "mathgl")
     return mathgl;
 
+  if (format_name == "binary")
+    return binary;
+
   AssertThrow (false, ExcInvalidState ());
   // return something weird
   return OutputFormat(-1);
@@ -546,7 +551,7 @@ GridOut::parse_output_format (const std::string &format_name)
 
 std::string GridOut::get_output_format_names ()
 {
-  return "none|dx|gnuplot|eps|ucd|xfig|msh|svg|mathgl";
+  return "none|dx|gnuplot|eps|ucd|xfig|msh|svg|mathgl|binary";
 }
 
 
@@ -2367,6 +2372,145 @@ void GridOut::write_mathgl (const Triangulation<dim> &tria,
 }
 
 
+namespace
+{
+  /**
+   * Append the (level,index) pairs of @p cell and all of its
+   * descendants to @p cells, in depth-first order. This is the order
+   * in which write_binary() stores all per-cell information.
+   */
+  template <int dim, int spacedim>
+  void
+  collect_cells_depth_first (const typename Triangulation<dim,spacedim>::cell_iterator &cell,
+                             std::vector<std::pair<unsigned int,unsigned int> >        &cells)
+  {
+    cells.push_back (std::make_pair (static_cast<unsigned int>(cell->level()),
+                                     static_cast<unsigned int>(cell->index())));
+    if (cell->has_children())
+      for (unsigned int c=0; c<cell->n_children(); ++c)
+        collect_cells_depth_first<dim,spacedim> (cell->child(c), cells);
+  }
+
+
+
+  /**
+   * Write the size of the given array, followed by its elements as raw
+   * bytes.
+   */
+  template <typename T>
+  void
+  write_binary_block (const std::vector<T> &data,
+                      std::ostream         &out)
+  {
+    const unsigned long long size = data.size();
+    out.write (reinterpret_cast<const char *>(&size), sizeof(size));
+    if (size > 0)
+      out.write (reinterpret_cast<const char *>(&data[0]), size * sizeof(T));
+  }
+}
+
+
+
+template <int dim, int spacedim>
+void GridOut::write_binary (const Triangulation<dim,spacedim> &tria,
+                            std::ostream                      &out) const
+{
+  AssertThrow (out, ExcIO());
+
+  typedef typename Triangulation<dim,spacedim>::cell_iterator cell_iterator;
+
+  // (i) write a text header that identifies the format and the
+  // dimensions, followed by a marker with which the reader can check
+  // that it uses the same binary representation of numbers
+  out << "deal.II binary mesh 1 " << dim << ' ' << spacedim << '\n';
+  const unsigned int byte_order_marker = 0x01020304;
+  const unsigned int sizes[3] = { sizeof(double),
+                                  sizeof(types::material_id),
+                                  sizeof(types::boundary_id)
+                                };
+  out.write (reinterpret_cast<const char *>(&byte_order_marker),
+             sizeof(byte_order_marker));
+  out.write (reinterpret_cast<const char *>(&sizes[0]), sizeof(sizes));
+
+  // (ii) write the coarse mesh. only write those vertices that are
+  // actually used by coarse cells, and renumber them consecutively
+  std::vector<unsigned int> coarse_vertex_numbers (tria.n_vertices(),
+                                                   numbers::invalid_unsigned_int);
+  std::vector<double>       coarse_vertices;
+  std::vector<unsigned int> coarse_cells;
+  coarse_cells.reserve (tria.n_cells(0) * GeometryInfo<dim>::vertices_per_cell);
+  for (cell_iterator cell=tria.begin(0); cell!=tria.end(0); ++cell)
+    for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+      {
+        const unsigned int vertex = cell->vertex_index(v);
+        if (coarse_vertex_numbers[vertex] == numbers::invalid_unsigned_int)
+          {
+            coarse_vertex_numbers[vertex] = coarse_vertices.size() / spacedim;
+            for (unsigned int d=0; d<spacedim; ++d)
+              coarse_vertices.push_back (cell->vertex(v)[d]);
+          }
+        coarse_cells.push_back (coarse_vertex_numbers[vertex]);
+      }
+  write_binary_block (coarse_vertices, out);
+  write_binary_block (coarse_cells, out);
+
+  // (iii) build the depth-first list of cells and write refinement
+  // cases and material ids in this order
+  std::vector<std::pair<unsigned int,unsigned int> > cells;
+  cells.reserve (tria.n_cells());
+  for (cell_iterator cell=tria.begin(0); cell!=tria.end(0); ++cell)
+    collect_cells_depth_first<dim,spacedim> (cell, cells);
+
+  std::vector<unsigned char>      refinement_cases (cells.size());
+  std::vector<types::material_id> material_ids (cells.size());
+  std::vector<types::boundary_id> boundary_ids;
+  for (unsigned int i=0; i<cells.size(); ++i)
+    {
+      const cell_iterator cell (&tria, cells[i].first, cells[i].second);
+      refinement_cases[i] = static_cast<unsigned char>(cell->refinement_case());
+      material_ids[i]     = cell->material_id();
+
+      // (iv) collect the boundary indicators of all boundary faces
+      // and, in 3d, of their lines. the reader finds out which faces
+      // are at the boundary the same way, so we don't need to write
+      // which ones they are
+      for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+        if (cell->at_boundary(f))
+          boundary_ids.push_back (cell->face(f)->boundary_indicator());
+      if (dim == 3)
+        for (unsigned int l=0; l<GeometryInfo<dim>::lines_per_cell; ++l)
+          if (cell->line(l)->at_boundary())
+            boundary_ids.push_back (cell->line(l)->boundary_indicator());
+    }
+  write_binary_block (refinement_cases, out);
+  write_binary_block (material_ids, out);
+  write_binary_block (boundary_ids, out);
+
+  // (v) finally write the location of all vertices, in the order in
+  // which they are first touched when walking over the active cells
+  std::vector<bool>   vertex_visited (tria.n_vertices(), false);
+  std::vector<double> vertices;
+  vertices.reserve (tria.n_used_vertices() * spacedim);
+  for (unsigned int i=0; i<cells.size(); ++i)
+    {
+      const cell_iterator cell (&tria, cells[i].first, cells[i].second);
+      if (cell->has_children() == false)
+        for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+          if (vertex_visited[cell->vertex_index(v)] == false)
+            {
+              vertex_visited[cell->vertex_index(v)] = true;
+              for (unsigned int d=0; d<spacedim; ++d)
+                vertices.push_back (cell->vertex(v)[d]);
+            }
+    }
+  write_binary_block (vertices, out);
+
+  // make sure everything now gets to the output stream
+  out.flush ();
+  AssertThrow (out, ExcIO ());
+}
+
+
 unsigned int GridOut::n_boundary_faces (const Triangulation<1> &) const
 {
   return 0;
@@ -3736,6 +3880,10 @@ void GridOut::write (const Triangulation<dim, spacedim> &tria,
     case mathgl:
       write_mathgl (tria, out);
       return;
+
+    case binary:
+      write_binary (tria, out);
+      return;
     }
 
   Assert (false, ExcInternalError());
@@ -914,13 +914,13 @@ next_cell:
     std::set<cell_iterator> adjacent_cells(adjacent_cells_tmp.begin(), adjacent_cells_tmp.end());
     std::set<cell_iterator> searched_cells;
 
-    // Determine the maximal number of cells
+    // Determine the maximal number of active cells
     // in the grid.
     // As long as we have not found
     // the cell and have not searched
     // every cell in the triangulation,
     // we keep on looking.
-    const unsigned int n_cells =get_tria(container).n_cells();
+    const unsigned int n_cells =get_tria(container).n_active_cells();
     bool found = false;
     unsigned int cells_searched = 0;
     while (!found && cells_searched < n_cells)
@@ -1037,13 +1037,13 @@ next_cell:
         std::set<cell_iterator> adjacent_cells(adjacent_cells_tmp.begin(), adjacent_cells_tmp.end());
         std::set<cell_iterator> searched_cells;
 
-        // Determine the maximal number of cells
+        // Determine the maximal number of active cells
         // in the grid.
         // As long as we have not found
         // the cell and have not searched
         // every cell in the triangulation,
         // we keep on looking.
-        const unsigned int n_cells =get_tria(container).n_cells();
+        const unsigned int n_cells =get_tria(container).n_active_cells();
         bool found = false;
         unsigned int cells_searched = 0;
         while (!found && cells_searched < n_cells)
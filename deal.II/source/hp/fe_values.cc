@@ -14,6 +14,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/thread_management.h>
 #include <deal.II/hp/fe_values.h>
 #include <deal.II/fe/mapping_q1.h>
 
@@ -104,6 +105,57 @@ namespace internal
       // now there definitely is one!
       return *fe_values_table(present_fe_values_index);
     }
+
+
+
+    namespace
+    {
+      /**
+       * Create one of the FEValues objects in the table of an
+       * FEValuesBase object. Used as a task by precalculate_fe_values().
+       */
+      template <class FEValues, int dim, int q_dim>
+      void
+      create_fe_values (std_cxx1x::shared_ptr<FEValues>                      &fe_values,
+                        const Mapping<dim,FEValues::space_dimension>         &mapping,
+                        const FiniteElement<dim,FEValues::space_dimension>   &fe,
+                        const Quadrature<q_dim>                              &quadrature,
+                        const UpdateFlags                                     update_flags)
+      {
+        fe_values.reset (new FEValues (mapping, fe, quadrature, update_flags));
+      }
+    }
+
+
+
+    template <int dim, int q_dim, class FEValues>
+    void
+    FEValuesBase<dim,q_dim,FEValues>::precalculate_fe_values ()
+    {
+      Threads::TaskGroup<> tasks;
+      for (unsigned int fe_index=0; fe_index<fe_collection->size(); ++fe_index)
+        {
+          const unsigned int mapping_index
+            = (mapping_collection->size() > 1 ? fe_index : 0);
+          const unsigned int q_index
+            = (q_collection.size() > 1 ? fe_index : 0);
+          if ((mapping_index >= mapping_collection->size())
+              ||
+              (q_index >= q_collection.size()))
+            continue;
+
+          std_cxx1x::shared_ptr<FEValues> &fe_values
+            = fe_values_table(TableIndices<3>(fe_index, mapping_index, q_index));
+          if (fe_values.get() == 0)
+            tasks += Threads::new_task (&create_fe_values<FEValues,dim,q_dim>,
+                                        fe_values,
+                                        (*mapping_collection)[mapping_index],
+                                        (*fe_collection)[fe_index],
+                                        q_collection[q_index],
+                                        update_flags);
+        }
+      tasks.join_all ();
+    }
   }
 }
 
@@ -65,10 +65,22 @@ void
 DataOut<dim,DH>::
 build_one_patch (const std::pair<cell_iterator, unsigned int> *cell_and_index,
                  internal::DataOut::ParallelData<DH::dimension, DH::space_dimension> &data,
-                 DataOutBase::Patch<DH::dimension, DH::space_dimension> &patch,
+                 DataOutBase::Patch<DH::dimension, DH::space_dimension> &,
                  const CurvedCellRegion curved_cell_region,
                  std::vector<DataOutBase::Patch<DH::dimension, DH::space_dimension> > &patches)
 {
+  // build the patch right where it belongs in the patches vector. every
+  // cell has its own patch, so there are no conflicts between threads, and
+  // we avoid allocating the data of each patch twice and copying it
+  const unsigned int patch_idx =
+    (*data.cell_to_patch_index_map)[cell_and_index->first->level()][cell_and_index->first->index()];
+  // did we mess up the indices?
+  Assert(patch_idx < patches.size(), ExcInternalError());
+
+  DataOutBase::Patch<DH::dimension, DH::space_dimension> &patch = patches[patch_idx];
+  patch.n_subdivisions = data.n_subdivisions;
+  patch.patch_index = patch_idx;
+
   // use ucd_to_deal map as patch vertices are in the old, unnatural
   // ordering. if the mapping does not preserve locations
   // (e.g. MappingQEulerian), we need to compute the offset of the vertex for
@@ -250,6 +262,12 @@ build_one_patch (const std::pair<cell_iterator, unsigned int> *cell_and_index,
             }
         }
     }
+  else
+    {
+      // no data, but the patch still has the usual shape
+      patch.data.reinit (0, Utilities::fixed_power<DH::dimension>(data.n_subdivisions+1));
+      patch.points_are_available = false;
+    }
 
 
   for (unsigned int f=0; f<GeometryInfo<DH::dimension>::faces_per_cell; ++f)
@@ -292,15 +310,6 @@ build_one_patch (const std::pair<cell_iterator, unsigned int> *cell_and_index,
       patch.neighbors[f]
         = (*data.cell_to_patch_index_map)[neighbor->level()][neighbor->index()];
     }
-
-  const unsigned int patch_idx =
-    (*data.cell_to_patch_index_map)[cell_and_index->first->level()][cell_and_index->first->index()];
-  // did we mess up the indices?
-  Assert(patch_idx < patches.size(), ExcInternalError());
-
-  // Put the patch in the patches vector
-  patches[patch_idx] = patch;
-  patches[patch_idx].patch_index = patch_idx;
 }
 
 
@@ -438,10 +447,10 @@ void DataOut<dim,DH>::build_patches (const Mapping<DH::dimension,DH::space_dimen
                update_flags,
                cell_to_patch_index_map);
 
+  // WorkStream needs an object for the data that is copied from the
+  // workers, but since the workers write the patches directly, this
+  // object is not used
   ::dealii::DataOutBase::Patch<DH::dimension, DH::space_dimension> sample_patch;
-  sample_patch.n_subdivisions = n_subdivisions;
-  sample_patch.data.reinit (n_datasets,
-                            Utilities::fixed_power<DH::dimension>(n_subdivisions+1));
 
 
   // now build the patches in parallel
@@ -0,0 +1,83 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/numerics/data_out_coarse.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/dofs/dof_handler.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, class DH>
+DataOutCoarse<dim,DH>::DataOutCoarse (const unsigned int max_level)
+  :
+  max_level (max_level)
+{}
+
+
+
+template <int dim, class DH>
+bool
+DataOutCoarse<dim,DH>::is_output_cell (const cell_iterator &cell) const
+{
+  return ((static_cast<unsigned int>(cell->level()) == max_level)
+          ||
+          ((static_cast<unsigned int>(cell->level()) < max_level)
+           &&
+           cell->active()));
+}
+
+
+
+template <int dim, class DH>
+typename DataOutCoarse<dim,DH>::cell_iterator
+DataOutCoarse<dim,DH>::first_cell ()
+{
+  cell_iterator cell = this->triangulation->begin();
+  while ((cell != this->triangulation->end()) &&
+         !is_output_cell (cell))
+    ++cell;
+  return cell;
+}
+
+
+
+template <int dim, class DH>
+typename DataOutCoarse<dim,DH>::cell_iterator
+DataOutCoarse<dim,DH>::next_cell (const cell_iterator &old_cell)
+{
+  // cells are traversed level by level, so we are done once we have left
+  // the level given to the constructor
+  cell_iterator cell = old_cell;
+  if (cell != this->triangulation->end())
+    ++cell;
+  while ((cell != this->triangulation->end()) &&
+         !is_output_cell (cell))
+    {
+      if (static_cast<unsigned int>(cell->level()) > max_level)
+        return this->triangulation->end();
+      ++cell;
+    }
+  return cell;
+}
+
+
+
+// explicit instantiations
+#include "data_out_coarse.inst"
+
+DEAL_II_NAMESPACE_CLOSE
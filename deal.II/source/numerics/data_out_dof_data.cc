@@ -222,10 +222,14 @@ namespace internal
               duplicate = true;
           if (duplicate == false)
             {
-              typename DH::active_cell_iterator dh_cell(&cell->get_triangulation(),
-                                                        cell->level(),
-                                                        cell->index(),
-                                                        dof_data[dataset]->dof_handler);
+              // the cell need not be active if the first_cell()/next_cell()
+              // functions of DataOut have been overloaded to return coarser
+              // cells, in which case the values are interpolated from the
+              // children
+              typename DH::cell_iterator dh_cell(&cell->get_triangulation(),
+                                                 cell->level(),
+                                                 cell->index(),
+                                                 dof_data[dataset]->dof_handler);
               if (x_fe_values.empty())
                 {
                   AssertIndexRange(face,
@@ -1092,6 +1096,18 @@ DataOut_DoFData<DH,patch_dim,patch_space_dim>::get_patches () const
 
 
 
+template <class DH,
+          int patch_dim, int patch_space_dim>
+void
+DataOut_DoFData<DH,patch_dim,patch_space_dim>::
+release_patches (std::vector<dealii::DataOutBase::Patch<patch_dim, patch_space_dim> > &new_patches)
+{
+  new_patches.clear ();
+  new_patches.swap (patches);
+}
+
+
+
 template <class DH,
           int patch_dim, int patch_space_dim>
 std::vector<std_cxx1x::shared_ptr<dealii::hp::FECollection<DH::dimension,DH::space_dimension> > >
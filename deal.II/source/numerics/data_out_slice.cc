@@ -0,0 +1,568 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/work_stream.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/numerics/data_out_slice.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/hp/fe_values.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <algorithm>
+#include <cmath>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace DataOutSlice
+  {
+    template <int dim, int spacedim>
+    ParallelData<dim,spacedim>::
+    ParallelData (const unsigned int n_datasets,
+                  const unsigned int n_subdivisions,
+                  const std::vector<unsigned int> &n_postprocessor_outputs,
+                  const Mapping<dim,spacedim> &mapping,
+                  const std::vector<std_cxx1x::shared_ptr<dealii::hp::FECollection<dim,spacedim> > > &finite_elements,
+                  const UpdateFlags update_flags)
+      :
+      internal::DataOut::
+      ParallelDataBase<dim,spacedim> (n_datasets,
+                                      n_subdivisions,
+                                      n_postprocessor_outputs,
+                                      mapping,
+                                      finite_elements,
+                                      update_flags,
+                                      false)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    void
+    ParallelData<dim,spacedim>::
+    reinit_quadrature (const Quadrature<dim> &quadrature)
+    {
+      const dealii::hp::QCollection<dim> q_collection (quadrature);
+      for (unsigned int i=0; i<this->finite_elements.size(); ++i)
+        {
+          // check if there is a finite element that is equal to the
+          // present one, then we can re-use the FEValues object
+          bool duplicate = false;
+          for (unsigned int j=0; j<i; ++j)
+            if (this->finite_elements[i].get() ==
+                this->finite_elements[j].get())
+              {
+                this->x_fe_values[i] = this->x_fe_values[j];
+                duplicate = true;
+                break;
+              }
+          if (duplicate == false)
+            this->x_fe_values[i].reset(new dealii::hp::FEValues<dim,spacedim>
+                                       (this->mapping_collection,
+                                        *this->finite_elements[i],
+                                        q_collection,
+                                        this->update_flags));
+        }
+
+      const unsigned int n_q_points = quadrature.size();
+      this->patch_values.resize (n_q_points);
+      this->patch_values_system.resize (n_q_points);
+      this->patch_gradients.resize (n_q_points);
+      this->patch_gradients_system.resize (n_q_points);
+      this->patch_hessians.resize (n_q_points);
+      this->patch_hessians_system.resize (n_q_points);
+      for (unsigned int dataset=0; dataset<this->postprocessed_values.size(); ++dataset)
+        if (this->postprocessed_values[dataset].size() != 0)
+          {
+            const unsigned int n_components
+              = this->postprocessed_values[dataset][0].size();
+            this->postprocessed_values[dataset].resize (n_q_points,
+                                                        dealii::Vector<double>(n_components));
+          }
+
+      patch_normals.resize (n_q_points);
+      patch_evaluation_points.resize (n_q_points);
+    }
+
+
+
+    /**
+     * In a WorkStream context, use this function to append the patches
+     * computed by the parallel stage for one cell to the array of patches.
+     */
+    template <int dim, int spacedim>
+    void
+    append_patches_to_list (const std::vector<DataOutBase::Patch<dim-1,spacedim> > &cell_patches,
+                            std::vector<DataOutBase::Patch<dim-1,spacedim> > &patches)
+    {
+      for (unsigned int i=0; i<cell_patches.size(); ++i)
+        {
+          patches.push_back (cell_patches[i]);
+          patches.back().patch_index = patches.size()-1;
+        }
+    }
+
+
+
+    /**
+     * Sort the vertices of the polygon in which the plane with the given
+     * normal vector intersects a cell counter-clockwise around their
+     * center. There is nothing to do in 2d, where the intersection is a
+     * line segment.
+     */
+    template <int dim>
+    void
+    sort_polygon_vertices (const Point<dim>                     &normal,
+                           std::vector<Point<dim> >             &real_points,
+                           std::vector<Point<dim> >             &unit_points)
+    {
+      if (dim != 3)
+        return;
+
+      Point<dim> center;
+      for (unsigned int i=0; i<real_points.size(); ++i)
+        center += real_points[i];
+      center /= real_points.size();
+
+      // choose two orthonormal directions within the plane, starting from
+      // the coordinate direction that is closest to being orthogonal to it
+      unsigned int axis = 0;
+      for (unsigned int d=1; d<dim; ++d)
+        if (std::fabs(normal[d]) < std::fabs(normal[axis]))
+          axis = d;
+      Tensor<1,dim> e_axis;
+      e_axis[axis] = 1;
+      Tensor<1,dim> e1, e2;
+      cross_product (e1, normal, e_axis);
+      e1 /= e1.norm();
+      cross_product (e2, normal, e1);
+
+      std::vector<std::pair<double,unsigned int> > angles (real_points.size());
+      for (unsigned int i=0; i<real_points.size(); ++i)
+        {
+          const Tensor<1,dim> r = real_points[i] - center;
+          angles[i] = std::make_pair (std::atan2 (r*e2, r*e1), i);
+        }
+      std::sort (angles.begin(), angles.end());
+
+      const std::vector<Point<dim> > old_real_points (real_points);
+      const std::vector<Point<dim> > old_unit_points (unit_points);
+      for (unsigned int i=0; i<angles.size(); ++i)
+        {
+          real_points[i] = old_real_points[angles[i].second];
+          unit_points[i] = old_unit_points[angles[i].second];
+        }
+    }
+  }
+}
+
+
+
+template <int dim, class DH>
+DataOutSlice<dim,DH>::DataOutSlice (const Point<DH::space_dimension> &point_on_plane,
+                                    const Point<DH::space_dimension> &normal)
+{
+  Assert (dim == DH::dimension,
+          ExcNotImplemented());
+  set_plane (point_on_plane, normal);
+}
+
+
+
+template <int dim, class DH>
+void
+DataOutSlice<dim,DH>::set_plane (const Point<DH::space_dimension> &point_on_plane,
+                                 const Point<DH::space_dimension> &normal)
+{
+  Assert (normal.norm() > 0,
+          ExcMessage ("The normal vector of the plane must not be zero."));
+  this->point_on_plane = point_on_plane;
+  this->normal = normal / normal.norm();
+}
+
+
+
+template <int dim, class DH>
+void
+DataOutSlice<dim,DH>::
+compute_vertex_distances (const cell_iterator &cell,
+                          double (&distances)[GeometryInfo<dimension>::vertices_per_cell]) const
+{
+  for (unsigned int v=0; v<GeometryInfo<dimension>::vertices_per_cell; ++v)
+    distances[v] = (cell->vertex(v) - point_on_plane) * normal;
+}
+
+
+
+template <int dim, class DH>
+void
+DataOutSlice<dim,DH>::
+build_patches_on_cell (const std::pair<cell_iterator,unsigned int> *cell_and_index,
+                       internal::DataOutSlice::ParallelData<dimension, dimension> &data,
+                       std::vector<DataOutBase::Patch<dimension-1,space_dimension> > &cell_patches)
+{
+  const cell_iterator &cell = cell_and_index->first;
+  cell_patches.clear ();
+
+  // find the points in which the edges of the cell cross the plane. an edge
+  // is considered to cross the plane if its vertices are on different sides
+  // of it, where vertices on the plane count as being on its positive side.
+  // this way, a face that lies on the plane yields output only from the cell
+  // on its negative side
+  double distances[GeometryInfo<dimension>::vertices_per_cell];
+  compute_vertex_distances (cell, distances);
+
+  std::vector<Point<dimension> > unit_points;
+  std::vector<Point<space_dimension> > real_points;
+  const double tolerance = 1e-10 * cell->diameter();
+  for (unsigned int line=0; line<GeometryInfo<dimension>::lines_per_cell; ++line)
+    {
+      const unsigned int v0 = GeometryInfo<dimension>::line_to_cell_vertices (line, 0),
+                         v1 = GeometryInfo<dimension>::line_to_cell_vertices (line, 1);
+      if ((distances[v0] >= 0) == (distances[v1] >= 0))
+        continue;
+
+      const double t = distances[v0] / (distances[v0] - distances[v1]);
+      const Point<space_dimension> real_point = cell->vertex(v0)
+                                                + t * (cell->vertex(v1) - cell->vertex(v0));
+
+      // edges that cross the plane at a vertex yield the same point
+      // several times
+      bool duplicate = false;
+      for (unsigned int i=0; i<real_points.size(); ++i)
+        if (real_points[i].distance (real_point) <= tolerance)
+          {
+            duplicate = true;
+            break;
+          }
+      if (duplicate == true)
+        continue;
+
+      real_points.push_back (real_point);
+      unit_points.push_back (GeometryInfo<dimension>::unit_cell_vertex(v0)
+                             + t * (GeometryInfo<dimension>::unit_cell_vertex(v1) -
+                                    GeometryInfo<dimension>::unit_cell_vertex(v0)));
+    }
+
+  // the plane only touches the cell in a vertex or, in 3d, an edge
+  if (real_points.size() < dimension)
+    return;
+
+  internal::DataOutSlice::sort_polygon_vertices (normal, real_points, unit_points);
+
+  // split the polygon into patches. in 2d, the intersection is a line
+  // segment. in 3d, it is a polygon with up to six vertices that we split
+  // into quadrilaterals sharing its first vertex, where the last one may
+  // be a triangle
+  std::vector<std::vector<Point<dimension> > > patch_unit_vertices;
+  if (dimension == 2)
+    {
+      Assert (unit_points.size() == 2, ExcInternalError());
+      patch_unit_vertices.push_back (unit_points);
+    }
+  else
+    {
+      const unsigned int n_points = unit_points.size();
+      for (unsigned int i=1; i+1<n_points; i+=2)
+        {
+          // the vertices of patches are numbered lexicographically, not
+          // counter-clockwise
+          std::vector<Point<dimension> > quad (4);
+          quad[0] = unit_points[0];
+          quad[1] = unit_points[i];
+          quad[2] = unit_points[std::min (i+2, n_points-1)];
+          quad[3] = unit_points[i+1];
+          patch_unit_vertices.push_back (quad);
+        }
+    }
+
+  const Quadrature<dimension-1> patch_quadrature (QIterated<dimension-1>(QTrapez<1>(),
+                                                  data.n_subdivisions));
+  const unsigned int n_q_points = patch_quadrature.size();
+
+  for (unsigned int p=0; p<patch_unit_vertices.size(); ++p)
+    {
+      DataOutBase::Patch<dimension-1,space_dimension> patch;
+      patch.n_subdivisions = data.n_subdivisions;
+
+      for (unsigned int vertex=0; vertex<GeometryInfo<dimension-1>::vertices_per_cell; ++vertex)
+        patch.vertices[vertex] = data.mapping_collection[0].transform_unit_to_real_cell
+                                 (cell, patch_unit_vertices[p][vertex]);
+
+      if (data.n_datasets > 0)
+        {
+          // map the points of the subdivided patch to the unit cell and
+          // evaluate the fields there
+          std::vector<Point<dimension> > unit_q_points (n_q_points);
+          for (unsigned int q=0; q<n_q_points; ++q)
+            for (unsigned int vertex=0; vertex<GeometryInfo<dimension-1>::vertices_per_cell; ++vertex)
+              unit_q_points[q] += GeometryInfo<dimension-1>::d_linear_shape_function
+                                  (patch_quadrature.point(q), vertex)
+                                  * patch_unit_vertices[p][vertex];
+
+          data.reinit_quadrature (Quadrature<dimension> (unit_q_points,
+                                                         std::vector<double> (n_q_points, 1.)));
+          data.reinit_all_fe_values(this->dof_data, cell);
+          const FEValuesBase<dimension> &fe_patch_values
+            = data.get_present_fe_values (0);
+
+          // store the intermediate points
+          Assert(patch.space_dim==dimension, ExcInternalError());
+          const std::vector<Point<dimension> > &q_points=fe_patch_values.get_quadrature_points();
+          // resize the patch.data member in order to have enough memory for
+          // the quadrature points as well
+          patch.data.reinit(data.n_datasets+dimension, n_q_points);
+          // set the flag indicating that for this patch the points are
+          // explicitly given
+          patch.points_are_available=true;
+          // copy points to patch.data
+          for (unsigned int i=0; i<dimension; ++i)
+            for (unsigned int q=0; q<n_q_points; ++q)
+              patch.data(patch.data.size(0)-dimension+i,q)=q_points[q][i];
+
+          // counter for data records
+          unsigned int offset=0;
+
+          // first fill dof_data
+          for (unsigned int dataset=0; dataset<this->dof_data.size(); ++dataset)
+            {
+              const FEValuesBase<dimension> &this_fe_patch_values
+                = data.get_present_fe_values (dataset);
+              const unsigned int n_components
+                = this_fe_patch_values.get_fe().n_components();
+              const DataPostprocessor<dim> *postprocessor=this->dof_data[dataset]->postprocessor;
+              if (postprocessor != 0)
+                {
+                  // we have to postprocess the data, so determine, which
+                  // fields have to be updated
+                  const UpdateFlags update_flags=postprocessor->get_needed_update_flags();
+
+                  // the normal vectors are those of the plane
+                  if (update_flags & update_normal_vectors)
+                    std::fill (data.patch_normals.begin(), data.patch_normals.end(),
+                               normal);
+
+                  if (update_flags & update_quadrature_points)
+                    data.patch_evaluation_points = this_fe_patch_values.get_quadrature_points();
+
+                  if (n_components == 1)
+                    {
+                      // at each point there is only one component of value,
+                      // gradient etc.
+                      if (update_flags & update_values)
+                        this->dof_data[dataset]->get_function_values (this_fe_patch_values,
+                                                                      data.patch_values);
+                      if (update_flags & update_gradients)
+                        this->dof_data[dataset]->get_function_gradients (this_fe_patch_values,
+                                                                         data.patch_gradients);
+                      if (update_flags & update_hessians)
+                        this->dof_data[dataset]->get_function_hessians (this_fe_patch_values,
+                                                                        data.patch_hessians);
+
+                      postprocessor->
+                      compute_derived_quantities_scalar(data.patch_values,
+                                                        data.patch_gradients,
+                                                        data.patch_hessians,
+                                                        data.patch_normals,
+                                                        data.patch_evaluation_points,
+                                                        data.postprocessed_values[dataset]);
+                    }
+                  else
+                    {
+                      // at each point there is a vector valued function and
+                      // its derivative...
+                      data.resize_system_vectors(n_components);
+                      if (update_flags & update_values)
+                        this->dof_data[dataset]->get_function_values (this_fe_patch_values,
+                                                                      data.patch_values_system);
+                      if (update_flags & update_gradients)
+                        this->dof_data[dataset]->get_function_gradients (this_fe_patch_values,
+                                                                         data.patch_gradients_system);
+                      if (update_flags & update_hessians)
+                        this->dof_data[dataset]->get_function_hessians (this_fe_patch_values,
+                                                                        data.patch_hessians_system);
+
+                      postprocessor->
+                      compute_derived_quantities_vector(data.patch_values_system,
+                                                        data.patch_gradients_system,
+                                                        data.patch_hessians_system,
+                                                        data.patch_normals,
+                                                        data.patch_evaluation_points,
+                                                        data.postprocessed_values[dataset]);
+                    }
+
+                  for (unsigned int q=0; q<n_q_points; ++q)
+                    for (unsigned int component=0;
+                         component<this->dof_data[dataset]->n_output_variables; ++component)
+                      patch.data(offset+component,q)
+                        = data.postprocessed_values[dataset][q](component);
+                }
+              else
+                // now we use the given data vector without modifications.
+                // again, we treat single component functions separately for
+                // efficiency reasons.
+                if (n_components == 1)
+                  {
+                    this->dof_data[dataset]->get_function_values (this_fe_patch_values,
+                                                                  data.patch_values);
+                    for (unsigned int q=0; q<n_q_points; ++q)
+                      patch.data(offset,q) = data.patch_values[q];
+                  }
+                else
+                  {
+                    data.resize_system_vectors(n_components);
+                    this->dof_data[dataset]->get_function_values (this_fe_patch_values,
+                                                                  data.patch_values_system);
+                    for (unsigned int component=0; component<n_components;
+                         ++component)
+                      for (unsigned int q=0; q<n_q_points; ++q)
+                        patch.data(offset+component,q) =
+                          data.patch_values_system[q](component);
+                  }
+              // increment the counter for the actual data record
+              offset+=this->dof_data[dataset]->n_output_variables;
+            }
+
+          // then do the cell data
+          for (unsigned int dataset=0; dataset<this->cell_data.size(); ++dataset)
+            {
+              const double value
+                = this->cell_data[dataset]->get_cell_data_value (cell_and_index->second);
+              for (unsigned int q=0; q<n_q_points; ++q)
+                patch.data(dataset+offset,q) = value;
+            }
+        }
+
+      cell_patches.push_back (patch);
+    }
+}
+
+
+
+template <int dim, class DH>
+void DataOutSlice<dim,DH>::build_patches (const unsigned int n_subdivisions_)
+{
+  build_patches (StaticMappingQ1<dimension>::mapping, n_subdivisions_);
+}
+
+
+
+template <int dim, class DH>
+void DataOutSlice<dim,DH>::build_patches (const Mapping<dimension> &mapping,
+                                          const unsigned int n_subdivisions_)
+{
+  // Check consistency of redundant template parameter
+  Assert (dim==dimension, ExcDimensionMismatch(dim, dimension));
+
+  const unsigned int n_subdivisions = (n_subdivisions_ != 0)
+                                      ? n_subdivisions_
+                                      : this->default_subdivisions;
+
+  Assert (n_subdivisions >= 1,
+          ExcInvalidNumberOfSubdivisions(n_subdivisions));
+
+  typedef DataOut_DoFData<DH,dimension-1,dimension> BaseClass;
+  Assert (this->triangulation != 0,
+          typename BaseClass::ExcNoTriangulationSelected());
+
+  unsigned int n_datasets     = this->cell_data.size();
+  for (unsigned int i=0; i<this->dof_data.size(); ++i)
+    n_datasets += this->dof_data[i]->n_output_variables;
+
+  // first collect the cells that are cut by the plane, along with their
+  // index among the active cells that is needed to access cell data.
+  // finding them is cheap compared to building the patches, so we do it
+  // sequentially
+  std::vector<std::pair<cell_iterator,unsigned int> > cut_cells;
+  unsigned int cell_index = 0;
+  for (typename Triangulation<dimension,space_dimension>::active_cell_iterator
+       cell = this->triangulation->begin_active();
+       cell != this->triangulation->end(); ++cell, ++cell_index)
+    if (cell->is_locally_owned())
+      {
+        double distances[GeometryInfo<dimension>::vertices_per_cell];
+        compute_vertex_distances (cell, distances);
+
+        bool has_positive = false, has_negative = false;
+        for (unsigned int v=0; v<GeometryInfo<dimension>::vertices_per_cell; ++v)
+          if (distances[v] >= 0)
+            has_positive = true;
+          else
+            has_negative = true;
+
+        if (has_positive && has_negative)
+          cut_cells.push_back (std::make_pair (cell_iterator(cell), cell_index));
+      }
+
+  // clear the patches array. a cell yields up to two patches
+  this->patches.clear ();
+  this->patches.reserve (cut_cells.size());
+  if (cut_cells.size() == 0)
+    return;
+
+  std::vector<unsigned int> n_postprocessor_outputs (this->dof_data.size());
+  for (unsigned int dataset=0; dataset<this->dof_data.size(); ++dataset)
+    if (this->dof_data[dataset]->postprocessor)
+      n_postprocessor_outputs[dataset] = this->dof_data[dataset]->n_output_variables;
+    else
+      n_postprocessor_outputs[dataset] = 0;
+
+  UpdateFlags update_flags=update_values;
+  for (unsigned int i=0; i<this->dof_data.size(); ++i)
+    if (this->dof_data[i]->postprocessor)
+      update_flags |= this->dof_data[i]->postprocessor->get_needed_update_flags();
+  update_flags |= update_quadrature_points;
+  // normal vectors are not computed by the FEValues objects, but are
+  // taken from the plane
+  if (update_flags & update_normal_vectors)
+    update_flags = UpdateFlags (update_flags ^ update_normal_vectors);
+
+  internal::DataOutSlice::ParallelData<dimension, space_dimension>
+  thread_data (n_datasets,
+               n_subdivisions,
+               n_postprocessor_outputs,
+               mapping,
+               this->get_finite_elements(),
+               update_flags);
+  std::vector<DataOutBase::Patch<dimension-1,space_dimension> > sample_patches;
+
+  // now build the patches in parallel
+  WorkStream::run (&cut_cells[0],
+                   &cut_cells[0]+cut_cells.size(),
+                   std_cxx1x::bind(&DataOutSlice<dim,DH>::build_patches_on_cell,
+                                   this, std_cxx1x::_1, std_cxx1x::_2, std_cxx1x::_3),
+                   std_cxx1x::bind(&internal::DataOutSlice::
+                                   append_patches_to_list<dim,space_dimension>,
+                                   std_cxx1x::_1, std_cxx1x::ref(this->patches)),
+                   thread_data,
+                   sample_patches);
+}
+
+
+
+// explicit instantiations
+#include "data_out_slice.inst"
+
+DEAL_II_NAMESPACE_CLOSE
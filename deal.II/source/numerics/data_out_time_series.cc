@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/numerics/data_out_time_series.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/std_cxx1x/bind.h>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+template <int dim, int spacedim>
+DataOutTimeSeries<dim,spacedim>::
+DataOutTimeSeries (const Triangulation<dim,spacedim>     &triangulation,
+                   const std::string                     &filename_prefix,
+                   MPI_Comm                               mpi_communicator,
+                   const DataOutBase::DataOutFilterFlags &flags)
+  :
+  triangulation (&triangulation, typeid(*this).name()),
+  filename_prefix (filename_prefix),
+  relative_filename_prefix (filename_prefix.substr (filename_prefix.find_last_of('/') + 1)),
+  mpi_communicator (mpi_communicator),
+  flags (flags),
+  write_mesh (true),
+  n_meshes (0),
+  mesh_n_nodes (0),
+  mesh_n_cells (0)
+{
+  Assert (flags.xdmf_hdf5_output == true,
+          ExcMessage ("The data has to be filtered for XDMF and HDF5 output."));
+
+  tria_listener = triangulation.signals.any_change.connect
+                  (std_cxx1x::bind (&DataOutTimeSeries<dim,spacedim>::mesh_changed,
+                                    std_cxx1x::ref(*this)));
+}
+
+
+
+template <int dim, int spacedim>
+DataOutTimeSeries<dim,spacedim>::~DataOutTimeSeries ()
+{
+  tria_listener.disconnect ();
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutTimeSeries<dim,spacedim>::write (const DataOutInterface<dim,spacedim> &data_out,
+                                        const double                          time)
+{
+  DataOutBase::DataOutFilter data_filter (flags);
+  data_out.write_filtered_data (data_filter);
+
+  // the triangulation may not have changed, but the patches may have been
+  // built differently. since writing is collective, all processes have
+  // to agree on whether to write the mesh
+  const unsigned int sizes_differ = ((data_filter.n_nodes() != mesh_n_nodes)
+                                     ||
+                                     (data_filter.n_cells() != mesh_n_cells)) ? 1 : 0;
+  if (Utilities::MPI::max (sizes_differ, mpi_communicator) == 1)
+    write_mesh = true;
+
+  const std::string step = Utilities::int_to_string (xdmf_entries.size(), 5);
+  const std::string solution_filename = filename_prefix + "-" + step + ".h5";
+
+  if (write_mesh)
+    mesh_filename_suffix = "-mesh-" + Utilities::int_to_string (n_meshes, 4) + ".h5";
+
+  data_out.write_hdf5_parallel (data_filter, write_mesh,
+                                filename_prefix + mesh_filename_suffix,
+                                solution_filename, mpi_communicator);
+
+  if (write_mesh)
+    {
+      write_mesh   = false;
+      mesh_n_nodes = data_filter.n_nodes();
+      mesh_n_cells = data_filter.n_cells();
+      ++n_meshes;
+    }
+
+  xdmf_entries.push_back (data_out.create_xdmf_entry (data_filter,
+                                                      relative_filename_prefix + mesh_filename_suffix,
+                                                      relative_filename_prefix + "-" + step + ".h5",
+                                                      time, mpi_communicator));
+  data_out.write_xdmf_file (xdmf_entries, filename_prefix + ".xdmf",
+                            mpi_communicator);
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutTimeSeries<dim,spacedim>::mesh_changed ()
+{
+  write_mesh = true;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+DataOutTimeSeries<dim,spacedim>::n_written_meshes () const
+{
+  return n_meshes;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+DataOutTimeSeries<dim,spacedim>::n_written_time_steps () const
+{
+  return xdmf_entries.size();
+}
+
+
+// explicit instantiations
+#include "data_out_time_series.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
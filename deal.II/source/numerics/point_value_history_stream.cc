@@ -0,0 +1,394 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/numerics/point_value_history_stream.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/base/std_cxx1x/bind.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/lac/block_vector.h>
+#include <deal.II/lac/parallel_vector.h>
+#include <deal.II/lac/parallel_block_vector.h>
+#include <deal.II/lac/petsc_vector.h>
+#include <deal.II/lac/petsc_block_vector.h>
+#include <deal.II/lac/trilinos_vector.h>
+#include <deal.II/lac/trilinos_block_vector.h>
+#include <deal.II/grid/cell_locator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <fstream>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace
+{
+  const char file_header[] = "deal.II point value history 1";
+}
+
+
+
+template <int dim, int spacedim>
+PointValueHistoryStream<dim,spacedim>::
+PointValueHistoryStream (const DoFHandler<dim,spacedim>      &dof_handler,
+                         const std::vector<Point<spacedim> > &points,
+                         const std::string                   &filename,
+                         MPI_Comm                             mpi_communicator,
+                         const unsigned int                   chunk_size,
+                         const Mapping<dim,spacedim>         &mapping)
+  :
+  dof_handler (&dof_handler, typeid(*this).name()),
+  mapping (&mapping, typeid(*this).name()),
+  points (points),
+  filename (filename),
+  mpi_communicator (mpi_communicator),
+  chunk_size (chunk_size),
+  n_components (dof_handler.get_fe().n_components()),
+  cache_is_valid (false),
+  n_written_samples (0)
+{
+  Assert (chunk_size > 0, ExcMessage ("The chunk size must be positive."));
+
+  if (Utilities::MPI::this_mpi_process (mpi_communicator) == 0)
+    {
+      std::ofstream out (filename.c_str(), std::ios::binary);
+      AssertThrow (out, ExcIO());
+
+      const unsigned int header[3] = { static_cast<unsigned int>(points.size()),
+                                       n_components, spacedim
+                                     };
+      out << file_header << '\n';
+      out.write (reinterpret_cast<const char *>(&header[0]), sizeof(header));
+      for (unsigned int i=0; i<points.size(); ++i)
+        for (unsigned int d=0; d<spacedim; ++d)
+          {
+            const double coordinate = points[i][d];
+            out.write (reinterpret_cast<const char *>(&coordinate), sizeof(double));
+          }
+
+      AssertThrow (out, ExcIO());
+    }
+
+  tria_listener = dof_handler.get_tria().signals.any_change.connect
+                  (std_cxx1x::bind (&PointValueHistoryStream<dim,spacedim>::tria_change_listener,
+                                    std_cxx1x::ref(*this)));
+}
+
+
+
+template <int dim, int spacedim>
+PointValueHistoryStream<dim,spacedim>::~PointValueHistoryStream ()
+{
+  tria_listener.disconnect ();
+
+  if (time_buffer.size() > 0)
+    flush ();
+}
+
+
+
+template <int dim, int spacedim>
+void
+PointValueHistoryStream<dim,spacedim>::build_cache ()
+{
+  const unsigned int n_processes = Utilities::MPI::n_mpi_processes (mpi_communicator);
+  const unsigned int my_process = Utilities::MPI::this_mpi_process (mpi_communicator);
+
+  // locate all points, and claim the ones that lie in locally owned cells.
+  // a point on the boundary between the cells of two processes may be
+  // found by both of them, in which case the one with the smaller rank
+  // wins
+  const CellLocator<DoFHandler<dim,spacedim> > cell_locator (*dof_handler, *mapping);
+  std::vector<std::pair<typename DoFHandler<dim,spacedim>::active_cell_iterator, Point<dim> > >
+  cell_points;
+  cell_locator.find_active_cells_around_points (points, cell_points);
+
+  std::vector<unsigned int> claims (points.size(), n_processes);
+  for (unsigned int i=0; i<points.size(); ++i)
+    if ((cell_points[i].first != dof_handler->end())
+        &&
+        cell_points[i].first->is_locally_owned())
+      claims[i] = my_process;
+
+  point_owners.resize (points.size());
+#ifdef DEAL_II_WITH_MPI
+  if (points.size() > 0)
+    MPI_Allreduce (&claims[0], &point_owners[0], points.size(),
+                   MPI_UNSIGNED, MPI_MIN, mpi_communicator);
+#else
+  point_owners = claims;
+#endif
+
+  n_points_per_process.assign (n_processes, 0);
+  position_on_owner.resize (points.size());
+  locally_owned_points.clear ();
+  for (unsigned int i=0; i<points.size(); ++i)
+    {
+      AssertThrow (point_owners[i] < n_processes,
+                   GridTools::ExcPointNotFound<spacedim>(points[i]));
+      position_on_owner[i] = n_points_per_process[point_owners[i]]++;
+      if (point_owners[i] == my_process)
+        locally_owned_points.push_back (i);
+    }
+
+  // then compute the degrees of freedom and the values of the shape
+  // functions for the locally owned points
+  cache_start.resize (locally_owned_points.size()+1);
+  cache_start[0] = 0;
+  for (unsigned int i=0; i<locally_owned_points.size(); ++i)
+    cache_start[i+1] = cache_start[i]
+                       + cell_points[locally_owned_points[i]].first->get_fe().dofs_per_cell;
+  cache_dof_indices.resize (cache_start.back());
+  cache_shape_values.resize (n_components * cache_start.back());
+
+  for (unsigned int i=0; i<locally_owned_points.size(); ++i)
+    {
+      const typename DoFHandler<dim,spacedim>::active_cell_iterator
+      cell = cell_points[locally_owned_points[i]].first;
+      const FiniteElement<dim,spacedim> &fe = cell->get_fe();
+
+      const Quadrature<dim>
+      quadrature (GeometryInfo<dim>::project_to_unit_cell (cell_points[locally_owned_points[i]].second));
+      FEValues<dim,spacedim> fe_values (*mapping, fe, quadrature, update_values);
+      fe_values.reinit (cell);
+
+      std::vector<types::global_dof_index> dof_indices (fe.dofs_per_cell);
+      cell->get_dof_indices (dof_indices);
+      std::copy (dof_indices.begin(), dof_indices.end(),
+                 cache_dof_indices.begin() + cache_start[i]);
+
+      for (unsigned int c=0; c<n_components; ++c)
+        for (unsigned int j=0; j<fe.dofs_per_cell; ++j)
+          cache_shape_values[n_components*cache_start[i] + c*fe.dofs_per_cell + j]
+            = fe_values.shape_value_component (j, 0, c);
+    }
+
+  value_buffer.resize (locally_owned_points.size() * n_components * chunk_size);
+  cache_is_valid = true;
+}
+
+
+
+template <int dim, int spacedim>
+template <class VECTOR>
+void
+PointValueHistoryStream<dim,spacedim>::add_sample (const double  time,
+                                                   const VECTOR &solution)
+{
+  if (cache_is_valid == false)
+    {
+      // the samples in the buffer belong to the points as they were
+      // distributed before, so write them first
+      if (time_buffer.size() > 0)
+        flush ();
+      build_cache ();
+    }
+
+  const unsigned int step = time_buffer.size();
+  time_buffer.push_back (time);
+
+  for (unsigned int i=0; i<locally_owned_points.size(); ++i)
+    {
+      const unsigned int n_dofs = cache_start[i+1] - cache_start[i];
+      const types::global_dof_index *dof_indices = &cache_dof_indices[cache_start[i]];
+      const double *shape_values = &cache_shape_values[n_components*cache_start[i]];
+      for (unsigned int c=0; c<n_components; ++c, shape_values += n_dofs)
+        {
+          double value = 0;
+          for (unsigned int j=0; j<n_dofs; ++j)
+            value += shape_values[j] * static_cast<double>(solution(dof_indices[j]));
+          value_buffer[(i*n_components+c)*chunk_size + step] = value;
+        }
+    }
+
+  if (time_buffer.size() == chunk_size)
+    flush ();
+}
+
+
+
+template <int dim, int spacedim>
+void
+PointValueHistoryStream<dim,spacedim>::flush ()
+{
+  const unsigned int n_steps = time_buffer.size();
+  if (n_steps == 0)
+    return;
+
+  // pack the columns of the locally owned points without the unused part
+  // of the buffer
+  const unsigned int n_columns = locally_owned_points.size() * n_components;
+  std::vector<double> local_columns (n_columns * n_steps);
+  for (unsigned int column=0; column<n_columns; ++column)
+    std::copy (value_buffer.begin() + column*chunk_size,
+               value_buffer.begin() + column*chunk_size + n_steps,
+               local_columns.begin() + column*n_steps);
+
+  // collect them on the first process
+  const unsigned int n_processes = Utilities::MPI::n_mpi_processes (mpi_communicator);
+  std::vector<unsigned int> offsets (n_processes+1, 0);
+  for (unsigned int p=0; p<n_processes; ++p)
+    offsets[p+1] = offsets[p] + n_points_per_process[p] * n_components * n_steps;
+
+  std::vector<double> all_columns;
+#ifdef DEAL_II_WITH_MPI
+  if (Utilities::MPI::this_mpi_process (mpi_communicator) == 0)
+    all_columns.resize (offsets.back());
+  std::vector<int> counts (n_processes), displacements (n_processes);
+  for (unsigned int p=0; p<n_processes; ++p)
+    {
+      counts[p] = offsets[p+1] - offsets[p];
+      displacements[p] = offsets[p];
+    }
+  MPI_Gatherv (local_columns.size() > 0 ? &local_columns[0] : 0,
+               local_columns.size(), MPI_DOUBLE,
+               all_columns.size() > 0 ? &all_columns[0] : 0,
+               &counts[0], &displacements[0], MPI_DOUBLE,
+               0, mpi_communicator);
+#else
+  all_columns.swap (local_columns);
+#endif
+
+  // then append the chunk to the file, with the columns ordered by the
+  // global index of the points
+  if (Utilities::MPI::this_mpi_process (mpi_communicator) == 0)
+    {
+      std::ofstream out (filename.c_str(), std::ios::binary | std::ios::app);
+      AssertThrow (out, ExcIO());
+
+      out.write (reinterpret_cast<const char *>(&n_steps), sizeof(n_steps));
+      out.write (reinterpret_cast<const char *>(&time_buffer[0]),
+                 n_steps * sizeof(double));
+      for (unsigned int i=0; i<points.size(); ++i)
+        out.write (reinterpret_cast<const char *>(&all_columns[offsets[point_owners[i]]
+                                                               + position_on_owner[i]*n_components*n_steps]),
+                   n_components * n_steps * sizeof(double));
+
+      AssertThrow (out, ExcIO());
+    }
+
+  n_written_samples += n_steps;
+  time_buffer.clear ();
+}
+
+
+
+template <int dim, int spacedim>
+void
+PointValueHistoryStream<dim,spacedim>::invalidate_cache ()
+{
+  cache_is_valid = false;
+}
+
+
+
+template <int dim, int spacedim>
+void
+PointValueHistoryStream<dim,spacedim>::tria_change_listener ()
+{
+  cache_is_valid = false;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+PointValueHistoryStream<dim,spacedim>::n_points () const
+{
+  return points.size();
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+PointValueHistoryStream<dim,spacedim>::n_locally_owned_points () const
+{
+  return locally_owned_points.size();
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+PointValueHistoryStream<dim,spacedim>::n_samples () const
+{
+  return n_written_samples + time_buffer.size();
+}
+
+
+
+template <int dim, int spacedim>
+void
+PointValueHistoryStream<dim,spacedim>::
+read (std::istream                                    &in,
+      std::vector<Point<spacedim> >                   &locations,
+      std::vector<double>                             &times,
+      std::vector<std::vector<std::vector<double> > > &values)
+{
+  AssertThrow (in, ExcIO());
+
+  std::string header;
+  std::getline (in, header);
+  AssertThrow (header == file_header,
+               ExcInvalidFile ("the file does not start with the expected header"));
+
+  unsigned int sizes[3];
+  in.read (reinterpret_cast<char *>(&sizes[0]), sizeof(sizes));
+  AssertThrow (in, ExcInvalidFile ("the file ends within its header"));
+  AssertThrow (sizes[2] == spacedim,
+               ExcInvalidFile ("the file was written for a different space dimension"));
+  const unsigned int n_file_points = sizes[0], n_file_components = sizes[1];
+
+  locations.resize (n_file_points);
+  for (unsigned int i=0; i<n_file_points; ++i)
+    for (unsigned int d=0; d<spacedim; ++d)
+      in.read (reinterpret_cast<char *>(&locations[i][d]), sizeof(double));
+  AssertThrow (in, ExcInvalidFile ("the file ends within its header"));
+
+  times.clear ();
+  values.clear ();
+  values.resize (n_file_points, std::vector<std::vector<double> > (n_file_components));
+
+  unsigned int n_steps;
+  while (in.read (reinterpret_cast<char *>(&n_steps), sizeof(n_steps)))
+    {
+      const std::size_t old_size = times.size();
+      times.resize (old_size + n_steps);
+      if (n_steps > 0)
+        in.read (reinterpret_cast<char *>(&times[old_size]), n_steps * sizeof(double));
+      for (unsigned int i=0; i<n_file_points; ++i)
+        for (unsigned int c=0; c<n_file_components; ++c)
+          {
+            values[i][c].resize (old_size + n_steps);
+            if (n_steps > 0)
+              in.read (reinterpret_cast<char *>(&values[i][c][old_size]),
+                       n_steps * sizeof(double));
+          }
+      AssertThrow (in, ExcInvalidFile ("the file ends within a chunk"));
+    }
+}
+
+
+
+// explicit instantiations
+#include "point_value_history_stream.inst"
+
+
+DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,112 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check the error bounded rounding of output data: the data stored in a
+// DataOutFilter must not differ from the exact data by more than the
+// tolerance of each data set, data sets with zero tolerance must be
+// unchanged, and compressed VTU files must become smaller
+
+#include "../tests.h"
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/logstream.h>
+
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "patches.h"
+
+
+void test ()
+{
+  std::vector<DataOutBase::Patch<3,3> > patches (12);
+  create_patches (patches);
+
+  // replace the data by values whose last bits look random
+  for (unsigned int p=0; p<patches.size(); ++p)
+    for (unsigned int s=0; s<patches[p].data.n_rows(); ++s)
+      for (unsigned int i=0; i<patches[p].data.n_cols(); ++i)
+        patches[p].data(s,i) = std::sin (1.234*i + 0.1*p + s) * (s+1);
+
+  std::vector<std::string> names(5);
+  names[0] = "a";
+  names[1] = "b";
+  names[2] = "c";
+  names[3] = "d";
+  names[4] = "e";
+  std::vector<std_cxx1x::tuple<unsigned int, unsigned int, std::string> > vectors;
+
+  std::vector<double> tolerances (5);
+  tolerances[0] = 1e-2;
+  tolerances[1] = 1e-4;
+  tolerances[2] = 0;
+  tolerances[3] = 1e-6;
+  tolerances[4] = 0.3;
+
+  DataOutBase::DataOutFilter exact (DataOutBase::DataOutFilterFlags (false, false));
+  DataOutBase::write_filtered_data (patches, names, vectors, exact);
+
+  DataOutBase::DataOutFilterFlags filter_flags (false, false);
+  filter_flags.data_tolerances = tolerances;
+  DataOutBase::DataOutFilter rounded (filter_flags);
+  DataOutBase::write_filtered_data (patches, names, vectors, rounded);
+
+  for (unsigned int s=0; s<exact.n_data_sets(); ++s)
+    {
+      double max_error = 0;
+      unsigned int n_changed = 0;
+      for (unsigned int i=0; i<exact.n_nodes(); ++i)
+        {
+          const double error = std::fabs (exact.get_data_set(s)[i] -
+                                          rounded.get_data_set(s)[i]);
+          max_error = std::max (max_error, error);
+          if (error != 0)
+            ++n_changed;
+        }
+      deallog << exact.get_data_set_name(s) << ": tolerance " << tolerances[s]
+              << ", error within tolerance: "
+              << (max_error <= tolerances[s] ? "yes" : "no")
+              << ", values changed: " << (n_changed > 0 ? "yes" : "no")
+              << std::endl;
+    }
+
+  // then compare the sizes of compressed VTU files
+  DataOutBase::VtkFlags flags;
+  flags.print_date_and_time = false;
+  std::ostringstream exact_vtu;
+  DataOutBase::write_vtu (patches, names, vectors, flags, exact_vtu);
+
+  flags.data_tolerances = tolerances;
+  std::ostringstream rounded_vtu;
+  DataOutBase::write_vtu (patches, names, vectors, flags, rounded_vtu);
+
+  deallog << "rounded file is smaller: "
+          << (rounded_vtu.str().size() < exact_vtu.str().size() ? "yes" : "no")
+          << std::endl;
+}
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  test ();
+}
@@ -0,0 +1,232 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// write VTU files with all compression levels, with inline and with
+// appended data, and with data arrays large enough to be split into
+// several compressed blocks. decode and decompress the data arrays again
+// and check that they are the same in all cases, and that the points are
+// the ones of the patches
+
+#include "../tests.h"
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/logstream.h>
+
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <stdint.h>
+#include <zlib.h>
+
+#include "patches.h"
+
+
+// decode base64 data, ignoring padding
+std::vector<char> decode_base64 (const std::string &in)
+{
+  static const std::string alphabet
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::vector<char> out;
+  unsigned int buffer = 0, n_bits = 0;
+  for (unsigned int i=0; i<in.size() && in[i] != '='; ++i)
+    {
+      buffer = (buffer << 6) | alphabet.find (in[i]);
+      n_bits += 6;
+      if (n_bits >= 8)
+        {
+          n_bits -= 8;
+          out.push_back ((char)((buffer >> n_bits) & 0xff));
+        }
+    }
+  return out;
+}
+
+
+// decompress the blocks described by the given header
+std::vector<char> decompress (const std::vector<uint32_t> &header,
+                              const char                  *compressed)
+{
+  const unsigned int n_blocks = header[0];
+  std::vector<char> out;
+  for (unsigned int b=0; b<n_blocks; ++b)
+    {
+      uLongf size = (b == n_blocks-1 ? header[2] : header[1]);
+      std::vector<char> block (size);
+      const int err = uncompress ((Bytef *)&block[0], &size,
+                                  (const Bytef *)compressed, header[3+b]);
+      AssertThrow (err == Z_OK, ExcInternalError());
+      AssertThrow (size == block.size(), ExcInternalError());
+      out.insert (out.end(), block.begin(), block.end());
+      compressed += header[3+b];
+    }
+  return out;
+}
+
+
+// split the inline data of one DataArray into the base64 encoded header
+// and data, and decode them
+std::vector<char> decode_inline (const std::string &text,
+                                 unsigned int      &n_blocks)
+{
+  std::vector<char> first = decode_base64 (text.substr (0, 8));
+  n_blocks = *reinterpret_cast<uint32_t *>(&first[0]);
+  const unsigned int header_length = 4*((4*(3+n_blocks)+2)/3);
+
+  std::vector<char> h = decode_base64 (text.substr (0, header_length));
+  std::vector<uint32_t> header (3+n_blocks);
+  std::memcpy (&header[0], &h[0], header.size()*sizeof(uint32_t));
+
+  std::vector<char> compressed = decode_base64 (text.substr (header_length));
+  return decompress (header, &compressed[0]);
+}
+
+
+// decode the data at the given offset of the appended data
+std::vector<char> decode_appended (const char   *appended,
+                                   unsigned int &n_blocks)
+{
+  n_blocks = *reinterpret_cast<const uint32_t *>(appended);
+  std::vector<uint32_t> header (3+n_blocks);
+  std::memcpy (&header[0], appended, header.size()*sizeof(uint32_t));
+  return decompress (header, appended + header.size()*sizeof(uint32_t));
+}
+
+
+// return the decoded data arrays of the given file, along with the
+// number of compressed blocks of each
+std::vector<std::vector<char> >
+decode_file (const std::string          &file,
+             std::vector<unsigned int> &n_blocks)
+{
+  std::vector<std::vector<char> > arrays;
+  n_blocks.clear ();
+
+  const std::string appended_marker = "<AppendedData encoding=\"raw\">\n_";
+  const std::size_t appended_start = file.find (appended_marker);
+
+  std::size_t pos = 0;
+  while ((pos = file.find ("<DataArray", pos)) < appended_start)
+    {
+      const std::size_t tag_end = file.find (">", pos);
+      const std::string tag = file.substr (pos, tag_end-pos);
+      pos = tag_end;
+      // skip the ascii metadata
+      if (tag.find ("format=\"ascii\"") != std::string::npos)
+        continue;
+
+      unsigned int blocks = 0;
+      if (tag.find ("format=\"appended\"") != std::string::npos)
+        {
+          AssertThrow (appended_start != std::string::npos, ExcInternalError());
+          const std::size_t offset_pos = tag.find ("offset=\"") + 8;
+          const unsigned int offset = std::atoi (tag.c_str() + offset_pos);
+          arrays.push_back (decode_appended (file.c_str() + appended_start +
+                                             appended_marker.size() + offset,
+                                             blocks));
+        }
+      else
+        {
+          AssertThrow (tag.find ("format=\"binary\"") != std::string::npos,
+                       ExcInternalError());
+          const std::size_t data_end = file.find ("</DataArray>", tag_end);
+          std::string text;
+          for (std::size_t i=tag_end+1; i<data_end; ++i)
+            if (!std::isspace (file[i]))
+              text += file[i];
+          arrays.push_back (decode_inline (text, blocks));
+        }
+      n_blocks.push_back (blocks);
+    }
+  return arrays;
+}
+
+
+void test ()
+{
+  std::vector<DataOutBase::Patch<3,3> > patches (12);
+  create_patches (patches);
+
+  std::vector<std::string> names(5);
+  names[0] = "x1";
+  names[1] = "x2";
+  names[2] = "x3";
+  names[3] = "x4";
+  names[4] = "i";
+  std::vector<std_cxx1x::tuple<unsigned int, unsigned int, std::string> > vectors;
+  vectors.push_back (std_cxx1x::tuple<unsigned int, unsigned int, std::string> (0, 2, "x"));
+
+  const DataOutBase::VtkFlags::ZlibCompressionLevel levels[]
+    = { DataOutBase::VtkFlags::no_compression,
+        DataOutBase::VtkFlags::best_speed,
+        DataOutBase::VtkFlags::best_compression,
+        DataOutBase::VtkFlags::default_compression
+      };
+
+  std::vector<std::vector<char> > reference;
+  for (unsigned int l=0; l<4; ++l)
+    for (unsigned int appended=0; appended<2; ++appended)
+      {
+        DataOutBase::VtkFlags flags;
+        flags.print_date_and_time = false;
+        flags.compression_level = levels[l];
+        flags.write_appended_raw_data = (appended == 1);
+
+        std::ostringstream out;
+        DataOutBase::write_vtu (patches, names, vectors, flags, out);
+
+        std::vector<unsigned int> n_blocks;
+        const std::vector<std::vector<char> > arrays = decode_file (out.str(),
+                                                                    n_blocks);
+        deallog << "level " << l << (appended ? ", appended" : ", inline")
+                << ": " << arrays.size() << " arrays, blocks:";
+        for (unsigned int i=0; i<n_blocks.size(); ++i)
+          deallog << ' ' << n_blocks[i];
+        deallog << std::endl;
+
+        if (reference.size() == 0)
+          {
+            reference = arrays;
+
+            // the first array holds the points. compare the first and last
+            // one with the vertices of the first and last patch
+            const double *points = reinterpret_cast<const double *>(&arrays[0][0]);
+            const unsigned int n_points = arrays[0].size() / sizeof(double) / 3;
+            deallog << "points: " << n_points
+                    << ", first: " << points[0] << ' ' << points[1] << ' ' << points[2]
+                    << ", last: " << points[3*n_points-3] << ' '
+                    << points[3*n_points-2] << ' ' << points[3*n_points-1]
+                    << std::endl;
+            deallog << "expected first: " << patches[0].vertices[0]
+                    << ", last: " << patches.back().vertices[7] << std::endl;
+          }
+        else
+          deallog << "same data: " << (arrays == reference ? "yes" : "no")
+                  << std::endl;
+      }
+}
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  test ();
+}
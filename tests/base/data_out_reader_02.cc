@@ -0,0 +1,133 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+#include "../tests.h"
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/logstream.h>
+
+#include <vector>
+#include <iomanip>
+#include <fstream>
+#include <string>
+
+#include "patches.h"
+
+// test the binary intermediate format, and DataOutReader::read for a
+// list of files, some of which are binary, some text, and one of which
+// has no patches at all. the result has to be the same as reading the
+// text version of all files and merging them
+
+template <int dim, int spacedim>
+void check()
+{
+  std::vector<DataOutBase::Patch<dim, spacedim> > patches(1);
+  create_patches(patches);
+  patches[0].neighbors[0] = 0;
+
+  std::vector<std::string> names(5);
+  names[0] = "x1";
+  names[1] = "x2";
+  names[2] = "x3";
+  names[3] = "x4";
+  names[4] = "i";
+  std::vector<std_cxx1x::tuple<unsigned int, unsigned int, std::string> > vectors;
+  vectors.push_back (std_cxx1x::tuple<unsigned int, unsigned int, std::string>
+                     (0, spacedim-1, "x vector"));
+
+  std::ostringstream text_data, binary_data;
+  DataOutBase::write_deal_II_intermediate(patches, names, vectors,
+                                          DataOutBase::Deal_II_IntermediateFlags(),
+                                          text_data);
+  DataOutBase::write_deal_II_intermediate(patches, names, vectors,
+                                          DataOutBase::Deal_II_IntermediateFlags(true),
+                                          binary_data);
+  deallog << "dim=" << dim << ", spacedim=" << spacedim << std::endl;
+
+  // the binary file reads back to the same data as the text file
+  DataOutReader<dim,spacedim> from_text, from_binary;
+  {
+    std::istringstream input(text_data.str());
+    from_text.read (input);
+  }
+  {
+    std::istringstream input(binary_data.str());
+    from_binary.read (input);
+  }
+  {
+    std::ostringstream out1, out2;
+    from_text.write_deal_II_intermediate (out1);
+    from_binary.write_deal_II_intermediate (out2);
+    deallog << "binary round trip: "
+            << (out1.str() == out2.str() ? "identical" : "different")
+            << std::endl;
+  }
+
+  // write three files and read them together
+  {
+    std::ofstream out ("file0", std::ios::binary);
+    out << binary_data.str();
+  }
+  {
+    std::ofstream out ("file1");
+    out << text_data.str();
+  }
+  {
+    std::ofstream out ("file2", std::ios::binary);
+    DataOutBase::write_deal_II_intermediate(std::vector<DataOutBase::Patch<dim, spacedim> >(),
+                                            names, vectors,
+                                            DataOutBase::Deal_II_IntermediateFlags(true),
+                                            out);
+  }
+  std::vector<std::string> filenames;
+  filenames.push_back ("file0");
+  filenames.push_back ("file2");
+  filenames.push_back ("file1");
+
+  DataOutReader<dim,spacedim> all;
+  all.read (filenames);
+
+  // compare with merging the text version
+  DataOutReader<dim,spacedim> merged;
+  {
+    std::istringstream input(text_data.str());
+    merged.read (input);
+  }
+  merged.merge (from_text);
+
+  std::ostringstream out1, out2;
+  all.write_deal_II_intermediate (out1);
+  merged.write_deal_II_intermediate (out2);
+  deallog << "merged files: "
+          << (out1.str() == out2.str() ? "identical" : "different")
+          << std::endl;
+
+  for (unsigned int i=0; i<3; ++i)
+    std::remove (filenames[i].c_str());
+}
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+
+  check<1,1>();
+  check<1,2>();
+  check<2,2>();
+  check<2,3>();
+  check<3,3>();
+}
@@ -0,0 +1,139 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check that QuadratureRegistry hands out the same formulas as QGauss and
+// QGaussLobatto, and that the Gauss and Gauss-Lobatto formulas of high
+// order are accurate
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <fstream>
+#include <cmath>
+
+
+// give access to the algorithm QGaussLobatto<1> uses for low orders
+class ReferenceLobatto : public QGaussLobatto<1>
+{
+public:
+  ReferenceLobatto ()
+    :
+    QGaussLobatto<1> (2)
+  {}
+
+  void compute (const unsigned int   n,
+                std::vector<double> &points,
+                std::vector<double> &weights) const
+  {
+    const std::vector<long double> x = compute_quadrature_points (n, 1, 1);
+    const std::vector<long double> w = compute_quadrature_weights (x, 0, 0);
+    points.resize (n);
+    weights.resize (n);
+    for (unsigned int i=0; i<n; ++i)
+      {
+        points[i] = 0.5 + 0.5*static_cast<double>(x[i]);
+        weights[i] = 0.5*w[i];
+      }
+  }
+};
+
+
+
+template <int dim>
+void check_registry ()
+{
+  for (unsigned int n=2; n<6; ++n)
+    {
+      const Quadrature<dim> &gauss = QuadratureRegistry<dim>::gauss (n);
+      const Quadrature<dim> &lobatto = QuadratureRegistry<dim>::gauss_lobatto (n);
+      deallog << dim << "d, n=" << n << ": "
+              << (gauss == QGauss<dim>(n) ? "ok" : "wrong") << ' '
+              << (lobatto == QGaussLobatto<dim>(n) ? "ok" : "wrong") << ' '
+              << (&gauss == &QuadratureRegistry<dim>::gauss (n) ? "same" : "copy") << ' '
+              << (&lobatto == &QuadratureRegistry<dim>::gauss_lobatto (n) ? "same" : "copy")
+              << std::endl;
+    }
+}
+
+
+
+// return the largest error when integrating the monomials up to the given
+// degree on [0,1]
+double monomial_error (const Quadrature<1> &quadrature,
+                       const unsigned int   degree)
+{
+  double max_error = 0;
+  for (unsigned int k=0; k<=degree; ++k)
+    {
+      double sum = 0;
+      for (unsigned int q=0; q<quadrature.size(); ++q)
+        sum += std::pow (quadrature.point(q)(0), static_cast<double>(k)) *
+               quadrature.weight(q);
+      max_error = std::max (max_error, std::fabs (sum - 1./(k+1)));
+    }
+  return max_error;
+}
+
+
+
+void check_high_order (const unsigned int n)
+{
+  const QGauss<1> gauss (n);
+  const QGaussLobatto<1> lobatto (n);
+
+  // compare to the algorithm used for low orders
+  std::vector<double> points, weights;
+  ReferenceLobatto().compute (n, points, weights);
+  double difference = 0;
+  for (unsigned int i=0; i<n; ++i)
+    difference = std::max (difference,
+                           std::max (std::fabs (points[i] - lobatto.point(i)(0)),
+                                     std::fabs (weights[i] - lobatto.weight(i))));
+
+  // the points must be sorted and the formula symmetric
+  bool sorted = true;
+  for (unsigned int i=1; i<n; ++i)
+    if (!(lobatto.point(i)(0) > lobatto.point(i-1)(0)) ||
+        !(gauss.point(i)(0) > gauss.point(i-1)(0)))
+      sorted = false;
+
+  deallog << "n=" << n
+          << ": Gauss error " << (monomial_error (gauss, 2*n-1) < 1e-13 ? "ok" : "too large")
+          << ", Gauss-Lobatto error " << (monomial_error (lobatto, 2*n-3) < 1e-13 ? "ok" : "too large")
+          << ", difference to reference " << (difference < 1e-14 ? "ok" : "too large")
+          << ", sorted " << (sorted ? "yes" : "no")
+          << std::endl;
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  check_registry<1> ();
+  check_registry<2> ();
+  check_registry<3> ();
+
+  check_high_order (51);
+  check_high_order (64);
+  check_high_order (100);
+}
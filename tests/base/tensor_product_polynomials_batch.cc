@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check that the allocation-free and vectorized variant of
+// Polynomial::value and the evaluation of TensorProductPolynomials at many
+// points at once give exactly the same results as the evaluation at one
+// point at a time
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/polynomial.h>
+#include <deal.II/base/polynomials_piecewise.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/tensor_product_polynomials.h>
+#include <deal.II/base/vectorization.h>
+
+#include <fstream>
+
+
+void check_1d (const std::vector<Polynomials::Polynomial<double> > &polynomials)
+{
+  unsigned int n_different = 0;
+  std::vector<double> values (4);
+  double own_values[4], lane_values[4];
+  VectorizedArray<double> vectorized_values[4];
+  for (unsigned int i=0; i<polynomials.size(); ++i)
+    for (unsigned int q=0; q<7; ++q)
+      {
+        const double x = 0.13 + 0.15*q;
+        polynomials[i].value (x, values);
+        polynomials[i].value (x, 3, own_values);
+        VectorizedArray<double> x_vectorized;
+        for (unsigned int v=0; v<VectorizedArray<double>::n_array_elements; ++v)
+          x_vectorized[v] = x + 0.01*v;
+        polynomials[i].value (x_vectorized, 3, vectorized_values);
+        for (unsigned int d=0; d<4; ++d)
+          {
+            if (values[d] != own_values[d] ||
+                values[d] != vectorized_values[d][0])
+              ++n_different;
+            // the other lanes must agree with a scalar evaluation
+            for (unsigned int v=1; v<VectorizedArray<double>::n_array_elements; ++v)
+              {
+                polynomials[i].value (x_vectorized[v], 3, lane_values);
+                if (lane_values[d] != vectorized_values[d][v])
+                  ++n_different;
+              }
+          }
+      }
+  deallog << "1d: " << polynomials.size() << " polynomials, "
+          << n_different << " different values" << std::endl;
+}
+
+
+
+template <int dim, typename POLY>
+void check (const std::vector<POLY> &polynomials)
+{
+  TensorProductPolynomials<dim,POLY> tpp (polynomials);
+  const QGauss<dim> quadrature (polynomials.size()+1);
+  const unsigned int n_points = quadrature.size();
+
+  Table<2,double> values (tpp.n(), n_points);
+  Table<2,Tensor<1,dim> > grads (tpp.n(), n_points);
+  tpp.compute (quadrature.get_points(), values, grads);
+
+  // check also that values alone are computed correctly
+  Table<2,double> values_only (tpp.n(), n_points);
+  Table<2,Tensor<1,dim> > no_grads;
+  tpp.compute (quadrature.get_points(), values_only, no_grads);
+
+  std::vector<double> point_values (tpp.n());
+  std::vector<Tensor<1,dim> > point_grads (tpp.n());
+  std::vector<Tensor<2,dim> > point_grad_grads;
+  unsigned int n_different = 0;
+  for (unsigned int q=0; q<n_points; ++q)
+    {
+      tpp.compute (quadrature.point(q), point_values, point_grads,
+                   point_grad_grads);
+      for (unsigned int i=0; i<tpp.n(); ++i)
+        {
+          if (point_values[i] != values(i,q) ||
+              point_values[i] != values_only(i,q))
+            ++n_different;
+          if (point_grads[i] != grads(i,q))
+            ++n_different;
+        }
+    }
+  deallog << dim << "d: " << tpp.n() << " polynomials at " << n_points
+          << " points, " << n_different << " different values" << std::endl;
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  // Lagrange polynomials in product form, and Legendre polynomials in
+  // coefficient form
+  const std::vector<Polynomials::Polynomial<double> > lagrange
+    = Polynomials::generate_complete_Lagrange_basis (QGaussLobatto<1>(5).get_points());
+  const std::vector<Polynomials::Polynomial<double> > legendre
+    = Polynomials::Legendre::generate_complete_basis (4);
+
+  check_1d (lagrange);
+  check_1d (legendre);
+
+  check<1> (lagrange);
+  check<2> (lagrange);
+  check<3> (lagrange);
+  check<2> (legendre);
+  check<3> (legendre);
+
+  // piecewise polynomials take the general path
+  check<2> (Polynomials::generate_complete_Lagrange_basis_on_subdivisions (2, 2));
+}
@@ -0,0 +1,133 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check CellDoFIndexTable for a DoFHandler and an hp::DoFHandler on an
+// adaptively refined mesh: the indices must be those returned by the cell
+// accessors, and gathering and distributing ranges of cells must give the
+// same results as doing so cell by cell
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/cell_dof_index_table.h>
+#include <deal.II/hp/dof_handler.h>
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <fstream>
+
+
+template <class DH>
+void check (DH &dof_handler)
+{
+  CellDoFIndexTable<DH> table (dof_handler);
+
+  Vector<double> solution (dof_handler.n_dofs());
+  for (unsigned int i=0; i<solution.size(); ++i)
+    solution(i) = i+1;
+
+  bool indices_ok = true;
+  std::vector<double> cellwise_values;
+  Vector<double> cellwise_sum (dof_handler.n_dofs());
+  unsigned int n = 0;
+  for (typename DH::active_cell_iterator cell = dof_handler.begin_active();
+       cell != dof_handler.end(); ++cell, ++n)
+    {
+      std::vector<types::global_dof_index> indices (cell->get_fe().dofs_per_cell),
+          table_indices (table.n_dofs_per_cell(n));
+      cell->get_dof_indices (indices);
+      table.get_dof_indices (n, table_indices);
+      if (indices != table_indices || table.cell_number (cell) != n)
+        indices_ok = false;
+
+      Vector<double> local_values (cell->get_fe().dofs_per_cell);
+      cell->get_dof_values (solution, local_values);
+      cellwise_values.insert (cellwise_values.end(),
+                              local_values.begin(), local_values.end());
+      for (unsigned int i=0; i<indices.size(); ++i)
+        cellwise_sum(indices[i]) += local_values(i);
+    }
+
+  // gather and distribute in batches of 5 cells
+  std::vector<double> values, all_values;
+  Vector<double> sum (dof_handler.n_dofs());
+  for (unsigned int begin=0; begin<table.n_cells(); begin+=5)
+    {
+      const unsigned int end = std::min (begin+5, table.n_cells());
+      table.get_dof_values (solution, begin, end, values);
+      AssertThrow (values.size() == table.cell_start(end) - table.cell_start(begin),
+                   ExcInternalError());
+      all_values.insert (all_values.end(), values.begin(), values.end());
+      table.distribute_local_to_global (values, begin, end, sum);
+    }
+  sum -= cellwise_sum;
+
+  deallog << table.n_cells() << " cells, "
+          << table.cell_start(table.n_cells()) << " entries, indices "
+          << (indices_ok ? "ok" : "wrong") << ", values "
+          << (all_values == cellwise_values ? "ok" : "wrong")
+          << ", distributed difference " << sum.l2_norm() << std::endl;
+}
+
+
+
+template <int dim>
+void test ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (2);
+  tria.begin_active()->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+
+  FESystem<dim> fe (FE_Q<dim>(2), 2);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+  check (dof_handler);
+
+  hp::FECollection<dim> fe_collection;
+  fe_collection.push_back (FE_Q<dim>(1));
+  fe_collection.push_back (FE_Q<dim>(2));
+  hp::DoFHandler<dim> hp_dof_handler (tria);
+  unsigned int i = 0;
+  for (typename hp::DoFHandler<dim>::active_cell_iterator
+       cell = hp_dof_handler.begin_active(); cell != hp_dof_handler.end(); ++cell, ++i)
+    cell->set_active_fe_index (i % 2);
+  hp_dof_handler.distribute_dofs (fe_collection);
+  check (hp_dof_handler);
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  test<1> ();
+  test<2> ();
+  test<3> ();
+}
@@ -0,0 +1,145 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check DataOutCoarse on a locally refined mesh: count the patches for
+// different levels, and verify that a linear function is reproduced on
+// coarse cells and that piecewise constant data is averaged
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/function.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/numerics/vector_tools.h>
+#include <deal.II/numerics/data_out_coarse.h>
+
+#include <fstream>
+
+
+// have a class that makes sure we can get at the patches that the base
+// class generates
+template <int dim>
+class XDataOut : public DataOutCoarse<dim>
+{
+public:
+  XDataOut (const unsigned int max_level)
+    :
+    DataOutCoarse<dim> (max_level)
+  {}
+
+  const std::vector<typename ::DataOutBase::Patch<dim,dim> > &
+  get_patches() const
+  {
+    return DataOutCoarse<dim>::get_patches();
+  }
+};
+
+
+
+template <int dim>
+class LinearFunction : public Function<dim>
+{
+public:
+  double value (const Point<dim> &p,
+                const unsigned int) const
+  {
+    double v = 1;
+    for (unsigned int d=0; d<dim; ++d)
+      v += (d+1) * p[d];
+    return v;
+  }
+};
+
+
+
+template <int dim>
+void check ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (2);
+  tria.begin_active()->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+
+  FE_Q<dim> fe_q (1);
+  DoFHandler<dim> dof_handler_q (tria);
+  dof_handler_q.distribute_dofs (fe_q);
+  Vector<double> linear (dof_handler_q.n_dofs());
+  VectorTools::interpolate (dof_handler_q, LinearFunction<dim>(), linear);
+
+  // a piecewise constant function that is one except on the cells of the
+  // finest level, where it alternates between zero and two so that its
+  // average over their parent is one
+  FE_DGQ<dim> fe_dg (0);
+  DoFHandler<dim> dof_handler_dg (tria);
+  dof_handler_dg.distribute_dofs (fe_dg);
+  Vector<double> constant (dof_handler_dg.n_dofs());
+  std::vector<types::global_dof_index> dof_indices (1);
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler_dg.begin_active(); cell != dof_handler_dg.end(); ++cell)
+    {
+      cell->get_dof_indices (dof_indices);
+      constant(dof_indices[0]) = (cell->level() == 3 ? cell->index() % 2 * 2. : 1.);
+    }
+
+  for (unsigned int max_level=0; max_level<5; ++max_level)
+    {
+      XDataOut<dim> data_out (max_level);
+      data_out.add_data_vector (dof_handler_q, linear, "linear");
+      data_out.add_data_vector (dof_handler_dg, constant, "constant");
+      data_out.build_patches ();
+
+      const std::vector<DataOutBase::Patch<dim,dim> > &patches
+        = data_out.get_patches();
+
+      bool linear_ok = true, constant_ok = true;
+      for (unsigned int p=0; p<patches.size(); ++p)
+        for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+          {
+            if (std::fabs (patches[p].data(0,v) -
+                           LinearFunction<dim>().value (patches[p].vertices[v], 0)) > 1e-6)
+              linear_ok = false;
+            if (std::fabs (patches[p].data(1,v) - 1) > 1e-6)
+              constant_ok = false;
+          }
+
+      deallog << dim << "d, max_level=" << max_level << ": "
+              << patches.size() << " patches, linear "
+              << (linear_ok ? "ok" : "wrong") << ", constant "
+              << (constant_ok ? "ok" : "wrong") << std::endl;
+    }
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  check<2> ();
+  check<3> ();
+}
@@ -0,0 +1,173 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check DataOutSlice: interpolate a linear function onto a refined cube,
+// cut it by planes, and verify that the patches cover the intersection
+// of the plane with the cube and that the values on them are the ones of
+// the function at the output points
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/function.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/numerics/vector_tools.h>
+#include <deal.II/numerics/data_out_slice.h>
+
+#include <fstream>
+
+
+// have a class that makes sure we can get at the patches that the base
+// class generates
+template <int dim>
+class XDataOut : public DataOutSlice<dim>
+{
+public:
+  XDataOut (const Point<dim> &point_on_plane,
+            const Point<dim> &normal)
+    :
+    DataOutSlice<dim> (point_on_plane, normal)
+  {}
+
+  const std::vector<typename ::DataOutBase::Patch<dim-1,dim> > &
+  get_patches() const
+  {
+    return DataOutSlice<dim>::get_patches();
+  }
+};
+
+
+
+template <int dim>
+class LinearFunction : public Function<dim>
+{
+public:
+  double value (const Point<dim> &p,
+                const unsigned int) const
+  {
+    double v = 1;
+    for (unsigned int d=0; d<dim; ++d)
+      v += (d+1) * p[d];
+    return v;
+  }
+};
+
+
+
+// the measure of a patch, which is a line in 2d and a planar
+// quadrilateral with lexicographically numbered vertices in 3d
+double measure (const DataOutBase::Patch<1,2> &patch)
+{
+  return patch.vertices[0].distance (patch.vertices[1]);
+}
+
+
+double measure (const DataOutBase::Patch<2,3> &patch)
+{
+  Tensor<1,3> a, b;
+  cross_product (a, patch.vertices[1]-patch.vertices[0],
+                 patch.vertices[3]-patch.vertices[0]);
+  cross_product (b, patch.vertices[3]-patch.vertices[0],
+                 patch.vertices[2]-patch.vertices[0]);
+  return (a.norm() + b.norm()) / 2;
+}
+
+
+
+template <int dim>
+void check (const Point<dim>   &point_on_plane,
+            const Point<dim>   &normal,
+            const unsigned int  n_refinements)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (n_refinements);
+
+  FE_Q<dim> fe (2);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  Vector<double> solution (dof_handler.n_dofs());
+  VectorTools::interpolate (dof_handler, LinearFunction<dim>(), solution);
+
+  Vector<double> cell_data (tria.n_active_cells());
+  for (unsigned int i=0; i<cell_data.size(); ++i)
+    cell_data(i) = i;
+
+  XDataOut<dim> data_out (point_on_plane, normal);
+  data_out.attach_dof_handler (dof_handler);
+  data_out.add_data_vector (solution, "solution");
+  data_out.add_data_vector (cell_data, "cell_data");
+  data_out.build_patches (2);
+
+  const std::vector<DataOutBase::Patch<dim-1,dim> > &patches
+    = data_out.get_patches();
+
+  double total_measure = 0;
+  double max_value_error = 0;
+  double max_distance = 0;
+  for (unsigned int p=0; p<patches.size(); ++p)
+    {
+      total_measure += measure (patches[p]);
+
+      for (unsigned int q=0; q<patches[p].data.n_cols(); ++q)
+        {
+          Point<dim> x;
+          for (unsigned int d=0; d<dim; ++d)
+            x[d] = patches[p].data(2+d, q);
+
+          max_value_error = std::max (max_value_error,
+                                      std::fabs (patches[p].data(0,q) -
+                                                 LinearFunction<dim>().value (x, 0)));
+          max_distance = std::max (max_distance,
+                                   std::fabs ((x-point_on_plane) * normal) / normal.norm());
+        }
+    }
+
+  deallog << dim << "d, normal " << normal << ": "
+          << patches.size() << " patches, measure " << total_measure
+          << std::endl;
+
+  // patch data is stored in single precision
+  deallog << "values " << (max_value_error < 1e-6 ? "ok" : "wrong")
+          << ", points " << (max_distance < 1e-6 ? "ok" : "wrong")
+          << std::endl;
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  // cut through the middle of cells, along faces and diagonally
+  check<2> (Point<2>(0.3,0.3), Point<2>(1,0), 2);
+  check<2> (Point<2>(0.5,0.5), Point<2>(0,1), 2);
+  check<2> (Point<2>(0.5,0.5), Point<2>(1,1), 2);
+  check<2> (Point<2>(0.1,0.7), Point<2>(1,3), 3);
+
+  check<3> (Point<3>(0.3,0.3,0.3), Point<3>(0,0,1), 1);
+  check<3> (Point<3>(0.5,0.5,0.5), Point<3>(1,0,0), 1);
+  check<3> (Point<3>(0.5,0.5,0.5), Point<3>(1,1,1), 2);
+  check<3> (Point<3>(0.2,0.6,0.4), Point<3>(1,-2,3), 2);
+}
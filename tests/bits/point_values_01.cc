@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check VectorTools::point_values for a vector-valued function on a
+// locally refined mesh: evaluate along a line through the domain and
+// compare with VectorTools::point_value, then check that points outside
+// the mesh are reported
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/function.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/cell_locator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include <fstream>
+
+
+template <int dim>
+class TestFunction : public Function<dim>
+{
+public:
+  TestFunction ()
+    :
+    Function<dim> (2)
+  {}
+
+  double value (const Point<dim> &p,
+                const unsigned int component) const
+  {
+    return (component == 0 ? std::sin (p[0]) * std::cos (p[1]) : p.square());
+  }
+};
+
+
+
+template <int dim>
+void check ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball (tria);
+  tria.refine_global (2);
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell)
+    if (cell->center()[0] > 0)
+      cell->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+
+  FESystem<dim> fe (FE_Q<dim>(2), 2);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  MappingQ<dim> mapping (2);
+  Vector<double> solution (dof_handler.n_dofs());
+  VectorTools::interpolate (mapping, dof_handler, TestFunction<dim>(), solution);
+
+  // points along a line through the domain, several of which lie in the
+  // same cell
+  std::vector<Point<dim> > points;
+  for (unsigned int i=0; i<=100; ++i)
+    {
+      Point<dim> p;
+      for (unsigned int d=0; d<dim; ++d)
+        p[d] = -0.5 + 1. * i / 100 * (d+1) / dim;
+      points.push_back (p);
+    }
+
+  std::vector<Vector<double> > values;
+  VectorTools::point_values (mapping, dof_handler, solution, points, values);
+  deallog << dim << "d: " << values.size() << " values" << std::endl;
+
+  double max_difference = 0;
+  for (unsigned int i=0; i<points.size(); ++i)
+    {
+      Vector<double> value (2);
+      VectorTools::point_value (mapping, dof_handler, solution, points[i], value);
+      value -= values[i];
+      max_difference = std::max (max_difference, value.linfty_norm());
+    }
+  deallog << "difference to point_value: " << max_difference << std::endl;
+
+  for (unsigned int i=0; i<points.size(); i+=25)
+    deallog << points[i] << ": " << values[i](0) << ' ' << values[i](1)
+            << std::endl;
+
+  // use a cell locator that can be reused for several evaluations, and
+  // make sure a point outside the mesh is reported
+  CellLocator<DoFHandler<dim> > cell_locator (dof_handler, mapping);
+  points.push_back (Point<dim>::unit_vector(0) * 2);
+  try
+    {
+      VectorTools::point_values (cell_locator, solution, points, values);
+    }
+  catch (const GridTools::ExcPointNotFound<dim> &)
+    {
+      deallog << "point not found" << std::endl;
+    }
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  check<2> ();
+  check<3> ();
+}
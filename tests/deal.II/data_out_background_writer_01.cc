@@ -0,0 +1,147 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// write several files with DataOutBackgroundWriter and compare them with
+// the files DataOut writes directly. also check that errors are reported
+// by wait()
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/data_out_background_writer.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/numerics/data_out.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+
+std::string read_file (const std::string &filename)
+{
+  std::ifstream in (filename.c_str());
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  return contents.str();
+}
+
+
+template <int dim>
+void
+build_patches (DataOut<dim>          &data_out,
+               const DoFHandler<dim> &dof_handler,
+               const Vector<double>  &solution)
+{
+  data_out.attach_dof_handler (dof_handler);
+  data_out.add_data_vector (solution, "solution");
+  data_out.build_patches (2);
+}
+
+
+template <int dim>
+void test (const std::size_t max_queued_memory)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (2);
+
+  FE_Q<dim> fe (2);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  DataOutBase::VtkFlags vtk_flags;
+  vtk_flags.print_date_and_time = false;
+
+  DataOutBackgroundWriter<dim> writer (max_queued_memory);
+  std::vector<std::string> reference;
+  for (unsigned int step=0; step<4; ++step)
+    {
+      Vector<double> solution (dof_handler.n_dofs());
+      for (unsigned int i=0; i<solution.size(); ++i)
+        solution(i) = step + 1. * i / solution.size();
+
+      const DataOutBase::OutputFormat format
+        = (step % 2 == 0 ? DataOutBase::gnuplot : DataOutBase::vtu);
+
+      // write the file directly...
+      {
+        DataOut<dim> data_out;
+        data_out.set_flags (vtk_flags);
+        build_patches (data_out, dof_handler, solution);
+        std::ostringstream out;
+        data_out.write (out, format);
+        reference.push_back (out.str());
+      }
+
+      // ...and in the background. the DataOut object goes out of scope
+      // right away
+      {
+        DataOut<dim> data_out;
+        data_out.set_flags (vtk_flags);
+        build_patches (data_out, dof_handler, solution);
+        writer.write (data_out, "file-" + Utilities::int_to_string (step),
+                      format);
+      }
+    }
+
+  writer.wait ();
+  deallog << "queued files after wait(): " << writer.n_queued_files ()
+          << std::endl;
+
+  for (unsigned int step=0; step<reference.size(); ++step)
+    deallog << "file " << step << ": "
+            << (read_file ("file-" + Utilities::int_to_string (step))
+                == reference[step] ? "same" : "different")
+            << std::endl;
+
+  // now try to write to a file that can not be opened and check that the
+  // error is reported
+  {
+    DataOut<dim> data_out;
+    Vector<double> solution (dof_handler.n_dofs());
+    build_patches (data_out, dof_handler, solution);
+    writer.write (data_out, "does-not-exist/file", DataOutBase::gnuplot);
+  }
+  try
+    {
+      writer.wait ();
+      deallog << "no exception" << std::endl;
+    }
+  catch (const typename DataOutBackgroundWriter<dim>::ExcWriteFailed &)
+    {
+      deallog << "exception caught" << std::endl;
+    }
+
+  // errors are only reported once
+  writer.wait ();
+  deallog << "OK" << std::endl;
+}
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+
+  test<2> (0);
+  test<2> (1000000000);
+  test<3> (0);
+}
@@ -0,0 +1,140 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check DataOutFilter with and without filtering of duplicate vertices:
+// output the nodes, cells and data sets it produces for a small mesh, and
+// check for a larger one that the filtered nodes are unique and that the
+// cells refer to the right nodes
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/numerics/data_out.h>
+
+#include <fstream>
+#include <set>
+
+
+template <int dim>
+void check (const unsigned int n_refinements,
+            const bool         print)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria, -1, 1);
+  tria.refine_global (n_refinements);
+
+  FE_Q<dim> fe (1);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  Vector<double> u (dof_handler.n_dofs());
+  Vector<double> v (dof_handler.n_dofs());
+  for (unsigned int i=0; i<u.size(); ++i)
+    {
+      u(i) = i;
+      v(i) = 2.*i;
+    }
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler (dof_handler);
+  data_out.add_data_vector (u, "u");
+  data_out.add_data_vector (v, "v");
+  data_out.build_patches ();
+
+  for (unsigned int filter=0; filter<2; ++filter)
+    for (unsigned int xdmf=0; xdmf<2; ++xdmf)
+      {
+        DataOutBase::DataOutFilter
+        data_filter (DataOutBase::DataOutFilterFlags (filter == 1, xdmf == 1));
+        data_out.write_filtered_data (data_filter);
+
+        deallog << dim << "d, filter=" << filter << ", xdmf=" << xdmf
+                << ": " << data_filter.n_nodes() << " nodes, "
+                << data_filter.n_cells() << " cells, "
+                << data_filter.n_data_sets() << " data sets" << std::endl;
+
+        std::vector<double> node_data;
+        data_filter.fill_node_data (node_data);
+        std::vector<unsigned int> cell_data;
+        data_filter.fill_cell_data (0, cell_data);
+
+        if (print)
+          {
+            for (unsigned int i=0; i<data_filter.n_nodes(); ++i)
+              {
+                deallog << "node " << i << ":";
+                for (unsigned int d=0; d<dim; ++d)
+                  deallog << ' ' << node_data[i*dim+d];
+                deallog << std::endl;
+              }
+            for (unsigned int c=0; c<data_filter.n_cells(); ++c)
+              {
+                deallog << "cell " << c << ":";
+                for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+                  deallog << ' ' << cell_data[c*GeometryInfo<dim>::vertices_per_cell+v];
+                deallog << std::endl;
+              }
+            for (unsigned int s=0; s<data_filter.n_data_sets(); ++s)
+              {
+                deallog << data_filter.get_data_set_name (s) << ":";
+                const unsigned int n_components = data_filter.get_data_set_dim (s);
+                for (unsigned int i=0; i<data_filter.n_nodes()*n_components; ++i)
+                  deallog << ' ' << data_filter.get_data_set (s)[i];
+                deallog << std::endl;
+              }
+          }
+        else
+          {
+            // check that the nodes are unique if they are filtered, and
+            // that the cell vertices are at the right places: the first
+            // vertex of each cell has the smallest coordinates
+            std::set<std::vector<double> > unique_nodes;
+            for (unsigned int i=0; i<data_filter.n_nodes(); ++i)
+              unique_nodes.insert (std::vector<double> (node_data.begin()+i*dim,
+                                                        node_data.begin()+(i+1)*dim));
+            deallog << "unique nodes: " << unique_nodes.size() << std::endl;
+
+            bool cells_ok = true;
+            for (unsigned int c=0; c<data_filter.n_cells(); ++c)
+              for (unsigned int v=1; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+                for (unsigned int d=0; d<dim; ++d)
+                  if (node_data[cell_data[c*GeometryInfo<dim>::vertices_per_cell]*dim+d] >
+                      node_data[cell_data[c*GeometryInfo<dim>::vertices_per_cell+v]*dim+d] + 1e-10)
+                    cells_ok = false;
+            deallog << "cells " << (cells_ok ? "ok" : "wrong") << std::endl;
+          }
+      }
+}
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  check<2> (1, true);
+  check<3> (1, true);
+  check<2> (5, false);
+  check<3> (3, false);
+}
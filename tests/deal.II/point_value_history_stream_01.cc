@@ -0,0 +1,153 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// record the values of a time dependent vector-valued field with
+// PointValueHistoryStream, using a chunk size that does not divide the
+// number of samples and refining the mesh in between, then read the file
+// back and compare with VectorTools::point_value
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/function.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/numerics/vector_tools.h>
+#include <deal.II/numerics/point_value_history_stream.h>
+
+#include <fstream>
+
+
+template <int dim>
+class TestFunction : public Function<dim>
+{
+public:
+  TestFunction ()
+    :
+    Function<dim> (2)
+  {}
+
+  double value (const Point<dim> &p,
+                const unsigned int component) const
+  {
+    return (component == 0
+            ?
+            std::sin (p[0] + this->get_time()) * std::cos (p[1])
+            :
+            this->get_time() * p.square());
+  }
+};
+
+
+
+template <int dim>
+void check ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria, -1, 1);
+  tria.refine_global (2);
+
+  FESystem<dim> fe (FE_Q<dim>(2), 2);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  std::vector<Point<dim> > points;
+  for (unsigned int i=0; i<5; ++i)
+    {
+      Point<dim> p;
+      for (unsigned int d=0; d<dim; ++d)
+        p[d] = -0.9 + 0.43 * i * (d+1) / dim;
+      points.push_back (p);
+    }
+
+  TestFunction<dim> function;
+  Vector<double> solution;
+  std::vector<std::vector<Vector<double> > > expected;
+  const std::string filename = "point_value_history_stream.bin";
+  {
+    PointValueHistoryStream<dim> probes (dof_handler, points, filename,
+                                         MPI_COMM_SELF, 3);
+    for (unsigned int step=0; step<10; ++step)
+      {
+        // refine the mesh once in the middle of the run
+        if (step == 4)
+          {
+            tria.begin_active()->set_refine_flag ();
+            tria.execute_coarsening_and_refinement ();
+            dof_handler.distribute_dofs (fe);
+          }
+
+        function.set_time (0.1*step);
+        solution.reinit (dof_handler.n_dofs());
+        VectorTools::interpolate (dof_handler, function, solution);
+        probes.add_sample (0.1*step, solution);
+
+        expected.push_back (std::vector<Vector<double> > (points.size(),
+                                                          Vector<double>(2)));
+        for (unsigned int i=0; i<points.size(); ++i)
+          VectorTools::point_value (dof_handler, solution, points[i],
+                                    expected.back()[i]);
+      }
+    deallog << dim << "d: " << probes.n_points() << " points, "
+            << probes.n_locally_owned_points() << " owned, "
+            << probes.n_samples() << " samples" << std::endl;
+  }
+
+  std::ifstream in (filename.c_str(), std::ios::binary);
+  std::vector<Point<dim> > locations;
+  std::vector<double> times;
+  std::vector<std::vector<std::vector<double> > > values;
+  PointValueHistoryStream<dim>::read (in, locations, times, values);
+
+  deallog << "read " << locations.size() << " points, "
+          << times.size() << " samples" << std::endl;
+  for (unsigned int step=0; step<times.size(); ++step)
+    deallog << times[step] << ' ';
+  deallog << std::endl;
+
+  double max_difference = 0;
+  for (unsigned int i=0; i<points.size(); ++i)
+    {
+      max_difference = std::max (max_difference, locations[i].distance (points[i]));
+      for (unsigned int step=0; step<times.size(); ++step)
+        for (unsigned int c=0; c<2; ++c)
+          max_difference = std::max (max_difference,
+                                     std::fabs (values[i][c][step] - expected[step][i](c)));
+    }
+  deallog << "difference to point_value: " << max_difference << std::endl;
+
+  deallog << points[2] << ": " << values[2][0].back() << ' '
+          << values[2][1].back() << std::endl;
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  check<2> ();
+  check<3> ();
+}
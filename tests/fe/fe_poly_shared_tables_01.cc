@@ -0,0 +1,130 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check that the internal data objects of FE_Poly created for the same
+// quadrature formula share their tables of shape function values and
+// gradients, and that FEValues objects using shared tables compute the
+// same as before
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <fstream>
+
+
+// make the protected get_data() and the type of the internal data
+// accessible
+template <int dim>
+class TestFE : public FE_Q<dim>
+{
+public:
+  TestFE (const unsigned int degree)
+    :
+    FE_Q<dim> (degree)
+  {}
+
+  typedef typename FE_Poly<TensorProductPolynomials<dim>,dim,dim>::InternalData InternalData;
+
+  InternalData *
+  create_data (const UpdateFlags flags, const Quadrature<dim> &quadrature) const
+  {
+    return dynamic_cast<InternalData *>(this->get_data (flags, MappingQ1<dim>(),
+                                                        quadrature));
+  }
+};
+
+
+
+template <int dim>
+void test ()
+{
+  TestFE<dim> fe (3);
+  const QGauss<dim> quadrature (4);
+  const QGauss<dim> other_quadrature (3);
+
+  typedef typename TestFE<dim>::InternalData InternalData;
+  InternalData *data_1 = fe.create_data (update_values | update_gradients, quadrature);
+  InternalData *data_2 = fe.create_data (update_values | update_gradients, quadrature);
+  InternalData *data_3 = fe.create_data (update_values, quadrature);
+  InternalData *data_4 = fe.create_data (update_values | update_gradients, other_quadrature);
+
+  deallog << "same quadrature: "
+          << (data_1->shape_tables == data_2->shape_tables ? "shared" : "not shared")
+          << std::endl;
+  deallog << "values only: "
+          << (data_1->shape_tables == data_3->shape_tables ? "shared" : "not shared")
+          << std::endl;
+  deallog << "other quadrature: "
+          << (data_1->shape_tables == data_4->shape_tables ? "shared" : "not shared")
+          << std::endl;
+  deallog << "users: " << data_1->shape_tables.use_count() << std::endl;
+
+  delete data_1;
+  delete data_2;
+  delete data_3;
+  delete data_4;
+
+  // the tables computed only for values must not be handed out when
+  // gradients are requested
+  data_3 = fe.create_data (update_values, quadrature);
+  data_1 = fe.create_data (update_values | update_gradients, quadrature);
+  deallog << "values, then gradients: "
+          << (data_1->shape_tables == data_3->shape_tables ? "shared" : "not shared")
+          << ", gradients: " << data_1->shape_gradients.size()
+          << std::endl;
+  delete data_1;
+  delete data_3;
+
+  // FEValues objects on the same cell give the same results, also if one of
+  // them is created after the other one has been used
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  GridTools::distort_random (0.1, tria);
+  FEValues<dim> fe_values_1 (fe, quadrature, update_values | update_gradients);
+  fe_values_1.reinit (tria.begin_active());
+  FEValues<dim> fe_values_2 (fe, quadrature, update_values | update_gradients);
+  fe_values_2.reinit (tria.begin_active());
+
+  double difference = 0;
+  for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
+    for (unsigned int q=0; q<quadrature.size(); ++q)
+      difference += std::fabs (fe_values_1.shape_value(i,q) -
+                               fe_values_2.shape_value(i,q)) +
+                    (fe_values_1.shape_grad(i,q) -
+                     fe_values_2.shape_grad(i,q)).norm();
+  deallog << "difference: " << difference << std::endl;
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  test<2> ();
+  test<3> ();
+}
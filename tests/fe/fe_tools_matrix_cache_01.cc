@@ -0,0 +1,131 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check FETools::set_matrix_cache_directory: embedding and projection
+// matrices read back from the cache must be the same as the computed
+// ones, and a cache file must not be used for a different element of the
+// same name
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/fe/fe_dgp.h>
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_raviart_thomas.h>
+#include <deal.II/fe/fe_tools.h>
+
+#include <fstream>
+#include <vector>
+
+
+typedef std::vector<std::vector<FullMatrix<double> > > Matrices;
+
+
+template <int dim>
+Matrices create_matrices (const FiniteElement<dim> &fe)
+{
+  Matrices matrices (RefinementCase<dim>::isotropic_refinement);
+  for (unsigned int ref_case=RefinementCase<dim>::cut_x;
+       ref_case<=RefinementCase<dim>::isotropic_refinement; ++ref_case)
+    matrices[ref_case-1].resize (GeometryInfo<dim>::n_children(RefinementCase<dim>(ref_case)),
+                                 FullMatrix<double> (fe.dofs_per_cell, fe.dofs_per_cell));
+  return matrices;
+}
+
+
+
+double difference (const Matrices &a, const Matrices &b)
+{
+  double diff = 0;
+  for (unsigned int r=0; r<a.size(); ++r)
+    for (unsigned int c=0; c<a[r].size(); ++c)
+      {
+        FullMatrix<double> tmp = a[r][c];
+        tmp.add (-1., b[r][c]);
+        diff += tmp.frobenius_norm();
+      }
+  return diff;
+}
+
+
+
+template <int dim>
+void check (const FiniteElement<dim> &fe,
+            const bool                projection)
+{
+  Matrices computed = create_matrices (fe),
+           cached   = create_matrices (fe);
+
+  FETools::set_matrix_cache_directory ("");
+  FETools::compute_embedding_matrices (fe, computed);
+  if (projection)
+    {
+      Matrices computed_projection = create_matrices (fe),
+               cached_projection   = create_matrices (fe);
+      FETools::compute_projection_matrices (fe, computed_projection);
+
+      // the first call fills the cache, the second one reads from it
+      FETools::set_matrix_cache_directory (".");
+      for (unsigned int i=0; i<2; ++i)
+        {
+          cached_projection = create_matrices (fe);
+          FETools::compute_projection_matrices (fe, cached_projection);
+          deallog << fe.get_name() << ": projection difference "
+                  << difference (computed_projection, cached_projection)
+                  << std::endl;
+        }
+    }
+
+  FETools::set_matrix_cache_directory (".");
+  for (unsigned int i=0; i<2; ++i)
+    {
+      cached = create_matrices (fe);
+      FETools::compute_embedding_matrices (fe, cached);
+      deallog << fe.get_name() << ": embedding difference "
+              << difference (computed, cached)
+              << std::endl;
+    }
+  FETools::set_matrix_cache_directory ("");
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  check (FE_DGP<2>(2), true);
+  deallog << "cache file exists: "
+          << (std::ifstream ("FE-5fDGP-3c2-3e-282-29.embedding.2.matrices") ? "yes" : "no")
+          << std::endl;
+  check (FE_DGQ<3>(1), true);
+  check (FE_RaviartThomas<2>(1), false);
+
+  // two elements with the same name but different support points. the
+  // second one must not use the matrices of the first one
+  std::vector<Point<1> > points (3);
+  points[0] = Point<1>(0.);
+  points[1] = Point<1>(0.2);
+  points[2] = Point<1>(1.);
+  check (FE_DGQArbitraryNodes<2>(Quadrature<1>(points)), false);
+  points[1] = Point<1>(0.7);
+  check (FE_DGQArbitraryNodes<2>(Quadrature<1>(points)), false);
+}
@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check that FEValuesTensorProduct computes the same function values,
+// gradients, quadrature points, weights and integrated cell vectors as
+// FEValues on an affine mesh, and that it rejects cells that are not
+// affine
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_tensor_product.h>
+
+#include <fstream>
+
+
+template <int dim>
+Point<dim> shear (const Point<dim> &p)
+{
+  Point<dim> q = p;
+  q[0] += 0.3 * p[dim-1];
+  if (dim > 1)
+    q[1] *= 1.5;
+  return q;
+}
+
+
+
+template <int dim>
+void check (const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria, -1, 1);
+  tria.refine_global (2);
+  GridTools::transform (&shear<dim>, tria);
+
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  Vector<double> solution (dof_handler.n_dofs());
+  for (unsigned int i=0; i<solution.size(); ++i)
+    solution(i) = std::sin (1.3*i);
+
+  const QGauss<1> quadrature_1d (fe.degree+2);
+  FEValues<dim> fe_values (fe, QGauss<dim>(fe.degree+2),
+                           update_values | update_gradients |
+                           update_quadrature_points | update_JxW_values);
+  FEValuesTensorProduct<dim> fe_values_tp (fe, quadrature_1d);
+  const unsigned int n_q_points = fe_values.n_quadrature_points;
+  Assert (fe_values_tp.n_quadrature_points == n_q_points, ExcInternalError());
+
+  std::vector<double> values (n_q_points), values_tp (n_q_points);
+  std::vector<Tensor<1,dim> > gradients (n_q_points), gradients_tp (n_q_points);
+  Vector<double> cell_vector (fe.dofs_per_cell), cell_vector_tp (fe.dofs_per_cell);
+
+  double error_values = 0, error_gradients = 0, error_points = 0,
+         error_JxW = 0, error_integrate = 0;
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      fe_values.reinit (cell);
+      fe_values_tp.reinit (cell);
+
+      fe_values.get_function_values (solution, values);
+      fe_values.get_function_gradients (solution, gradients);
+      fe_values_tp.get_function_values (solution, values_tp);
+      fe_values_tp.get_function_gradients (solution, gradients_tp);
+
+      for (unsigned int q=0; q<n_q_points; ++q)
+        {
+          error_values += std::fabs (values[q] - values_tp[q]);
+          error_gradients += (gradients[q] - gradients_tp[q]).norm();
+          error_points += fe_values.quadrature_point(q).distance (fe_values_tp.quadrature_point(q));
+          error_JxW += std::fabs (fe_values.JxW(q) - fe_values_tp.JxW(q));
+        }
+
+      // integrate a nonlinear function of the solution against the shape
+      // functions and their gradients
+      for (unsigned int q=0; q<n_q_points; ++q)
+        {
+          values[q] = values[q] * values[q];
+          gradients[q] *= (1. + values[q]);
+        }
+      cell_vector = 0;
+      for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
+        for (unsigned int q=0; q<n_q_points; ++q)
+          cell_vector(i) += (values[q] * fe_values.shape_value(i,q) +
+                             gradients[q] * fe_values.shape_grad(i,q)) *
+                            fe_values.JxW(q);
+      cell_vector_tp = 0;
+      fe_values_tp.integrate (values, gradients, cell_vector_tp);
+      cell_vector_tp -= cell_vector;
+      error_integrate += cell_vector_tp.l2_norm();
+    }
+
+  deallog << fe.get_name()
+          << ": values " << error_values
+          << ", gradients " << error_gradients
+          << ", points " << error_points
+          << ", JxW " << error_JxW
+          << ", integrate " << error_integrate
+          << std::endl;
+
+  // distort the mesh so that the cells are no longer affine
+  if (dim > 1)
+    {
+      tria.begin_active()->vertex(3)[0] += 0.05;
+      try
+        {
+          fe_values_tp.reinit (typename Triangulation<dim>::cell_iterator (tria.begin_active()));
+          deallog << "distorted cell accepted" << std::endl;
+        }
+      catch (const typename FEValuesTensorProduct<dim>::ExcCellNotAffine &)
+        {
+          deallog << "distorted cell rejected" << std::endl;
+        }
+    }
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  check (FE_Q<1>(3));
+  check (FE_Q<2>(1));
+  check (FE_Q<2>(4));
+  check (FE_DGQ<2>(2));
+  check (FE_Q<3>(2));
+  check (FE_DGQ<3>(3));
+}
@@ -0,0 +1,139 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check FEValuesBase::get_function_values_from_local_dof_values and
+// get_function_gradients_from_local_dof_values against
+// get_function_values/gradients and against a direct evaluation with
+// shape_value_component/shape_grad_component, for scalar, primitive
+// vector-valued and non-primitive elements
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_raviart_thomas.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <fstream>
+
+
+template <int dim>
+void check (const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (1);
+  GridTools::distort_random (0.1, tria);
+
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  Vector<double> solution (dof_handler.n_dofs());
+  for (unsigned int i=0; i<solution.size(); ++i)
+    solution(i) = std::sin (1.3*i);
+  // zero entries are skipped in the evaluation, so make sure there are some
+  solution(0) = solution(3) = 0;
+
+  const QGauss<dim> quadrature (fe.degree+1);
+  FEValues<dim> fe_values (fe, quadrature, update_values | update_gradients);
+
+  const unsigned int n_q = quadrature.size();
+  const unsigned int n_c = fe.n_components();
+  std::vector<Vector<double> > values (n_q, Vector<double>(n_c)),
+      local_values (n_q, Vector<double>(n_c));
+  std::vector<std::vector<Tensor<1,dim> > >
+  gradients (n_q, std::vector<Tensor<1,dim> >(n_c)),
+             local_gradients (n_q, std::vector<Tensor<1,dim> >(n_c));
+  std::vector<double> scalar_values (n_q), scalar_local_values (n_q);
+  std::vector<Tensor<1,dim> > scalar_gradients (n_q), scalar_local_gradients (n_q);
+  Vector<double> local_dof_values (fe.dofs_per_cell);
+
+  double difference = 0, difference_direct = 0;
+  for (typename DoFHandler<dim>::active_cell_iterator cell = dof_handler.begin_active();
+       cell != dof_handler.end(); ++cell)
+    {
+      fe_values.reinit (cell);
+      cell->get_dof_values (solution, local_dof_values);
+
+      fe_values.get_function_values (solution, values);
+      fe_values.get_function_gradients (solution, gradients);
+      fe_values.get_function_values_from_local_dof_values (local_dof_values, local_values);
+      fe_values.get_function_gradients_from_local_dof_values (local_dof_values, local_gradients);
+
+      for (unsigned int q=0; q<n_q; ++q)
+        for (unsigned int c=0; c<n_c; ++c)
+          {
+            double value = 0;
+            Tensor<1,dim> gradient;
+            for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
+              {
+                value += local_dof_values(i) * fe_values.shape_value_component (i,q,c);
+                gradient += local_dof_values(i) * fe_values.shape_grad_component (i,q,c);
+              }
+
+            difference += std::fabs (values[q](c) - local_values[q](c));
+            difference += (gradients[q][c] - local_gradients[q][c]).norm();
+            difference_direct += std::fabs (value - values[q](c));
+            difference_direct += (gradient - gradients[q][c]).norm();
+          }
+
+      if (n_c == 1)
+        {
+          fe_values.get_function_values (solution, scalar_values);
+          fe_values.get_function_gradients (solution, scalar_gradients);
+          fe_values.get_function_values_from_local_dof_values (local_dof_values,
+                                                               scalar_local_values);
+          fe_values.get_function_gradients_from_local_dof_values (local_dof_values,
+                                                                  scalar_local_gradients);
+          for (unsigned int q=0; q<n_q; ++q)
+            {
+              difference += std::fabs (scalar_values[q] - scalar_local_values[q]);
+              difference += (scalar_gradients[q] - scalar_local_gradients[q]).norm();
+              difference_direct += std::fabs (scalar_values[q] - values[q](0));
+              difference_direct += (scalar_gradients[q] - gradients[q][0]).norm();
+            }
+        }
+    }
+
+  deallog << fe.get_name() << ": difference to local version: " << difference
+          << ", difference to direct evaluation: " << difference_direct
+          << std::endl;
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  check (FE_Q<2>(2));
+  check (FESystem<2>(FE_Q<2>(2), 2, FE_Q<2>(1), 1));
+  check (FE_RaviartThomas<2>(1));
+  check (FESystem<2>(FE_RaviartThomas<2>(0), 1, FE_Q<2>(1), 1));
+  check (FE_Q<3>(1));
+  check (FESystem<3>(FE_Q<3>(1), 3));
+}
@@ -0,0 +1,159 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// verify that FEValues objects give the same results with MappingQ1Cached
+// as with MappingQ1, both when the data is computed and when it is taken
+// from the cache, for several FEValues objects sharing the cache, after
+// refinement of the mesh and after moving vertices
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/fe/mapping_q1_cached.h>
+
+#include <fstream>
+
+
+template <int dim>
+double compare (const DoFHandler<dim> &dof_handler,
+                FEValues<dim>         &fe_values,
+                FEValues<dim>         &fe_values_cached)
+{
+  double difference = 0;
+  for (typename DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      fe_values.reinit (cell);
+      fe_values_cached.reinit (cell);
+
+      for (unsigned int q=0; q<fe_values.n_quadrature_points; ++q)
+        {
+          difference += std::fabs (fe_values.JxW(q) - fe_values_cached.JxW(q));
+          difference += fe_values.quadrature_point(q).distance
+                        (fe_values_cached.quadrature_point(q));
+          for (unsigned int d=0; d<dim; ++d)
+            {
+              difference += (fe_values.jacobian(q)[d] -
+                             fe_values_cached.jacobian(q)[d]).norm();
+              difference += (fe_values.inverse_jacobian(q)[d] -
+                             fe_values_cached.inverse_jacobian(q)[d]).norm();
+            }
+          for (unsigned int i=0; i<fe_values.dofs_per_cell; ++i)
+            {
+              difference += std::fabs (fe_values.shape_value(i,q) -
+                                       fe_values_cached.shape_value(i,q));
+              difference += (fe_values.shape_grad(i,q) -
+                             fe_values_cached.shape_grad(i,q)).norm();
+              difference += (fe_values.shape_hessian(i,q) -
+                             fe_values_cached.shape_hessian(i,q)).norm();
+            }
+        }
+    }
+  return difference;
+}
+
+
+
+template <int dim>
+void test ()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball (tria);
+  tria.refine_global (1);
+
+  const FE_Q<dim> fe_1 (1), fe_2 (2);
+  DoFHandler<dim> dof_handler_1 (tria), dof_handler_2 (tria);
+  dof_handler_1.distribute_dofs (fe_1);
+  dof_handler_2.distribute_dofs (fe_2);
+
+  const MappingQ1<dim>       mapping;
+  MappingQ1Cached<dim>       mapping_cached;
+  const QGauss<dim> quadrature (3);
+  const UpdateFlags update_flags = update_values | update_gradients |
+                                   update_hessians | update_JxW_values |
+                                   update_quadrature_points | update_jacobians |
+                                   update_inverse_jacobians;
+
+  // two FEValues objects with different elements, but the same
+  // quadrature formula and update flags, and that therefore share
+  // the data in mapping_cached
+  FEValues<dim> fe_values_1 (mapping, fe_1, quadrature, update_flags);
+  FEValues<dim> fe_values_2 (mapping, fe_2, quadrature, update_flags);
+  FEValues<dim> fe_values_cached_1 (mapping_cached, fe_1, quadrature, update_flags);
+  FEValues<dim> fe_values_cached_2 (mapping_cached, fe_2, quadrature, update_flags);
+
+  // the first loop computes and stores the data, the others use it
+  deallog << "first loop:  " << compare (dof_handler_1, fe_values_1, fe_values_cached_1)
+          << std::endl;
+  deallog << "second loop: " << compare (dof_handler_1, fe_values_1, fe_values_cached_1)
+          << std::endl;
+  deallog << "other FE:    " << compare (dof_handler_2, fe_values_2, fe_values_cached_2)
+          << std::endl;
+  deallog << "memory consumption is nonzero: "
+          << (mapping_cached.memory_consumption() > sizeof(mapping_cached) ? "yes" : "no")
+          << std::endl;
+
+  // refining the mesh discards the data
+  tria.refine_global (1);
+  dof_handler_1.distribute_dofs (fe_1);
+  dof_handler_2.distribute_dofs (fe_2);
+  deallog << "after refinement: "
+          << compare (dof_handler_1, fe_values_1, fe_values_cached_1) << ' '
+          << compare (dof_handler_2, fe_values_2, fe_values_cached_2)
+          << std::endl;
+
+  // moving vertices does not trigger a signal, but the cache has to find
+  // out about it
+  for (typename Triangulation<dim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell)
+    for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+      if (cell->vertex(v).norm() < 0.3)
+        cell->vertex(v) *= 1.01;
+  deallog << "after moving vertices: "
+          << compare (dof_handler_1, fe_values_1, fe_values_cached_1) << ' '
+          << compare (dof_handler_2, fe_values_2, fe_values_cached_2)
+          << std::endl;
+
+  mapping_cached.clear ();
+  deallog << "after clear: "
+          << compare (dof_handler_1, fe_values_1, fe_values_cached_1)
+          << std::endl;
+}
+
+
+
+int main ()
+{
+  initlog();
+  deallog.threshold_double(1.e-10);
+
+  test<2> ();
+  test<3> ();
+}
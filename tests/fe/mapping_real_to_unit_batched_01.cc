@@ -0,0 +1,184 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// verify that Mapping::transform_points_real_to_unit_cell gives the
+// same results as calling Mapping::transform_real_to_unit_cell for
+// each point, for MappingQ1, MappingQ and MappingCartesian, on affine
+// and on curved cells, and for points inside and far outside of the
+// cells for which the transformation may fail. the batched version is
+// allowed to succeed where the other one fails, but then it has to
+// return a correct result
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/tria_boundary_lib.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_cartesian.h>
+
+#include <fstream>
+#include <cstdlib>
+
+
+template <int dim, int spacedim>
+void check (const Triangulation<dim,spacedim> &tria,
+            const Mapping<dim,spacedim>       &mapping,
+            const std::string                 &name)
+{
+  unsigned int n_points = 0, n_failed = 0, n_mismatches = 0;
+
+  for (typename Triangulation<dim,spacedim>::active_cell_iterator
+       cell = tria.begin_active(); cell != tria.end(); ++cell)
+    {
+      // random points in a box around the cell that is three times as
+      // large as the cell
+      std::vector<Point<spacedim> > real_points (23);
+      for (unsigned int i=0; i<real_points.size(); ++i)
+        {
+          real_points[i] = cell->center();
+          for (unsigned int d=0; d<spacedim; ++d)
+            real_points[i][d] += 1.5 * cell->diameter() *
+                                 (2. * std::rand() / RAND_MAX - 1.);
+        }
+      // and a point far away
+      real_points.back() *= 10;
+
+      std::vector<Point<dim> > unit_points;
+      mapping.transform_points_real_to_unit_cell (cell, real_points, unit_points);
+      Assert (unit_points.size() == real_points.size(), ExcInternalError());
+
+      for (unsigned int i=0; i<real_points.size(); ++i)
+        {
+          ++n_points;
+          try
+            {
+              const Point<dim> p_unit
+                = mapping.transform_real_to_unit_cell (cell, real_points[i]);
+              if (!numbers::is_finite (unit_points[i][0]) ||
+                  (p_unit.distance (unit_points[i]) > 1e-9))
+                ++n_mismatches;
+            }
+          catch (typename Mapping<dim,spacedim>::ExcTransformationFailed &)
+            {
+              // for points outside the cell, the batched version may
+              // find a solution where the other one fails. if so, it
+              // has to be a correct one
+              if (numbers::is_finite (unit_points[i][0]))
+                {
+                  if (dim == spacedim &&
+                      mapping.transform_unit_to_real_cell (cell, unit_points[i])
+                      .distance (real_points[i]) > 1e-9 * cell->diameter())
+                    ++n_mismatches;
+                }
+              else
+                ++n_failed;
+            }
+        }
+    }
+
+  deallog << name << ": " << n_points << " points, "
+          << n_failed << " failed, "
+          << n_mismatches << " mismatches" << std::endl;
+}
+
+
+
+template <int dim, int spacedim>
+void test ()
+{
+  deallog << "dim=" << dim << ", spacedim=" << spacedim << std::endl;
+
+  const MappingQ1<dim,spacedim> mapping_q1;
+  const MappingQ<dim,spacedim>  mapping_q3 (3);
+
+  // a mesh of parallelograms
+  Triangulation<dim,spacedim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (1);
+  check (tria, mapping_q1, "affine, MappingQ1");
+  check (tria, mapping_q3, "affine, MappingQ(3)");
+
+  // then move the vertices so that the cells are no parallelograms any
+  // more. for dim<spacedim, the cells are not flat any more either
+  for (unsigned int v=0; v<tria.n_vertices(); ++v)
+    for (unsigned int d=0; d<spacedim; ++d)
+      const_cast<Point<spacedim>&>(tria.get_vertices()[v])[d]
+      += 0.08 * std::sin (3.*v + d);
+  check (tria, mapping_q1, "distorted, MappingQ1");
+  check (tria, mapping_q3, "distorted, MappingQ(3)");
+}
+
+
+
+template <int dim>
+void test_ball ()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  const HyperBallBoundary<dim> boundary;
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball (tria);
+  tria.set_boundary (0, boundary);
+  tria.refine_global (1);
+
+  check (tria, MappingQ1<dim>(), "ball, MappingQ1");
+  check (tria, MappingQ<dim>(3), "ball, MappingQ(3)");
+  check (tria, MappingQ<dim>(2, true), "ball, MappingQ(2) on all cells");
+
+  tria.set_boundary (0);
+}
+
+
+
+template <int dim>
+void test_cartesian ()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  std::vector<unsigned int> repetitions (dim, 2);
+  repetitions[0] = 3;
+  Point<dim> p1, p2;
+  for (unsigned int d=0; d<dim; ++d)
+    p2[d] = 1.+d;
+  GridGenerator::subdivided_hyper_rectangle (tria, repetitions, p1, p2);
+
+  check (tria, MappingCartesian<dim>(), "MappingCartesian");
+}
+
+
+
+int main ()
+{
+  initlog();
+
+  test<2,2> ();
+  test<3,3> ();
+  test<2,3> ();
+
+  test_ball<2> ();
+  test_ball<3> ();
+
+  test_cartesian<2> ();
+  test_cartesian<3> ();
+}
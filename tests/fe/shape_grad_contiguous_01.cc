@@ -0,0 +1,95 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check that FEValues stores the values, gradients and second
+// derivatives of one shape function at all quadrature points
+// contiguously, and that a Laplace matrix assembled through pointers to
+// this data is the same as one assembled through shape_grad()
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <fstream>
+
+
+template <int dim>
+void check (const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  GridTools::distort_random (0.1, tria);
+
+  const QGauss<dim> quadrature (fe.degree+1);
+  FEValues<dim> fe_values (fe, quadrature,
+                           update_values | update_gradients |
+                           update_hessians | update_JxW_values);
+  fe_values.reinit (tria.begin_active());
+
+  bool contiguous = true;
+  for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
+    for (unsigned int q=0; q<quadrature.size(); ++q)
+      if ((&fe_values.shape_value(i,0) + q != &fe_values.shape_value(i,q))
+          ||
+          (&fe_values.shape_grad(i,0) + q != &fe_values.shape_grad(i,q))
+          ||
+          (&fe_values.shape_hessian(i,0) + q != &fe_values.shape_hessian(i,q)))
+        contiguous = false;
+
+  FullMatrix<double> matrix (fe.dofs_per_cell), pointer_matrix (fe.dofs_per_cell);
+  for (unsigned int i=0; i<fe.dofs_per_cell; ++i)
+    for (unsigned int j=0; j<fe.dofs_per_cell; ++j)
+      {
+        for (unsigned int q=0; q<quadrature.size(); ++q)
+          matrix(i,j) += fe_values.shape_grad(i,q) * fe_values.shape_grad(j,q) *
+                         fe_values.JxW(q);
+
+        const Tensor<1,dim> *grad_i = &fe_values.shape_grad(i,0);
+        const Tensor<1,dim> *grad_j = &fe_values.shape_grad(j,0);
+        const double *JxW = &fe_values.get_JxW_values()[0];
+        double sum = 0;
+        for (unsigned int q=0; q<quadrature.size(); ++q)
+          sum += grad_i[q] * grad_j[q] * JxW[q];
+        pointer_matrix(i,j) = sum;
+      }
+  pointer_matrix.add (-1., matrix);
+
+  deallog << fe.get_name() << ": contiguous: " << (contiguous ? "yes" : "no")
+          << ", difference: " << pointer_matrix.frobenius_norm()
+          << std::endl;
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  check (FE_Q<2>(2));
+  check (FESystem<2>(FE_Q<2>(1), 2));
+  check (FE_Q<3>(1));
+}
@@ -0,0 +1,164 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that CellLocator finds the same cells and reference
+// coordinates as GridTools::find_active_cell_around_point, for single
+// and for batched queries, for points inside and outside the domain,
+// before and after refinement of the mesh, and with a mapping that
+// curves the cells at the boundary
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/tria_boundary_lib.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/cell_locator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <fstream>
+#include <cstdlib>
+
+
+template <int dim>
+std::vector<Point<dim> > random_points (const unsigned int n_points)
+{
+  std::vector<Point<dim> > points (n_points);
+  for (unsigned int i=0; i<n_points; ++i)
+    for (unsigned int d=0; d<dim; ++d)
+      points[i][d] = 2.2 * std::rand() / RAND_MAX - 1.1;
+  return points;
+}
+
+
+
+template <class Container>
+void check (const Container                                   &container,
+            const Mapping<Container::dimension,Container::space_dimension> &mapping,
+            const CellLocator<Container>                      &cell_locator)
+{
+  const unsigned int dim = Container::dimension;
+  typedef typename Container::active_cell_iterator cell_iterator;
+
+  const std::vector<Point<dim> > points = random_points<dim> (100);
+
+  std::vector<std::pair<cell_iterator, Point<dim> > > batch;
+  cell_locator.find_active_cells_around_points (points, batch);
+
+  unsigned int n_found = 0, n_not_found = 0, n_mismatches = 0;
+  for (unsigned int i=0; i<points.size(); ++i)
+    {
+      std::pair<cell_iterator, Point<dim> > expected (container.end(), Point<dim>());
+      try
+        {
+          expected = GridTools::find_active_cell_around_point (mapping, container,
+                                                               points[i]);
+        }
+      catch (GridTools::ExcPointNotFound<dim> &)
+        {}
+
+      std::pair<cell_iterator, Point<dim> > single (container.end(), Point<dim>());
+      try
+        {
+          single = cell_locator.find_active_cell_around_point (points[i]);
+        }
+      catch (GridTools::ExcPointNotFound<dim> &)
+        {}
+
+      if (expected.first != container.end())
+        ++n_found;
+      else
+        ++n_not_found;
+
+      if ((single.first != expected.first) ||
+          (batch[i].first != expected.first) ||
+          ((expected.first != container.end()) &&
+           ((single.second.distance (expected.second) > 1e-12) ||
+            (batch[i].second.distance (expected.second) > 1e-12))))
+        ++n_mismatches;
+    }
+
+  deallog << n_found << " points inside, "
+          << n_not_found << " points outside, "
+          << n_mismatches << " mismatches"
+          << std::endl;
+}
+
+
+
+template <int dim>
+void test ()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  const HyperBallBoundary<dim> boundary;
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball (tria);
+  tria.set_boundary (0, boundary);
+  tria.refine_global (dim == 2 ? 2 : 1);
+  tria.begin_active()->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+
+  FE_Q<dim> fe (1);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  const MappingQ1<dim> mapping_q1;
+  const MappingQ<dim>  mapping_q3 (3);
+
+  {
+    const CellLocator<Triangulation<dim> > cell_locator (tria);
+    const CellLocator<DoFHandler<dim> >    dof_cell_locator (dof_handler, mapping_q3);
+
+    check (tria, mapping_q1, cell_locator);
+    check (dof_handler, mapping_q3, dof_cell_locator);
+
+    // refine the mesh. the index has to be re-built
+    tria.refine_global (1);
+    dof_handler.distribute_dofs (fe);
+
+    check (tria, mapping_q1, cell_locator);
+    check (dof_handler, mapping_q3, dof_cell_locator);
+
+    // vertices of a cell are adjacent to that cell
+    const typename Triangulation<dim>::active_cell_iterator cell = tria.begin_active();
+    const std::vector<typename Triangulation<dim>::active_cell_iterator>
+    adjacent_cells = cell_locator.cells_adjacent_to_vertex (cell->vertex_index(0));
+    deallog << "cells adjacent to vertex: " << adjacent_cells.size() << std::endl;
+    Assert (std::find (adjacent_cells.begin(), adjacent_cells.end(), cell)
+            != adjacent_cells.end(),
+            ExcInternalError());
+  }
+
+  tria.set_boundary (0);
+}
+
+
+int main ()
+{
+  initlog();
+
+  test<2> ();
+  test<3> ();
+}
@@ -0,0 +1,232 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// read meshes that are large enough for GridIn::read_msh and
+// GridIn::read_ucd to split the nodes and elements into several
+// chunks, in gmsh format 1, ascii and binary gmsh format 2, and ucd
+// format, and verify that we always get the mesh we started from
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+
+#include <fstream>
+#include <sstream>
+#include <map>
+
+
+// convert a mesh in gmsh format 1 as written by GridOut::write_msh to
+// gmsh format 2, either in ascii or in binary. in the ascii case, use
+// vertex numbers that are not consecutive
+void convert_to_format_2 (const std::string &format_1,
+                          std::ostream      &out,
+                          const bool         binary)
+{
+  std::istringstream in (format_1);
+  std::string word;
+  unsigned int n_vertices, n_elements;
+
+  in >> word >> n_vertices;
+  Assert (word == "$NOD", ExcInternalError());
+
+  out << "$MeshFormat" << std::endl
+      << "2.2 " << (binary ? 1 : 0) << ' ' << sizeof(double) << std::endl;
+  if (binary)
+    {
+      const int one = 1;
+      out.write (reinterpret_cast<const char *>(&one), sizeof(one));
+      out << std::endl;
+    }
+  out << "$EndMeshFormat" << std::endl
+      << "$Nodes" << std::endl
+      << n_vertices << std::endl;
+  out.precision (10);
+  for (unsigned int v=0; v<n_vertices; ++v)
+    {
+      int number;
+      double x[3];
+      in >> number >> x[0] >> x[1] >> x[2];
+      if (binary)
+        {
+          out.write (reinterpret_cast<const char *>(&number), sizeof(number));
+          out.write (reinterpret_cast<const char *>(&x[0]), sizeof(x));
+        }
+      else
+        out << 10*number << ' ' << x[0] << ' ' << x[1] << ' ' << x[2] << std::endl;
+    }
+  if (binary)
+    out << std::endl;
+
+  in >> word;
+  Assert (word == "$ENDNOD", ExcInternalError());
+  in >> word >> n_elements;
+  Assert (word == "$ELM", ExcInternalError());
+
+  out << "$EndNodes" << std::endl
+      << "$Elements" << std::endl
+      << n_elements << std::endl;
+
+  // read all elements, then write them. in binary files, consecutive
+  // elements of the same type form a block
+  std::vector<std::vector<int> > elements (n_elements);
+  for (unsigned int e=0; e<n_elements; ++e)
+    {
+      int number, type, physical, elementary, n_nodes;
+      in >> number >> type >> physical >> elementary >> n_nodes;
+      elements[e].push_back (number);
+      elements[e].push_back (type);
+      elements[e].push_back (physical);
+      elements[e].push_back (elementary);
+      for (int i=0; i<n_nodes; ++i)
+        {
+          int node;
+          in >> node;
+          elements[e].push_back (binary ? node : 10*node);
+        }
+    }
+
+  for (unsigned int e=0; e<n_elements; )
+    if (binary)
+      {
+        unsigned int end = e;
+        while ((end < n_elements) && (elements[end][1] == elements[e][1]))
+          ++end;
+        const int header[3] = { elements[e][1], static_cast<int>(end-e), 2 };
+        out.write (reinterpret_cast<const char *>(&header[0]), sizeof(header));
+        for (; e<end; ++e)
+          {
+            out.write (reinterpret_cast<const char *>(&elements[e][0]), sizeof(int));
+            out.write (reinterpret_cast<const char *>(&elements[e][2]),
+                       (elements[e].size()-2)*sizeof(int));
+          }
+      }
+    else
+      {
+        out << elements[e][0] << ' ' << elements[e][1] << " 2";
+        for (unsigned int i=2; i<elements[e].size(); ++i)
+          out << ' ' << elements[e][i];
+        out << std::endl;
+        ++e;
+      }
+  if (binary)
+    out << std::endl;
+  out << "$EndElements" << std::endl;
+}
+
+
+
+template <int dim>
+void check (const Triangulation<dim> &original,
+            const std::string        &text,
+            const typename GridIn<dim>::Format format,
+            const std::string        &name)
+{
+  Triangulation<dim> tria;
+  GridIn<dim> grid_in;
+  grid_in.attach_triangulation (tria);
+  std::istringstream in (text);
+  grid_in.read (in, format);
+
+  std::map<unsigned int,unsigned int> boundary_faces;
+  int hash = 0;
+  int index = 0;
+  for (typename Triangulation<dim>::active_cell_iterator c=tria.begin_active();
+       c!=tria.end(); ++c, ++index)
+    {
+      for (unsigned int i=0; i<GeometryInfo<dim>::vertices_per_cell; ++i)
+        hash += (index * i * c->vertex_index(i)) % (tria.n_active_cells()+1);
+      for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+        if (c->at_boundary(f))
+          ++boundary_faces[c->face(f)->boundary_indicator()];
+    }
+
+  // the vertices have to come out in the same order as in the original
+  // triangulation, and exactly the same unless we wrote them with
+  // fewer digits
+  double max_difference = 0;
+  for (unsigned int v=0; v<tria.n_vertices(); ++v)
+    max_difference = std::max (max_difference,
+                               tria.get_vertices()[v].distance (original.get_vertices()[v]));
+
+  deallog << name << ": "
+          << tria.n_active_cells() << " active cells, "
+          << tria.n_used_vertices() << " vertices, hash=" << hash
+          << std::endl;
+  for (std::map<unsigned int,unsigned int>::const_iterator
+       p = boundary_faces.begin(); p != boundary_faces.end(); ++p)
+    deallog << "  " << p->second << " faces with boundary indicator "
+            << p->first << std::endl;
+  deallog << "  vertices "
+          << (max_difference == 0 ?
+              "identical" :
+              (max_difference < 1e-9 ? "within round-off" : "differ"))
+          << std::endl;
+}
+
+
+
+template <int dim>
+void test (const unsigned int n_subdivisions)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube (tria, n_subdivisions);
+  for (typename Triangulation<dim>::active_cell_iterator c=tria.begin_active();
+       c!=tria.end(); ++c)
+    for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+      if (c->at_boundary(f))
+        c->face(f)->set_boundary_indicator (f);
+
+  GridOut grid_out;
+  grid_out.set_flags (GridOutFlags::Msh (true));
+  grid_out.set_flags (GridOutFlags::Ucd (false, true));
+
+  std::ostringstream msh;
+  msh.precision (17);
+  grid_out.write_msh (tria, msh);
+
+  std::ostringstream ucd;
+  ucd.precision (17);
+  grid_out.write_ucd (tria, ucd);
+
+  std::ostringstream msh_2;
+  convert_to_format_2 (msh.str(), msh_2, false);
+
+  std::ostringstream msh_2_binary;
+  convert_to_format_2 (msh.str(), msh_2_binary, true);
+
+  deallog << "dim=" << dim << std::endl;
+  check (tria, msh.str(), GridIn<dim>::msh, "gmsh format 1");
+  check (tria, msh_2.str(), GridIn<dim>::msh, "gmsh format 2");
+  check (tria, msh_2_binary.str(), GridIn<dim>::msh, "binary gmsh format 2");
+  check (tria, ucd.str(), GridIn<dim>::ucd, "ucd");
+}
+
+
+int main ()
+{
+  initlog();
+
+  test<2> (70);
+  test<3> (17);
+}
@@ -0,0 +1,153 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+// write an adaptively and anisotropically refined mesh with
+// non-default material ids, boundary indicators and moved vertices
+// through GridOut::write_binary, read it back through
+// GridIn::read_binary, and verify that we get the same mesh
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/grid_out.h>
+
+#include <fstream>
+#include <sstream>
+
+
+template <int dim>
+Point<dim> shift (const Point<dim> &p)
+{
+  Point<dim> q = p;
+  q[0] += 0.1 * p[dim-1] * p[dim-1];
+  return q;
+}
+
+
+template <int dim>
+void compare_cells (const typename Triangulation<dim>::cell_iterator &cell1,
+                    const typename Triangulation<dim>::cell_iterator &cell2,
+                    unsigned int &n_differences)
+{
+  if (cell1->refinement_case() != cell2->refinement_case())
+    {
+      ++n_differences;
+      return;
+    }
+  if (cell1->material_id() != cell2->material_id())
+    ++n_differences;
+  for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+    if (cell1->vertex(v).distance (cell2->vertex(v)) > 1e-12)
+      ++n_differences;
+  for (unsigned int f=0; f<GeometryInfo<dim>::faces_per_cell; ++f)
+    if (cell1->at_boundary(f) != cell2->at_boundary(f))
+      ++n_differences;
+    else if (cell1->at_boundary(f) &&
+             (cell1->face(f)->boundary_indicator() !=
+              cell2->face(f)->boundary_indicator()))
+      ++n_differences;
+
+  if (cell1->has_children() == false)
+    {
+      deallog << cell1->level() << ' '
+              << (int)cell1->material_id() << ' '
+              << cell1->center() << ' '
+              << cell2->center() << std::endl;
+    }
+  else
+    for (unsigned int c=0; c<cell1->n_children(); ++c)
+      compare_cells<dim> (cell1->child(c), cell2->child(c), n_differences);
+}
+
+
+template <int dim>
+void test ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube (tria, 2);
+  tria.begin_active()->set_material_id (3);
+  tria.begin_active()->face(0)->set_boundary_indicator (2);
+  tria.refine_global (1);
+
+  // refine a few cells isotropically, and one anisotropically
+  typename Triangulation<dim>::active_cell_iterator cell = tria.begin_active();
+  cell->set_refine_flag ();
+  ++cell;
+  cell->set_refine_flag (RefinementCase<dim>::cut_x);
+  ++cell;
+  cell->set_material_id (7);
+  tria.execute_coarsening_and_refinement ();
+
+  tria.last_active()->set_refine_flag ();
+  tria.execute_coarsening_and_refinement ();
+
+  // move all vertices. GridTools::transform can not deal with
+  // anisotropically refined faces in 3d, so do it by hand; this also
+  // moves hanging nodes off the midpoints of their parent faces
+  std::vector<bool> treated_vertices (tria.n_vertices(), false);
+  for (cell=tria.begin_active(); cell!=tria.end(); ++cell)
+    for (unsigned int v=0; v<GeometryInfo<dim>::vertices_per_cell; ++v)
+      if (treated_vertices[cell->vertex_index(v)] == false)
+        {
+          cell->vertex(v) = shift (cell->vertex(v));
+          treated_vertices[cell->vertex_index(v)] = true;
+        }
+
+  std::ostringstream out;
+  GridOut().write_binary (tria, out);
+
+  Triangulation<dim> tria2;
+  GridIn<dim> grid_in;
+  grid_in.attach_triangulation (tria2);
+  std::istringstream in (out.str());
+  grid_in.read_binary (in);
+
+  deallog << "dim=" << dim
+          << ", levels=" << tria2.n_levels()
+          << ", cells=" << tria2.n_cells()
+          << ", active cells=" << tria2.n_active_cells()
+          << ", vertices=" << tria2.n_used_vertices()
+          << std::endl;
+  Assert (tria2.n_levels() == tria.n_levels(), ExcInternalError());
+  Assert (tria2.n_cells() == tria.n_cells(), ExcInternalError());
+  Assert (tria2.n_used_vertices() == tria.n_used_vertices(), ExcInternalError());
+
+  // compare the two hierarchies cell by cell
+  unsigned int n_differences = 0;
+  for (typename Triangulation<dim>::cell_iterator
+       cell1 = tria.begin(0), cell2 = tria2.begin(0);
+       cell1 != tria.end(0); ++cell1, ++cell2)
+    compare_cells<dim> (cell1, cell2, n_differences);
+  deallog << "differences: " << n_differences << std::endl;
+}
+
+
+int main ()
+{
+  initlog();
+  deallog.threshold_double(1.e-10);
+
+  test<1> ();
+  test<2> ();
+  test<3> ();
+}
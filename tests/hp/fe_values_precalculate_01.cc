@@ -0,0 +1,129 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// check hp::FEValues::precalculate_fe_values and
+// DoFTools::get_active_cells_by_fe_index: after precalculation, reinit()
+// must not create new FEValues objects, and integrating over the cells
+// group by group must give the same result as the usual loop
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_tools.h>
+#include <deal.II/hp/dof_handler.h>
+#include <deal.II/hp/fe_collection.h>
+#include <deal.II/hp/q_collection.h>
+#include <deal.II/hp/fe_values.h>
+#include <deal.II/fe/fe_q.h>
+
+#include <fstream>
+#include <set>
+
+
+template <int dim>
+void test ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (2);
+
+  hp::FECollection<dim> fe_collection;
+  hp::QCollection<dim> q_collection;
+  for (unsigned int degree=1; degree<=4; ++degree)
+    {
+      fe_collection.push_back (FE_Q<dim>(degree));
+      q_collection.push_back (QGauss<dim>(degree+1));
+    }
+
+  hp::DoFHandler<dim> dof_handler (tria);
+  unsigned int i = 0;
+  for (typename hp::DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell, ++i)
+    cell->set_active_fe_index ((i*7) % 3);
+  dof_handler.distribute_dofs (fe_collection);
+
+  hp::FEValues<dim> precalculated (fe_collection, q_collection,
+                                   update_values | update_JxW_values);
+  precalculated.precalculate_fe_values ();
+
+  // remember the FEValues objects created up front
+  std::set<const FEValues<dim> *> objects;
+  for (unsigned int fe_index=0; fe_index<fe_collection.size(); ++fe_index)
+    {
+      precalculated.reinit (typename Triangulation<dim>::cell_iterator (tria.begin_active()),
+                            fe_index, 0, fe_index);
+      objects.insert (&precalculated.get_present_fe_values());
+    }
+
+  // integrate the sum of all shape functions squared, cell by cell
+  hp::FEValues<dim> hp_fe_values (fe_collection, q_collection,
+                                  update_values | update_JxW_values);
+  double integral = 0;
+  for (typename hp::DoFHandler<dim>::active_cell_iterator
+       cell = dof_handler.begin_active(); cell != dof_handler.end(); ++cell)
+    {
+      hp_fe_values.reinit (cell);
+      const FEValues<dim> &fe_values = hp_fe_values.get_present_fe_values();
+      for (unsigned int q=0; q<fe_values.n_quadrature_points; ++q)
+        for (unsigned int i=0; i<fe_values.dofs_per_cell; ++i)
+          integral += fe_values.shape_value(i,q) * fe_values.shape_value(i,q) *
+                      fe_values.JxW(q);
+    }
+
+  // and group by group
+  const std::vector<std::vector<typename hp::DoFHandler<dim>::active_cell_iterator> >
+  groups = DoFTools::get_active_cells_by_fe_index (dof_handler);
+  double group_integral = 0;
+  bool reused = true;
+  for (unsigned int g=0; g<groups.size(); ++g)
+    {
+      deallog << "fe_index " << g << ": " << groups[g].size() << " cells" << std::endl;
+      for (unsigned int c=0; c<groups[g].size(); ++c)
+        {
+          AssertThrow (groups[g][c]->active_fe_index() == g, ExcInternalError());
+          precalculated.reinit (groups[g][c]);
+          const FEValues<dim> &fe_values = precalculated.get_present_fe_values();
+          if (objects.find (&fe_values) == objects.end())
+            reused = false;
+          for (unsigned int q=0; q<fe_values.n_quadrature_points; ++q)
+            for (unsigned int i=0; i<fe_values.dofs_per_cell; ++i)
+              group_integral += fe_values.shape_value(i,q) * fe_values.shape_value(i,q) *
+                                fe_values.JxW(q);
+        }
+    }
+
+  deallog << "precalculated objects used: " << (reused ? "yes" : "no")
+          << ", difference: " << std::fabs (integral - group_integral)
+          << std::endl;
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  test<2> ();
+  test<3> ();
+}
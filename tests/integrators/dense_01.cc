@@ -0,0 +1,135 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// compare the mass, Laplace and elasticity matrices computed as products
+// of dense matrices by the functions in integrators/dense.h with the
+// matrices computed by loops over pairs of shape functions
+
+#include "../tests.h"
+
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/integrators/dense.h>
+#include <deal.II/integrators/l2.h>
+#include <deal.II/integrators/laplace.h>
+#include <deal.II/integrators/elasticity.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_raviart_thomas.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <fstream>
+
+
+template <int dim>
+void check (const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  GridTools::distort_random (0.1, tria);
+
+  FEValues<dim> fev (fe, QGauss<dim>(fe.degree+1),
+                     update_values | update_gradients | update_JxW_values);
+  fev.reinit (tria.begin_active());
+
+  const unsigned int n = fe.dofs_per_cell;
+  const double factor = 2.5;
+  FullMatrix<double> mass (n,n), laplace (n,n), elasticity (n,n);
+  for (unsigned int k=0; k<fev.n_quadrature_points; ++k)
+    for (unsigned int i=0; i<n; ++i)
+      for (unsigned int j=0; j<n; ++j)
+        for (unsigned int d=0; d<fe.n_components(); ++d)
+          {
+            mass(i,j) += factor * fev.JxW(k) *
+                         fev.shape_value_component(i,k,d) *
+                         fev.shape_value_component(j,k,d);
+            laplace(i,j) += factor * fev.JxW(k) *
+                            (fev.shape_grad_component(i,k,d) *
+                             fev.shape_grad_component(j,k,d));
+            if (fe.n_components() == dim)
+              for (unsigned int e=0; e<dim; ++e)
+                elasticity(i,j) += factor * fev.JxW(k) * .25 *
+                                   (fev.shape_grad_component(i,k,d)[e] +
+                                    fev.shape_grad_component(i,k,e)[d]) *
+                                   (fev.shape_grad_component(j,k,d)[e] +
+                                    fev.shape_grad_component(j,k,e)[d]);
+          }
+
+  deallog << fe.get_name() << std::endl;
+
+  // the integrators add to the matrix they are given
+  FullMatrix<double> M (laplace);
+  LocalIntegrators::L2::mass_matrix (M, fev, factor);
+  M.add (-1., laplace);
+  M.add (-1., mass);
+  deallog << "mass: " << M.frobenius_norm() << std::endl;
+
+  M = 0.;
+  LocalIntegrators::Laplace::cell_matrix (M, fev, factor);
+  M.add (-1., laplace);
+  deallog << "laplace: " << M.frobenius_norm() << std::endl;
+
+  if (fe.n_components() == dim)
+    {
+      M = 0.;
+      LocalIntegrators::Elasticity::cell_matrix (M, fev, factor);
+      M.add (-1., elasticity);
+      deallog << "elasticity: " << M.frobenius_norm() << std::endl;
+    }
+
+  // a product of two different matrices, here the coupling of values and
+  // first derivatives of a scalar element
+  if (fe.n_components() == 1)
+    {
+      FullMatrix<double> V, G, exact (n,n);
+      LocalIntegrators::Dense::value_matrix (V, fev);
+      LocalIntegrators::Dense::gradient_matrix (G, fev);
+
+      FullMatrix<double> D (V.m(), n);
+      for (unsigned int k=0; k<fev.n_quadrature_points; ++k)
+        for (unsigned int j=0; j<n; ++j)
+          D(k,j) = G(k*dim,j);
+      for (unsigned int k=0; k<fev.n_quadrature_points; ++k)
+        for (unsigned int i=0; i<n; ++i)
+          for (unsigned int j=0; j<n; ++j)
+            exact(i,j) += fev.JxW(k) * fev.shape_value(i,k) * fev.shape_grad(j,k)[0];
+
+      M = 0.;
+      LocalIntegrators::Dense::weighted_product (M, V, D, fev.get_JxW_values());
+      M.add (-1., exact);
+      deallog << "advection: " << M.frobenius_norm() << std::endl;
+    }
+}
+
+
+
+int main()
+{
+  std::ofstream logfile("output");
+  deallog.attach(logfile);
+  deallog.depth_console(0);
+  deallog.threshold_double(1.e-10);
+
+  check (FE_Q<2>(2));
+  check (FESystem<2>(FE_Q<2>(2), 2));
+  check (FE_RaviartThomas<2>(1));
+  check (FE_Q<3>(1));
+  check (FESystem<3>(FE_Q<3>(1), 3));
+}
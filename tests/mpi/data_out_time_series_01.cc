@@ -0,0 +1,93 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// test DataOutTimeSeries: the mesh is only written in the first step,
+// after the triangulation has been refined, and after mesh_changed() has
+// been called
+
+#include "../tests.h"
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/data_out_time_series.h>
+
+
+template <int dim>
+void
+write_step (DataOutTimeSeries<dim> &time_series,
+            const DoFHandler<dim>  &dof_handler,
+            const double            time)
+{
+  Vector<double> solution (dof_handler.n_dofs());
+  for (unsigned int i=0; i<solution.size(); ++i)
+    solution(i) = time + i;
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler (dof_handler);
+  data_out.add_data_vector (solution, "solution");
+  data_out.build_patches ();
+
+  time_series.write (data_out, time);
+  deallog << "time " << time << ": "
+          << time_series.n_written_time_steps () << " steps, "
+          << time_series.n_written_meshes () << " meshes" << std::endl;
+}
+
+
+template <int dim>
+void
+test ()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria, 0., 1.);
+  tria.refine_global (1);
+
+  FE_Q<dim> fe (1);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  DataOutTimeSeries<dim> time_series (tria, "time_series", MPI_COMM_WORLD);
+
+  // two steps on the same mesh
+  write_step (time_series, dof_handler, 0.);
+  write_step (time_series, dof_handler, 0.5);
+
+  // refine the mesh
+  tria.refine_global (1);
+  dof_handler.distribute_dofs (fe);
+  write_step (time_series, dof_handler, 1.);
+
+  // force the mesh to be written
+  time_series.mesh_changed ();
+  write_step (time_series, dof_handler, 1.5);
+  write_step (time_series, dof_handler, 2.);
+
+  if (0==Utilities::MPI::this_mpi_process (MPI_COMM_WORLD))
+    cat_file("time_series.xdmf");
+}
+
+
+int main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll log;
+
+  test<2>();
+}
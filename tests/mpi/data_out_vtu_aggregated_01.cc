@@ -0,0 +1,130 @@
+// ---------------------------------------------------------------------
+// $Id$
+//
+// Copyright (C) 2014 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the deal.II distribution.
+//
+// ---------------------------------------------------------------------
+
+
+// test DataOutInterface::write_vtu_aggregated for different numbers of
+// aggregators: list the files in the .pvtu record and count the pieces
+// in each of them
+
+#include "../tests.h"
+#include <deal.II/base/logstream.h>
+#include <deal.II/base/utilities.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/lac/vector.h>
+#include <deal.II/numerics/data_out.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+
+std::string read_file (const std::string &filename)
+{
+  std::ifstream in (filename.c_str());
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  return contents.str();
+}
+
+
+unsigned int count (const std::string &text,
+                    const std::string &pattern)
+{
+  unsigned int n = 0;
+  for (std::size_t pos = text.find (pattern); pos != std::string::npos;
+       pos = text.find (pattern, pos+1))
+    ++n;
+  return n;
+}
+
+
+template <int dim>
+void test ()
+{
+  const unsigned int myid = Utilities::MPI::this_mpi_process (MPI_COMM_WORLD);
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube (tria);
+  tria.refine_global (1);
+
+  FE_Q<dim> fe (1);
+  DoFHandler<dim> dof_handler (tria);
+  dof_handler.distribute_dofs (fe);
+
+  Vector<double> solution (dof_handler.n_dofs());
+  for (unsigned int i=0; i<solution.size(); ++i)
+    solution(i) = myid + 1. * i / solution.size();
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler (dof_handler);
+  data_out.add_data_vector (solution, "solution");
+  data_out.build_patches ();
+
+  for (unsigned int n_aggregators=0; n_aggregators<4; ++n_aggregators)
+    {
+      const std::string filename = "aggregated-" + Utilities::int_to_string (n_aggregators);
+      data_out.write_vtu_aggregated (filename, n_aggregators, MPI_COMM_WORLD);
+      MPI_Barrier (MPI_COMM_WORLD);
+
+      if (myid == 0)
+        {
+          deallog << "n_aggregators=" << n_aggregators << std::endl;
+
+          const std::string record = read_file (filename + ".pvtu");
+          for (std::size_t pos = record.find ("Source=\""); pos != std::string::npos;
+               pos = record.find ("Source=\"", pos+1))
+            {
+              const std::size_t start = pos + 8;
+              const std::string piece_file
+                = record.substr (start, record.find ('"', start) - start);
+              const std::string contents = read_file (piece_file);
+              deallog << piece_file << ": "
+                      << count (contents, "<Piece ") << " pieces, "
+                      << count (contents, "</VTKFile>") << " footer"
+                      << std::endl;
+            }
+        }
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+#ifdef DEAL_II_WITH_MPI
+  Utilities::MPI::MPI_InitFinalize mpi (argc, argv);
+#else
+  (void)argc;
+  (void)argv;
+  compile_time_error;
+#endif
+
+  if (Utilities::MPI::this_mpi_process (MPI_COMM_WORLD) == 0)
+    {
+      std::ofstream logfile("output");
+      deallog.attach(logfile);
+      deallog.depth_console(0);
+      deallog.threshold_double(1.e-10);
+
+      deallog.push("mpi");
+      test<2>();
+      deallog.pop();
+    }
+  else
+    test<2>();
+}